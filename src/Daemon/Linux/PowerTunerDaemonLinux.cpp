@@ -16,12 +16,14 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <csignal>
+#include <grp.h>
 #ifdef SYSTEMD_NOTIFY
 #include <systemd/sd-daemon.h>
 #include <chrono>
 #endif
 
 #include "PowerTunerDaemonLinux.h"
+#include "../../Service/TelemetryExport/TelemetryExportFactory.h"
 
 namespace PWTD {
     PowerTunerDaemonLinux::PowerTunerDaemonLinux() {
@@ -36,6 +38,11 @@ namespace PWTD {
 
     void PowerTunerDaemonLinux::setupCmdArgs() const {
         PowerTunerDaemon::setupCmdArgs();
+        cmdParser->addOption({"te", "export telemetry to shared memory for local readers, samples once per second"});
+        cmdParser->addOption({"us", "also listen on unix socket path, a systemd activated socket is used when passed", "path"});
+        cmdParser->addOption({"uu", "uids allowed on the unix socket besides root and the daemon user, comma separated", "uids"});
+        cmdParser->addOption({"ug", "group owning the unix socket, its members may connect, default none, socket is owner only", "group"});
+        cmdParser->addOption({"uo", "unix socket only, no TCP listener"});
 #ifdef SYSTEMD_NOTIFY
         cmdParser->addOption({"sd", "Run as systemd daemon"});
 #endif
@@ -43,6 +50,32 @@ namespace PWTD {
 
     void PowerTunerDaemonLinux::parseCmdArgs(const QCoreApplication &app) {
         PowerTunerDaemon::parseCmdArgs(app);
+        TelemetryExportFactory::setEnabled(cmdParser->isSet("te"));
+
+        QSet<uint> uids;
+
+        for (const QString &uid: cmdParser->value("uu").split(',', Qt::SkipEmptyParts)) {
+            bool res = false;
+            const uint val = uid.trimmed().toUInt(&res);
+
+            if (res)
+                uids.insert(val);
+            else
+                qWarning() << "Ignoring invalid uid: " << uid;
+        }
+
+        int gid = -1;
+
+        if (cmdParser->isSet("ug")) {
+            const group *grp = getgrnam(cmdParser->value("ug").toLocal8Bit().constData());
+
+            if (grp != nullptr)
+                gid = static_cast<int>(grp->gr_gid);
+            else
+                qWarning() << "Ignoring unknown group: " << cmdParser->value("ug");
+        }
+
+        ServiceWorker::setLocalSocket(cmdParser->value("us"), uids, gid, cmdParser->isSet("uo"));
 #ifdef SYSTEMD_NOTIFY
         cmdSystemdDaemon = cmdParser->isSet("sd");
 #endif
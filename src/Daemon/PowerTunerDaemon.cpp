@@ -17,6 +17,10 @@
  */
 #include "PowerTunerDaemon.h"
 #include "../Utils/AppDataPath.h"
+#include "../Device/CPU/Utils/CPUWorkerPool/CPUWorkerPool.h"
+#include "../Device/ApplyEngine.h"
+#include "../Device/Telemetry/TelemetryHistory.h"
+#include "../Service/Workers/ServiceWorker.h"
 
 namespace PWTD {
     PowerTunerDaemon::PowerTunerDaemon() {
@@ -35,6 +39,11 @@ namespace PWTD {
         cmdParser->addOption({"a", "listen on address|localhost|any, default any", "address", "any"});
         cmdParser->addOption({"p", QString("port, default %1").arg(PWTS::DaemonSettings::DefaultTCPPort), "port", QString::number(PWTS::DaemonSettings::DefaultTCPPort)});
         cmdParser->addOption({"nc", "disable client connection, no TCP/UDP server"});
+        cmdParser->addOption({"sc", "read and apply per-cpu settings serially, no cpu worker threads"});
+        cmdParser->addOption({"fa", "fully re-apply settings on apply interval, no drift reconcile"});
+        cmdParser->addOption({"th", QString("telemetry history memory in KiB, 0 disables it, default %1").arg(TelemetryHistory::DefaultMemoryBudget), "kib", QString::number(TelemetryHistory::DefaultMemoryBudget)});
+        cmdParser->addOption({"zl", QString("zlib level for framed clients that ask for compression, 0 disables it, default %1").arg(ServiceWorker::DefaultCompressionLevel), "level", QString::number(ServiceWorker::DefaultCompressionLevel)});
+        cmdParser->addOption({"zt", QString("compress only payloads of at least this many bytes, default %1").arg(ServiceWorker::DefaultCompressionThreshold), "bytes", QString::number(ServiceWorker::DefaultCompressionThreshold)});
     }
 
     void PowerTunerDaemon::parseCmdArgs(const QCoreApplication &app) {
@@ -43,5 +52,10 @@ namespace PWTD {
         cmdNoClients = cmdParser->isSet("nc");
         cmdAdr = cmdParser->value("a");
         cmdPort = cmdParser->value("p").toUInt();
+
+        CPUWorkerPool::getInstance()->setEnabled(!cmdParser->isSet("sc"));
+        ApplyEngine::getInstance()->setReconcileEnabled(!cmdParser->isSet("fa"));
+        TelemetryHistory::getInstance()->setMemoryBudget(cmdParser->value("th").toInt());
+        ServiceWorker::setCompression(cmdParser->value("zl").toInt(), cmdParser->value("zt").toInt());
     }
 }
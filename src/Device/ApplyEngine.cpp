@@ -0,0 +1,169 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QDateTime>
+
+#include "ApplyEngine.h"
+
+namespace PWTD {
+    QSharedPointer<ApplyEngine> ApplyEngine::getInstance() {
+        if (!instance.isNull())
+            return instance;
+
+        instance.reset(new ApplyEngine);
+        return instance;
+    }
+
+    void ApplyEngine::begin(const bool differentialApply) {
+        const QMutexLocker locker(&stateMutex);
+
+        differential = differentialApply;
+        resetPending = false;
+        targetKeys.clear();
+        resetKeys.clear();
+        writesIssued = 0;
+        writesSkipped = 0;
+    }
+
+    void ApplyEngine::end() {
+        const QMutexLocker locker(&stateMutex);
+
+        if (!resetPending)
+            return;
+
+        for (auto it = appliedState.begin(); it != appliedState.end();) {
+            if (resetKeys.contains(it.key()))
+                ++it;
+            else
+                it = appliedState.erase(it);
+        }
+
+        resetPending = false;
+        resetKeys.clear();
+    }
+
+    void ApplyEngine::reset() {
+        const QMutexLocker locker(&stateMutex);
+
+        appliedState.clear();
+    }
+
+    // called from a write that invalidates the state of other targets (smt, cpufreq driver switch)
+    // the rest of the pass writes everything, state recorded before the request is dropped in end()
+    void ApplyEngine::requestReset() {
+        const QMutexLocker locker(&stateMutex);
+
+        resetPending = true;
+        differential = false;
+        resetKeys.clear();
+    }
+
+    void ApplyEngine::invalidateIndex(const int index) {
+        const QMutexLocker locker(&stateMutex);
+
+        for (auto it = appliedState.begin(); it != appliedState.end();) {
+            if (getKeyIndex(it.key()) == index)
+                it = appliedState.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    void ApplyEngine::invalidate(const PWTS::DError target, const int index) {
+        const QMutexLocker locker(&stateMutex);
+
+        appliedState.remove(getKey(target, index));
+    }
+
+    void ApplyEngine::invalidate(const PWTS::DError target, const QString &id) {
+        const QMutexLocker locker(&stateMutex);
+
+        appliedState.remove(getKey(target, getIdIndex(id)));
+    }
+
+    void ApplyEngine::beginObserve() {
+        const QMutexLocker locker(&stateMutex);
+
+        observedState.clear();
+        observing = true;
+    }
+
+    // the observe packet has every field the hardware reports, drop the ones the client packet left unset
+    QHash<quint64, QByteArray> ApplyEngine::endObserve() {
+        const QMutexLocker locker(&stateMutex);
+
+        observing = false;
+
+        for (auto it = observedState.begin(); it != observedState.end();) {
+            if (targetKeys.contains(it.key()))
+                ++it;
+            else
+                it = observedState.erase(it);
+        }
+
+        return std::exchange(observedState, {});
+    }
+
+    void ApplyEngine::setBaseline(const QHash<quint64, QByteArray> &state) {
+        const QMutexLocker locker(&stateMutex);
+
+        baselineState = state;
+    }
+
+    void ApplyEngine::clearBaseline() {
+        const QMutexLocker locker(&stateMutex);
+
+        baselineState.clear();
+    }
+
+    bool ApplyEngine::hasBaseline() const {
+        const QMutexLocker locker(&stateMutex);
+
+        return !baselineState.isEmpty();
+    }
+
+    QList<quint64> ApplyEngine::markDrifted(const QHash<quint64, QByteArray> &observed) {
+        const QMutexLocker locker(&stateMutex);
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        QList<quint64> drifted;
+
+        for (auto it = observed.constBegin(); it != observed.constEnd(); ++it) {
+            const auto baseIt = baselineState.constFind(it.key());
+
+            if (baseIt == baselineState.cend() || baseIt.value() == it.value())
+                continue;
+
+            DriftStat &stat = driftStats[it.key()];
+
+            stat.lastInterval = stat.lastSeen > 0 ? (now - stat.lastSeen) : 0;
+            stat.lastSeen = now;
+            ++stat.count;
+
+            // force a rewrite on the next differential apply
+            appliedState.remove(it.key());
+            drifted.append(it.key());
+        }
+
+        return drifted;
+    }
+
+    QHash<quint64, ApplyEngine::DriftStat> ApplyEngine::getDriftStats() const {
+        const QMutexLocker locker(&stateMutex);
+
+        return driftStats;
+    }
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <utility>
+#include <QSharedPointer>
+#include <QDataStream>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+
+#include "pwtShared/Include/Packets/DaemonPacket.h"
+
+namespace PWTD {
+    // last applied state of each write target, identified by its write error and an index (cpu, core, gpu..)
+    // failed writes are never recorded, so they are always retried
+    class ApplyEngine final {
+    public:
+        struct DriftStat final {
+            quint64 count = 0;
+            qint64 lastSeen = 0; // msecs since epoch
+            qint64 lastInterval = 0; // msecs between the last two drifts
+        };
+
+    private:
+        inline static QSharedPointer<ApplyEngine> instance;
+        QHash<quint64, QByteArray> appliedState;
+        QHash<quint64, QByteArray> observedState;
+        QHash<quint64, QByteArray> baselineState; // hardware state read back after the last reconcile
+        QHash<quint64, DriftStat> driftStats;
+        QSet<quint64> targetKeys; // targets the last apply pass was asked to write, observe results are limited to them
+        QSet<quint64> resetKeys; // targets recorded after a reset request, the only state kept when the pass ends
+        mutable QMutex stateMutex; // per-cpu targets are applied from the cpu workers
+        bool differential = false;
+        bool observing = false;
+        bool reconcile = true;
+        bool resetPending = false;
+        quint64 writesIssued = 0;
+        quint64 writesSkipped = 0;
+
+        ApplyEngine() = default;
+
+        [[nodiscard]]
+        static quint64 getKey(const PWTS::DError target, const int index) {
+            return (static_cast<quint64>(target) << 32) | static_cast<quint32>(index);
+        }
+
+        [[nodiscard]]
+        static int getIdIndex(const QString &id) {
+            return static_cast<int>(qHash(id));
+        }
+
+        template <typename T>
+        [[nodiscard]] bool applyTarget(const quint64 key, const QByteArray &state, T &&writeFn) {
+            QMutexLocker locker(&stateMutex);
+
+            // the target value is the current hardware state, record it and don't write
+            if (observing) {
+                observedState.insert(key, state);
+                return true;
+            }
+
+            const auto it = appliedState.constFind(key);
+
+            targetKeys.insert(key);
+
+            if (differential && it != appliedState.cend() && it.value() == state) {
+                ++writesSkipped;
+                return true;
+            }
+
+            ++writesIssued;
+            locker.unlock();
+
+            const bool ret = writeFn();
+
+            locker.relock();
+
+            if (!ret) {
+                appliedState.remove(key);
+                return false;
+            }
+
+            appliedState.insert(key, state);
+
+            if (resetPending)
+                resetKeys.insert(key);
+
+            return true;
+        }
+
+    public:
+        ApplyEngine(const ApplyEngine &) = delete;
+        ApplyEngine &operator=(const ApplyEngine &) = delete;
+
+        [[nodiscard]] static QSharedPointer<ApplyEngine> getInstance();
+        void begin(bool differentialApply);
+        void end();
+        void reset();
+        void requestReset();
+        void invalidate(PWTS::DError target, int index = 0);
+        void invalidateIndex(int index);
+        void invalidate(PWTS::DError target, const QString &id);
+        [[nodiscard]] quint64 getWritesIssued() const { return writesIssued; }
+        [[nodiscard]] quint64 getWritesSkipped() const { return writesSkipped; }
+        void setReconcileEnabled(const bool enable) { reconcile = enable; }
+        [[nodiscard]] bool isReconcileEnabled() const { return reconcile; }
+        void beginObserve();
+        [[nodiscard]] QHash<quint64, QByteArray> endObserve();
+        void setBaseline(const QHash<quint64, QByteArray> &state);
+        void clearBaseline();
+        [[nodiscard]] bool hasBaseline() const;
+        [[nodiscard]] QList<quint64> markDrifted(const QHash<quint64, QByteArray> &observed);
+        [[nodiscard]] QHash<quint64, DriftStat> getDriftStats() const;
+        [[nodiscard]] static PWTS::DError getKeyTarget(const quint64 key) { return static_cast<PWTS::DError>(key >> 32); }
+        [[nodiscard]] static int getKeyIndex(const quint64 key) { return static_cast<int>(key & 0xffffffff); }
+
+        template <typename T, typename F>
+        [[nodiscard]] bool apply(const PWTS::DError target, const int index, const T &value, F &&writeFn) {
+            QByteArray state;
+            QDataStream ds {&state, QIODevice::WriteOnly};
+
+            ds << value;
+
+            return applyTarget(getKey(target, index), state, std::forward<F>(writeFn));
+        }
+
+        template <typename T, typename F>
+        [[nodiscard]] bool apply(const PWTS::DError target, const T &value, F &&writeFn) {
+            return apply(target, 0, value, std::forward<F>(writeFn));
+        }
+
+        // id is part of the state, hash collisions can't skip a write
+        template <typename T, typename F>
+        [[nodiscard]] bool apply(const PWTS::DError target, const QString &id, const T &value, F &&writeFn) {
+            QByteArray state;
+            QDataStream ds {&state, QIODevice::WriteOnly};
+
+            ds << id << value;
+
+            return applyTarget(getKey(target, getIdIndex(id)), state, std::forward<F>(writeFn));
+        }
+    };
+}
@@ -39,48 +39,33 @@ namespace PWTD::AMD {
             msrCppcEnable.reset(new MSR_CPPC_ENABLE);
             msrCppcRequest.reset(new MSR_CPPC_REQUEST);
         }
+
+        if (hasRAPLBit() && !raplSampler.init(msrDev) && logger->isLevel(PWTS::LogLevel::Error))
+            logger->write(QStringLiteral("failed to init rapl sampler"));
     }
 
     bool AMDCPU::hasHWPStateBit() const {
         const uint32_t edx = cpuidRaw->ext_cpuid[7][cpu_registers_t::EDX];
-        bool ret;
-
-        try {
-            ret = getBitfield(7, 7, edx) == 1;
 
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<7, 7>(edx) == 1;
     }
 
     bool AMDCPU::hasCorePerformanceBoostBit() const {
         const uint32_t edx = cpuidRaw->ext_cpuid[7][cpu_registers_t::EDX];
-        bool ret;
-
-        try {
-            ret = getBitfield(9, 9, edx) == 1;
 
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<9, 9>(edx) == 1;
     }
 
     bool AMDCPU::hasCPPCBit() const {
         const uint32_t ebx = cpuidRaw->ext_cpuid[8][cpu_registers_t::EBX];
-        bool ret;
 
-        try {
-            ret = getBitfield(27, 27, ebx) == 1;
+        return getBitfield<27, 27>(ebx) == 1;
+    }
 
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
+    bool AMDCPU::hasRAPLBit() const {
+        const uint32_t edx = cpuidRaw->ext_cpuid[7][cpu_registers_t::EDX];
 
-        return ret;
+        return getBitfield<14, 14>(edx) == 1;
     }
 
     QSet<PWTS::Feature> AMDCPU::getFeatures() const {
@@ -114,7 +99,9 @@ namespace PWTD::AMD {
         if (!features.contains(PWTS::Feature::AMD_CPU_GROUP))
             return;
 
-        if (!msrDev->openMsrFd(0)) {
+        const MSRHandle msrHandle {msrDev, 0};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QStringLiteral("failed to open msr fd"));
 
@@ -127,8 +114,6 @@ namespace PWTD::AMD {
 
         if (features.contains(PWTS::Feature::AMD_CPPC))
             packet.amdData->cppcEnableBit = msrCppcEnable->getCPPCEnableBit();
-
-        msrDev->closeMsrFd(0);
     }
 
     void AMDCPU::fillCoreData(const int cpu, const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const {
@@ -137,20 +122,17 @@ namespace PWTD::AMD {
         packet.amdData->coreData.append(coreData);
     }
 
-    void AMDCPU::fillThreadData(const int cpu, const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const {
-        PWTS::AMD::AMDThreadData thdData {};
-
-        if (!features.contains(PWTS::Feature::AMD_CPU_GROUP)) {
-            packet.amdData->threadData.append(thdData);
+    void AMDCPU::fillThreadData(const int cpu, const QSet<PWTS::Feature> &features, PWTS::AMD::AMDThreadData &thdData, QSet<PWTS::DError> &errors) const {
+        if (!features.contains(PWTS::Feature::AMD_CPU_GROUP))
             return;
-        }
 
-        if (!msrDev->openMsrFd(cpu)) {
+        const MSRHandle msrHandle {msrDev, cpu};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QString("failed to open msr fd for cpu %1").arg(cpu));
 
-            packet.errors.insert(PWTS::DError::NO_MSR_FD);
-            packet.amdData->threadData.append(thdData);
+            errors.insert(PWTS::DError::NO_MSR_FD);
             return;
         }
 
@@ -164,9 +146,6 @@ namespace PWTD::AMD {
 
         if (features.contains(PWTS::Feature::AMD_CORE_PERFORMANCE_BOOST))
             thdData.corePerfBoost = msrCorePerformanceBoost->getCorePerformanceBoostData(cpu);
-
-        msrDev->closeMsrFd(cpu);
-        packet.amdData->threadData.append(thdData);
     }
 
     void AMDCPU::fillDaemonPacket(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, PWTS::DaemonPacket &packet) const {
@@ -185,8 +164,17 @@ namespace PWTD::AMD {
         for (int i=0,l=cpuInfo->numCores; i<l; ++i)
             fillCoreData(coreIdxList[i], features, packet);
 
-        for (int i=0,l=cpuInfo->numLogicalCpus; i<l; ++i)
-            fillThreadData(i, features, packet);
+        QList<PWTS::AMD::AMDThreadData> threadData(cpuInfo->numLogicalCpus);
+        QList<QSet<PWTS::DError>> threadErrors(cpuInfo->numLogicalCpus);
+        PWTS::AMD::AMDThreadData *threadDataPtr = threadData.data();
+        QSet<PWTS::DError> *threadErrorsPtr = threadErrors.data();
+
+        workerPool->run(cpuInfo->numLogicalCpus, [&](const int cpu) { fillThreadData(cpu, features, threadDataPtr[cpu], threadErrorsPtr[cpu]); });
+
+        packet.amdData->threadData = threadData;
+
+        for (const QSet<PWTS::DError> &errs: std::as_const(threadErrors))
+            packet.errors.unite(errs);
 
         if (!ryzenAdj.isNull())
             ryzenAdj->fillPacketData(features, packet);
@@ -196,7 +184,9 @@ namespace PWTD::AMD {
         if (!features.contains(PWTS::Feature::AMD_CPU_GROUP))
             return;
 
-        if (!msrDev->openMsrFd(0)) {
+        const MSRHandle msrHandle {msrDev, 0};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QStringLiteral("failed to open msr fd"));
 
@@ -207,36 +197,35 @@ namespace PWTD::AMD {
         const QSharedPointer<PWTS::AMD::AMDData> data = packet.amdData;
 
         if (features.contains(PWTS::Feature::AMD_CPPC)) {
-            if (msrCppcEnable->getCPPCEnableBit().getValue() == 0 && !msrCppcEnable->setCPPCEnableBit(data->cppcEnableBit))
+            // write-once bit, only set while disabled
+            if (!applyEngine->apply(PWTS::DError::W_AMD_CPPC_ENBL_BIT, data->cppcEnableBit, [&]()->bool { return msrCppcEnable->getCPPCEnableBit().getValue() != 0 || msrCppcEnable->setCPPCEnableBit(data->cppcEnableBit); }))
                 errors.insert(PWTS::DError::W_AMD_CPPC_ENBL_BIT);
         }
-
-        msrDev->closeMsrFd(0);
     }
 
     void AMDCPU::applyThreadSettings(const int cpu, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const {
         if (!features.contains(PWTS::Feature::AMD_CPU_GROUP))
             return;
 
-        if (!msrDev->openMsrFd(cpu)) {
+        const MSRHandle msrHandle {msrDev, cpu};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QString("failed to open msr fd for cpu %1").arg(cpu));
 
             return;
         }
 
-        const PWTS::AMD::AMDThreadData &data = packet.amdData->threadData[cpu];
+        const PWTS::AMD::AMDThreadData &data = packet.amdData->threadData.at(cpu); // const access, runs on the cpu workers
 
-        if (features.contains(PWTS::Feature::AMD_HWPSTATE) && !msrPStateControl->setPStateControl(cpu, data.pstateCmd))
+        if (features.contains(PWTS::Feature::AMD_HWPSTATE) && !applyEngine->apply(PWTS::DError::W_AMD_HWPSTATE_CMD, cpu, data.pstateCmd, [&]()->bool { return msrPStateControl->setPStateControl(cpu, data.pstateCmd); }))
             errors.insert(PWTS::DError::W_AMD_HWPSTATE_CMD);
 
-        if (features.contains(PWTS::Feature::AMD_CORE_PERFORMANCE_BOOST) && !msrCorePerformanceBoost->setCorePerformanceBoost(cpu, data.corePerfBoost))
+        if (features.contains(PWTS::Feature::AMD_CORE_PERFORMANCE_BOOST) && !applyEngine->apply(PWTS::DError::W_AMD_CORE_PERFORMANCE_BOOST, cpu, data.corePerfBoost, [&]()->bool { return msrCorePerformanceBoost->setCorePerformanceBoost(cpu, data.corePerfBoost); }))
             errors.insert(PWTS::DError::W_AMD_CORE_PERFORMANCE_BOOST);
 
-        if (features.contains(PWTS::Feature::AMD_CPPC) && !msrCppcRequest->setCPPCRequest(cpu, data.cppcRequest))
+        if (features.contains(PWTS::Feature::AMD_CPPC) && !applyEngine->apply(PWTS::DError::W_AMD_CPPC_REQ, cpu, data.cppcRequest, [&]()->bool { return msrCppcRequest->setCPPCRequest(cpu, data.cppcRequest); }))
             errors.insert(PWTS::DError::W_AMD_CPPC_REQ);
-
-        msrDev->closeMsrFd(cpu);
     }
 
     QSet<PWTS::DError> AMDCPU::applySettings(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const {
@@ -273,8 +262,13 @@ namespace PWTD::AMD {
 
         applyPackageSettings(features, packet, errors);
 
-        for (int i=0,l=cpuInfo->numLogicalCpus; i<l; ++i)
-            applyThreadSettings(i, features, packet, errors);
+        QList<QSet<PWTS::DError>> threadErrors(cpuInfo->numLogicalCpus);
+        QSet<PWTS::DError> *threadErrorsPtr = threadErrors.data();
+
+        workerPool->run(cpuInfo->numLogicalCpus, [&](const int cpu) { applyThreadSettings(cpu, features, packet, threadErrorsPtr[cpu]); });
+
+        for (const QSet<PWTS::DError> &errs: std::as_const(threadErrors))
+            errors.unite(errs);
 
         if (!ryzenAdj.isNull())
             errors.unite(ryzenAdj->applySettings(features, coreIdxList, packet));
@@ -283,6 +277,20 @@ namespace PWTD::AMD {
     }
 
     PWTS::ROData<int> AMDCPU::getTemperature() const {
+        if (ryzenAdj.isNull())
+            return {};
+
         return ryzenAdj->getTemperature();
     }
+
+    PMTableSnapshot AMDCPU::getPMTableSnapshot(const int maxStaleness) const {
+        if (ryzenAdj.isNull())
+            return {};
+
+        return ryzenAdj->getPMTableSnapshot(maxStaleness);
+    }
+
+    QMap<QString, int> AMDCPU::getPower(const QList<int> &coreIdxList) const {
+        return raplSampler.sample(coreIdxList);
+    }
 }
@@ -20,6 +20,7 @@
 #include "../CPUDevice.h"
 #include "Includes/RegistersInlcudes.h"
 #include "SMU/RyzenAdj.h"
+#include "RAPL/RAPLSampler.h"
 
 namespace PWTD::AMD {
     class AMDCPU final: public CPUDevice {
@@ -31,13 +32,15 @@ namespace PWTD::AMD {
         QScopedPointer<MSR_CPPC_CAPABILITY_1> msrCppcCapability1;
         QScopedPointer<MSR_CPPC_ENABLE> msrCppcEnable;
         QScopedPointer<MSR_CPPC_REQUEST> msrCppcRequest;
+        mutable RAPLSampler raplSampler;
 
         [[nodiscard]] bool hasCorePerformanceBoostBit() const;
         [[nodiscard]] bool hasHWPStateBit() const;
         [[nodiscard]] bool hasCPPCBit() const;
+        [[nodiscard]] bool hasRAPLBit() const;
         void fillPackageData(const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const;
         void fillCoreData(int cpu, const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const;
-        void fillThreadData(int cpu, const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const;
+        void fillThreadData(int cpu, const QSet<PWTS::Feature> &features, PWTS::AMD::AMDThreadData &thdData, QSet<PWTS::DError> &errors) const;
         void applyPackageSettings(const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
         void applyThreadSettings(int cpu, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
 
@@ -48,5 +51,7 @@ namespace PWTD::AMD {
         void fillDaemonPacket(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, PWTS::DaemonPacket &packet) const override;
         [[nodiscard]] QSet<PWTS::DError> applySettings(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const override;
         [[nodiscard]] PWTS::ROData<int> getTemperature() const override;
+        [[nodiscard]] QMap<QString, int> getPower(const QList<int> &coreIdxList) const override;
+        [[nodiscard]] PMTableSnapshot getPMTableSnapshot(int maxStaleness) const override;
     };
 }
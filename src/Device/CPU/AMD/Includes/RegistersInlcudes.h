@@ -23,3 +23,5 @@
 #include "../Registers/MSR_CPPC_CAPABILITY_1.h"
 #include "../Registers/MSR_CPPC_ENABLE.h"
 #include "../Registers/MSR_CPPC_REQUEST.h"
+#include "../Registers/MSR_RAPL_POWER_UNIT.h"
+#include "../Registers/MSR_ENERGY_STATUS.h"
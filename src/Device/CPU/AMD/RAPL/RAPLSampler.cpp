@@ -0,0 +1,83 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RAPLSampler.h"
+#include "../Registers/MSR_RAPL_POWER_UNIT.h"
+
+namespace PWTD::AMD {
+    bool RAPLSampler::init(const QSharedPointer<MSR> &msr) {
+        const MSRHandle msrHandle {msr, 0};
+
+        msrDev = msr;
+        energyUnit = 0;
+
+        if (!msrHandle.isOpen())
+            return false;
+
+        const std::unique_ptr<MSR_RAPL_POWER_UNIT> msrRaplPowerUnit = std::make_unique<MSR_RAPL_POWER_UNIT>();
+        const PWTS::ROData<double> unit = msrRaplPowerUnit->getEnergyUnit();
+
+        pkgEnergyStatus.reset(new MSR_ENERGY_STATUS(MSR_ENERGY_STATUS::PKG));
+        coreEnergyStatus.reset(new MSR_ENERGY_STATUS(MSR_ENERGY_STATUS::CORE));
+
+        if (!unit.isValid() || !pkgEnergyStatus->getEnergyCounter(0).isValid())
+            return false;
+
+        energyUnit = unit.getValue();
+
+        pkgCounter.setEnergyUnit(energyUnit);
+        clock.start();
+        return true;
+    }
+
+    // milliwatts, "package" and "core<index>" in core index list order, counters are valid from the second sample
+    QMap<QString, int> RAPLSampler::sample(const QList<int> &coreIdxList) {
+        QMap<QString, int> power;
+
+        if (!isAvailable())
+            return power;
+
+        for (int i=-1,l=coreIdxList.size(); i<l; ++i) {
+            const bool isPackage = i < 0;
+            const int cpu = isPackage ? 0 : coreIdxList[i];
+            const MSRHandle msrHandle {msrDev, cpu};
+
+            if (!msrHandle.isOpen())
+                continue;
+
+            const PWTS::ROData<uint32_t> count = (isPackage ? pkgEnergyStatus : coreEnergyStatus)->getEnergyCounter(cpu);
+            const qint64 nsecs = clock.nsecsElapsed();
+
+            if (!isPackage && !coreCounters.contains(cpu))
+                coreCounters[cpu].setEnergyUnit(energyUnit);
+
+            EnergyCounter &counter = isPackage ? pkgCounter : coreCounters[cpu];
+
+            if (!count.isValid()) {
+                counter.reset();
+                continue;
+            }
+
+            const PWTS::ROData<int> mw = counter.update(count.getValue(), nsecs);
+
+            if (mw.isValid())
+                power.insert(isPackage ? QStringLiteral("package") : QString("core%1").arg(i), mw.getValue());
+        }
+
+        return power;
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+
+#include "../Registers/MSR_ENERGY_STATUS.h"
+#include "../../Utils/EnergyCounter.h"
+#include "../../Utils/MSR/MSRHandle.h"
+
+namespace PWTD::AMD {
+    // package and per core power from the rapl energy counters, averaged between two samples
+    class RAPLSampler final {
+    private:
+        QSharedPointer<MSR> msrDev;
+        QScopedPointer<MSR_ENERGY_STATUS> pkgEnergyStatus;
+        QScopedPointer<MSR_ENERGY_STATUS> coreEnergyStatus;
+        EnergyCounter pkgCounter;
+        QHash<int, EnergyCounter> coreCounters; // by cpu
+        QElapsedTimer clock;
+        double energyUnit = 0;
+
+    public:
+        [[nodiscard]] bool init(const QSharedPointer<MSR> &msr);
+        [[nodiscard]] bool isAvailable() const { return energyUnit > 0; }
+        [[nodiscard]] QMap<QString, int> sample(const QList<int> &coreIdxList);
+    };
+}
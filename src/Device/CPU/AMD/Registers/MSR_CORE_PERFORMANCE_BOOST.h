@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/Types/RWData.h"
@@ -32,34 +30,12 @@ namespace PWTD::AMD {
             // 63:26 reserved:38
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, corePerformanceBoost &regVal) const {
-            try {
-                regVal.cpbDis = getBitfield(25, 25, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, corePerformanceBoost &regVal) {
+            regVal.cpbDis = getBitfield<25, 25>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const corePerformanceBoost &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(25, 25, regVal.cpbDis, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const corePerformanceBoost &regVal, uint64_t &raw) {
+            setBitfield<25, 25>(regVal.cpbDis, raw);
         }
 
     public:
@@ -71,9 +47,11 @@ namespace PWTD::AMD {
             corePerformanceBoost regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, cpu))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<int>(static_cast<int>(regVal.cpbDis), true);
         }
 
@@ -87,7 +65,12 @@ namespace PWTD::AMD {
 
             regVal.cpbDis = data.getValue();
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
+            if (!msrUtils->readMSR(raw, addr, cpu))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/AMD/CPPCCapability1.h"
@@ -35,22 +33,11 @@ namespace PWTD::AMD {
             // 63:32 reserved:32
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, cppcCapability1 &regVal) const {
-            try {
-                regVal.lowestPerf = getBitfield(7, 0, raw);
-                regVal.lowNonLinPerf = getBitfield(15, 8, raw);
-                regVal.nominalPerf = getBitfield(23, 16, raw);
-                regVal.highestPerf = getBitfield(31, 24, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, cppcCapability1 &regVal) {
+            regVal.lowestPerf = getBitfield<7, 0>(raw);
+            regVal.lowNonLinPerf = getBitfield<15, 8>(raw);
+            regVal.nominalPerf = getBitfield<23, 16>(raw);
+            regVal.highestPerf = getBitfield<31, 24>(raw);
         }
 
     public:
@@ -62,9 +49,11 @@ namespace PWTD::AMD {
             cppcCapability1 regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, cpu))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::ROData<PWTS::AMD::CPPCCapability1>({
                 .lowestPerf = static_cast<int>(regVal.lowestPerf),
                 .lowNonLinPerf = static_cast<int>(regVal.lowNonLinPerf),
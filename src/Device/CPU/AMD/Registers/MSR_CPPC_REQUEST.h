@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/AMD/CPPCRequest.h"
@@ -35,40 +33,18 @@ namespace PWTD::AMD {
             // 63:32 reserved:32
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, cppcRequest &regVal) const {
-            try {
-                regVal.maxPerf = getBitfield(7, 0, raw);
-                regVal.minPerf = getBitfield(15, 8, raw);
-                regVal.desPerf = getBitfield(23, 16, raw);
-                regVal.epp = getBitfield(31, 24, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, cppcRequest &regVal) {
+            regVal.maxPerf = getBitfield<7, 0>(raw);
+            regVal.minPerf = getBitfield<15, 8>(raw);
+            regVal.desPerf = getBitfield<23, 16>(raw);
+            regVal.epp = getBitfield<31, 24>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const cppcRequest &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(7, 0, regVal.maxPerf, raw);
-                setBitfield(15, 8, regVal.minPerf, raw);
-                setBitfield(23, 16, regVal.desPerf, raw);
-                setBitfield(31, 24, regVal.epp, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const cppcRequest &regVal, uint64_t &raw) {
+            setBitfield<7, 0>(regVal.maxPerf, raw);
+            setBitfield<15, 8>(regVal.minPerf, raw);
+            setBitfield<23, 16>(regVal.desPerf, raw);
+            setBitfield<31, 24>(regVal.epp, raw);
         }
 
     public:
@@ -80,9 +56,11 @@ namespace PWTD::AMD {
             cppcRequest regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, cpu))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::AMD::CPPCRequest>({
                 .maxPerf = static_cast<int>(regVal.maxPerf),
                 .minPerf = static_cast<int>(regVal.minPerf),
@@ -105,7 +83,12 @@ namespace PWTD::AMD {
             regVal.desPerf = cppcReq.desPerf;
             regVal.epp = cppcReq.epp;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
+            if (!msrUtils->readMSR(raw, addr, cpu))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
                 return false;
 
             return cur == raw;
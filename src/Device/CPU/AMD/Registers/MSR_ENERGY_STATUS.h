@@ -0,0 +1,57 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "../../CPURegister.h"
+#include "../../Utils/CPUUtils.h"
+#include "pwtShared/Include/Types/ROData.h"
+
+namespace PWTD::AMD {
+    // core and package energy counters share the same layout, total energy consumed in MSR_RAPL_POWER_UNIT energy units
+    class MSR_ENERGY_STATUS final: public CPURegister {
+    private:
+        struct energyStatus final {
+            uint64_t totalEnergyConsumed :32; // 31:0
+            // 63:32 reserved:32
+        };
+
+        static constexpr void setBitfields(const uint64_t raw, energyStatus &regVal) {
+            regVal.totalEnergyConsumed = getBitfield<31, 0>(raw);
+        }
+
+    public:
+        static constexpr uint32_t CORE = 0xc001029a;
+        static constexpr uint32_t PKG = 0xc001029b;
+
+        explicit MSR_ENERGY_STATUS(const uint32_t address) {
+            addr = address;
+        }
+
+        PWTS::ROData<uint32_t> getEnergyCounter(const int cpu) const {
+            energyStatus regVal {};
+            uint64_t raw = 0;
+
+            if (!msrUtils->readMSR(raw, addr, cpu))
+                return {};
+
+            setBitfields(raw, regVal);
+
+            return PWTS::ROData<uint32_t>(static_cast<uint32_t>(regVal.totalEnergyConsumed), true);
+        }
+    };
+}
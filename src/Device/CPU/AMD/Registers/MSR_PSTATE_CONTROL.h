@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/Types/RWData.h"
@@ -31,34 +29,12 @@ namespace PWTD::AMD {
             // 63:4 reserved:60
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, PStateControl &regVal) const {
-            try {
-                regVal.pstateCmd = getBitfield(3, 0, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, PStateControl &regVal) {
+            regVal.pstateCmd = getBitfield<3, 0>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const PStateControl &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(3, 0, regVal.pstateCmd, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const PStateControl &regVal, uint64_t &raw) {
+            setBitfield<3, 0>(regVal.pstateCmd, raw);
         }
 
     public:
@@ -70,9 +46,11 @@ namespace PWTD::AMD {
             PStateControl regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, cpu))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<int>(static_cast<int>(regVal.pstateCmd), true);
         }
 
@@ -86,7 +64,12 @@ namespace PWTD::AMD {
 
             regVal.pstateCmd = data.getValue();
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
+            if (!msrUtils->readMSR(raw, addr, cpu))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/AMD/PStateCurrentLimit.h"
@@ -33,20 +31,9 @@ namespace PWTD::AMD {
             // 63:8 reserved:56
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, PStateCurrentLimit &regVal) const {
-            try {
-                regVal.curPStateLimit = getBitfield(3, 0, raw);
-                regVal.pstateMaxVal = getBitfield(7, 4, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, PStateCurrentLimit &regVal) {
+            regVal.curPStateLimit = getBitfield<3, 0>(raw);
+            regVal.pstateMaxVal = getBitfield<7, 4>(raw);
         }
 
     public:
@@ -58,9 +45,11 @@ namespace PWTD::AMD {
             PStateCurrentLimit regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::ROData<PWTS::AMD::PStateCurrentLimit>({
                 .curPStateLimit = static_cast<int>(regVal.curPStateLimit),
                 .pstateMaxValue = static_cast<int>(regVal.pstateMaxVal)
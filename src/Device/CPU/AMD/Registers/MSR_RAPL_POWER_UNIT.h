@@ -0,0 +1,60 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QtMath>
+
+#include "../../CPURegister.h"
+#include "../../Utils/CPUUtils.h"
+#include "pwtShared/Include/Types/ROData.h"
+
+namespace PWTD::AMD {
+    class MSR_RAPL_POWER_UNIT final: public CPURegister {
+    private:
+        struct raplPowerUnit final {
+            uint64_t powerUnits :4; // 3:0
+            // 7:4 reserved:4
+            uint64_t energyStatusUnits :5; // 12:8
+            // 15:13 reserved:3
+            uint64_t timeUnits :4; // 19:16
+            // 63:20 reserved:44
+        };
+
+        static constexpr void setBitfields(const uint64_t raw, raplPowerUnit &regVal) {
+            regVal.energyStatusUnits = getBitfield<12, 8>(raw);
+        }
+
+    public:
+        MSR_RAPL_POWER_UNIT() {
+            addr = 0xc0010299;
+        }
+
+        // joules per energy status count
+        PWTS::ROData<double> getEnergyUnit() const {
+            raplPowerUnit regVal {};
+            uint64_t raw = 0;
+
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return {};
+
+            setBitfields(raw, regVal);
+
+            return PWTS::ROData<double>(1 / qPow(2, regVal.energyStatusUnits), true);
+        }
+    };
+}
@@ -23,6 +23,9 @@
 namespace PWTD::AMD {
     RyzenAdj::RyzenAdj() {
         logger = FileLogger::getInstance();
+        applyEngine = ApplyEngine::getInstance();
+
+        tableClock.start();
     }
 
     RyzenAdj::~RyzenAdj() {
@@ -47,6 +50,7 @@ namespace PWTD::AMD {
         }
 
         cpuCoreCount = numCores;
+        snapshotNsecs = tableClock.nsecsElapsed();
 
         fillRyTableCache();
         return true;
@@ -102,6 +106,9 @@ namespace PWTD::AMD {
             return false;
         }
 
+        // limits in the table changed, neither the snapshot nor a pending refresh has them
+        snapshotNsecs = -1;
+        refreshIssuedNsecs = -1;
         return true;
     }
 
@@ -177,6 +184,81 @@ namespace PWTD::AMD {
         return true;
     }
 
+    // the timer sends one refresh cmd per tick without waiting, a tick copies what the previous one asked for
+    // so the snapshot is dated to the previous cmd, only reads that need a newer table block
+    bool RyzenAdj::refreshTable(const int maxStaleness) const {
+        const qint64 now = tableClock.nsecsElapsed();
+
+        lastReadNsecs = now;
+        ++readStats.reads;
+
+        if (refreshTimer.isNull()) {
+            refreshTimer.reset(new QTimer);
+            refreshTimer->setInterval(RefreshInterval);
+
+            QObject::connect(refreshTimer.get(), &QTimer::timeout, refreshTimer.get(), [this]() { onRefreshTimerTimeout(); });
+        }
+
+        if (!refreshTimer->isActive())
+            refreshTimer->start();
+
+        if (snapshotNsecs >= 0 && (now - snapshotNsecs) <= (static_cast<qint64>(maxStaleness) * 1000000)) {
+            readStats.stallNsecs += tableClock.nsecsElapsed() - now;
+            return true;
+        }
+
+        const bool res = refreshRyzenAdjTable();
+        const qint64 stall = tableClock.nsecsElapsed() - now;
+
+        ++readStats.blockingRefreshes;
+        readStats.stallNsecs += stall;
+        readStats.maxStallNsecs = qMax(readStats.maxStallNsecs, stall);
+
+        if (!res)
+            return false;
+
+        refreshIssuedNsecs = now;
+        snapshotNsecs = now;
+        return true;
+    }
+
+    void RyzenAdj::onRefreshTimerTimeout() const {
+        const qint64 now = tableClock.nsecsElapsed();
+
+        if ((now - lastReadNsecs) > (static_cast<qint64>(RefreshIdleTimeout) * 1000000)) {
+            if (logger->isLevel(PWTS::LogLevel::Info) && readStats.reads > 0) {
+                logger->write(QString("RyzenAdj: %1 table reads, %2 blocking refreshes, stall total %3us avg %4us max %5us")
+                              .arg(readStats.reads).arg(readStats.blockingRefreshes).arg(readStats.stallNsecs / 1000)
+                              .arg(readStats.stallNsecs / 1000 / static_cast<qint64>(readStats.reads)).arg(readStats.maxStallNsecs / 1000));
+            }
+
+            readStats = {};
+            refreshTimer->stop();
+            return;
+        }
+
+        const ADJ_ERROR ret = ryzenadj_refresh_table();
+
+        if (ret != ADJ_OK) {
+            if (logger->isLevel(PWTS::LogLevel::Error))
+                logger->write(QString("failed to refresh table: code %1").arg(ret));
+
+            return;
+        }
+
+        if (refreshIssuedNsecs >= 0)
+            snapshotNsecs = qMax(snapshotNsecs, refreshIssuedNsecs);
+
+        refreshIssuedNsecs = now;
+    }
+
+    qint64 RyzenAdj::getTableAge() const {
+        if (snapshotNsecs < 0)
+            return -1;
+
+        return (tableClock.nsecsElapsed() - snapshotNsecs) / 1000000;
+    }
+
     QSet<PWTS::Feature> RyzenAdj::getFeatures() {
         QSet<PWTS::Feature> features;
 
@@ -340,7 +422,7 @@ namespace PWTD::AMD {
     }
 
     void RyzenAdj::fillPacketData(const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const {
-        if (!refreshRyzenAdjTable())
+        if (!refreshTable(DefaultMaxStaleness))
             packet.errors.insert(PWTS::DError::RY_REFRESH_TABLE);
 
         fillPackageData(features, packet);
@@ -352,59 +434,59 @@ namespace PWTD::AMD {
     void RyzenAdj::applyPackageSettings(const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const {
         const QSharedPointer<PWTS::AMD::AMDData> data = packet.amdData;
 
-        if (features.contains(PWTS::Feature::AMD_RY_APU_SLOW_W) && !ryzenAdjSet(ADJ_OPT_APU_SLOW_LIMIT, data->apuSlow))
+        if (features.contains(PWTS::Feature::AMD_RY_APU_SLOW_W) && !applyEngine->apply(PWTS::DError::W_RY_APU_SLOW, data->apuSlow, [&]()->bool { return ryzenAdjSet(ADJ_OPT_APU_SLOW_LIMIT, data->apuSlow); }))
             errors.insert(PWTS::DError::W_RY_APU_SLOW);
 
-        if (features.contains(PWTS::Feature::AMD_RY_STAPM_LIMIT_W) && !ryzenAdjSet(ADJ_OPT_STAPM_LIMIT, data->stapmLimit))
+        if (features.contains(PWTS::Feature::AMD_RY_STAPM_LIMIT_W) && !applyEngine->apply(PWTS::DError::W_RY_STAPM_LIMIT, data->stapmLimit, [&]()->bool { return ryzenAdjSet(ADJ_OPT_STAPM_LIMIT, data->stapmLimit); }))
             errors.insert(PWTS::DError::W_RY_STAPM_LIMIT);
 
-        if (features.contains(PWTS::Feature::AMD_RY_SLOW_LIMIT_W) && !ryzenAdjSet(ADJ_OPT_SLOW_LIMIT, data->slowLimit))
+        if (features.contains(PWTS::Feature::AMD_RY_SLOW_LIMIT_W) && !applyEngine->apply(PWTS::DError::W_RY_SLOW_LIMIT, data->slowLimit, [&]()->bool { return ryzenAdjSet(ADJ_OPT_SLOW_LIMIT, data->slowLimit); }))
             errors.insert(PWTS::DError::W_RY_SLOW_LIMIT);
 
-        if (features.contains(PWTS::Feature::AMD_RY_FAST_LIMIT_W) && !ryzenAdjSet(ADJ_OPT_FAST_LIMIT, data->fastLimit))
+        if (features.contains(PWTS::Feature::AMD_RY_FAST_LIMIT_W) && !applyEngine->apply(PWTS::DError::W_RY_FAST_LIMIT, data->fastLimit, [&]()->bool { return ryzenAdjSet(ADJ_OPT_FAST_LIMIT, data->fastLimit); }))
             errors.insert(PWTS::DError::W_RY_FAST_LIMIT);
 
-        if (features.contains(PWTS::Feature::AMD_RY_TCTL_TEMP_W) && !ryzenAdjSet(ADJ_OPT_TCTL_TEMP, data->tctlTemp))
+        if (features.contains(PWTS::Feature::AMD_RY_TCTL_TEMP_W) && !applyEngine->apply(PWTS::DError::W_RY_TCTL_TEMP, data->tctlTemp, [&]()->bool { return ryzenAdjSet(ADJ_OPT_TCTL_TEMP, data->tctlTemp); }))
             errors.insert(PWTS::DError::W_RY_TCTL_TEMP);
 
-        if (features.contains(PWTS::Feature::AMD_RY_APU_SKIN_TEMP_W) && !ryzenAdjSet(ADJ_OPT_APU_SKIN_TEMP_LIMIT, data->apuSkinTemp))
+        if (features.contains(PWTS::Feature::AMD_RY_APU_SKIN_TEMP_W) && !applyEngine->apply(PWTS::DError::W_RY_APU_SKIN_TEMP, data->apuSkinTemp, [&]()->bool { return ryzenAdjSet(ADJ_OPT_APU_SKIN_TEMP_LIMIT, data->apuSkinTemp); }))
             errors.insert(PWTS::DError::W_RY_APU_SKIN_TEMP);
 
-        if (features.contains(PWTS::Feature::AMD_RY_DGPU_SKIN_TEMP_W) && !ryzenAdjSet(ADJ_OPT_DGPU_SKIN_TEMP_LIMIT, data->dgpuSkinTemp))
+        if (features.contains(PWTS::Feature::AMD_RY_DGPU_SKIN_TEMP_W) && !applyEngine->apply(PWTS::DError::W_RY_DGPU_SKIN_TEMP, data->dgpuSkinTemp, [&]()->bool { return ryzenAdjSet(ADJ_OPT_DGPU_SKIN_TEMP_LIMIT, data->dgpuSkinTemp); }))
             errors.insert(PWTS::DError::W_RY_DGPU_SKIN_TEMP);
 
-        if (features.contains(PWTS::Feature::AMD_RY_VRM_CURRENT_W) && !ryzenAdjSet(ADJ_OPT_VRM_CURRENT, data->vrmCurrent))
+        if (features.contains(PWTS::Feature::AMD_RY_VRM_CURRENT_W) && !applyEngine->apply(PWTS::DError::W_RY_VRM_CURRENT, data->vrmCurrent, [&]()->bool { return ryzenAdjSet(ADJ_OPT_VRM_CURRENT, data->vrmCurrent); }))
             errors.insert(PWTS::DError::W_RY_VRM_CURRENT);
 
-        if (features.contains(PWTS::Feature::AMD_RY_VRM_SOC_CURRENT_W) && !ryzenAdjSet(ADJ_OPT_VRMSOC_CURRENT, data->vrmSocCurrent))
+        if (features.contains(PWTS::Feature::AMD_RY_VRM_SOC_CURRENT_W) && !applyEngine->apply(PWTS::DError::W_RY_VRM_SOC_CURRENT, data->vrmSocCurrent, [&]()->bool { return ryzenAdjSet(ADJ_OPT_VRMSOC_CURRENT, data->vrmSocCurrent); }))
             errors.insert(PWTS::DError::W_RY_VRM_SOC_CURRENT);
 
-        if (features.contains(PWTS::Feature::AMD_RY_VRM_MAX_CURRENT_W) && !ryzenAdjSet(ADJ_OPT_VRMMAX_CURRENT, data->vrmMaxCurrent))
+        if (features.contains(PWTS::Feature::AMD_RY_VRM_MAX_CURRENT_W) && !applyEngine->apply(PWTS::DError::W_RY_VRM_MAX_CURRENT, data->vrmMaxCurrent, [&]()->bool { return ryzenAdjSet(ADJ_OPT_VRMMAX_CURRENT, data->vrmMaxCurrent); }))
             errors.insert(PWTS::DError::W_RY_VRM_MAX_CURRENT);
 
-        if (features.contains(PWTS::Feature::AMD_RY_VRM_SOC_MAX_CURRENT_W) && !ryzenAdjSet(ADJ_OPT_VRMSOCMAX_CURRENT, data->vrmSocMaxCurrent))
+        if (features.contains(PWTS::Feature::AMD_RY_VRM_SOC_MAX_CURRENT_W) && !applyEngine->apply(PWTS::DError::W_RY_VRM_SOC_MAX_CURRENT, data->vrmSocMaxCurrent, [&]()->bool { return ryzenAdjSet(ADJ_OPT_VRMSOCMAX_CURRENT, data->vrmSocMaxCurrent); }))
             errors.insert(PWTS::DError::W_RY_VRM_SOC_MAX_CURRENT);
 
-        if (features.contains(PWTS::Feature::AMD_RY_STATIC_GFX_CLK_W) && !ryzenAdjSet(ADJ_OPT_GFX_CLK, data->staticGfxClock))
+        if (features.contains(PWTS::Feature::AMD_RY_STATIC_GFX_CLK_W) && !applyEngine->apply(PWTS::DError::W_RY_STATIC_GFX_CLOCK, data->staticGfxClock, [&]()->bool { return ryzenAdjSet(ADJ_OPT_GFX_CLK, data->staticGfxClock); }))
             errors.insert(PWTS::DError::W_RY_STATIC_GFX_CLOCK);
 
-        if (features.contains(PWTS::Feature::AMD_RY_MIN_GFX_CLOCK_W) && !ryzenAdjSet(ADJ_OPT_MIN_GFXCLK_FREQ, data->minGfxClock))
+        if (features.contains(PWTS::Feature::AMD_RY_MIN_GFX_CLOCK_W) && !applyEngine->apply(PWTS::DError::W_RY_MIN_GFX_CLOCK, data->minGfxClock, [&]()->bool { return ryzenAdjSet(ADJ_OPT_MIN_GFXCLK_FREQ, data->minGfxClock); }))
             errors.insert(PWTS::DError::W_RY_MIN_GFX_CLOCK);
 
-        if (features.contains(PWTS::Feature::AMD_RY_MAX_GFX_CLOCK_W) && !ryzenAdjSet(ADJ_OPT_MAX_GFXCLK_FREQ, data->maxGfxClock))
+        if (features.contains(PWTS::Feature::AMD_RY_MAX_GFX_CLOCK_W) && !applyEngine->apply(PWTS::DError::W_RY_MAX_GFX_CLOCK, data->maxGfxClock, [&]()->bool { return ryzenAdjSet(ADJ_OPT_MAX_GFXCLK_FREQ, data->maxGfxClock); }))
             errors.insert(PWTS::DError::W_RY_MAX_GFX_CLOCK);
 
-        if (features.contains(PWTS::Feature::AMD_RY_POWER_PROFILE_W) && !setPowerProfile(data->powerProfile))
+        if (features.contains(PWTS::Feature::AMD_RY_POWER_PROFILE_W) && !applyEngine->apply(PWTS::DError::W_RY_POWER_PROFILE, data->powerProfile, [&]()->bool { return setPowerProfile(data->powerProfile); }))
             errors.insert(PWTS::DError::W_RY_POWER_PROFILE);
 
-        if (features.contains(PWTS::Feature::AMD_RY_CO_ALL_W) && !setCurveOptimizerAll(data->curveOptimizer))
+        if (features.contains(PWTS::Feature::AMD_RY_CO_ALL_W) && !applyEngine->apply(PWTS::DError::W_RY_CO_ALL, data->curveOptimizer, [&]()->bool { return setCurveOptimizerAll(data->curveOptimizer); }))
             errors.insert(PWTS::DError::W_RY_CO_ALL);
     }
 
     void RyzenAdj::applyCoreSettings(const int cpu, const int coreIdx, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const {
         const PWTS::AMD::AMDCoreData &data = packet.amdData->coreData[cpu];
 
-        if (features.contains(PWTS::Feature::AMD_RY_CO_PER_W) && !setCurveOptimizerCore(cpu, data.curveOptimizer))
+        if (features.contains(PWTS::Feature::AMD_RY_CO_PER_W) && !applyEngine->apply(PWTS::DError::W_RY_CO_PER, cpu, data.curveOptimizer, [&]()->bool { return setCurveOptimizerCore(cpu, data.curveOptimizer); }))
             errors.insert(PWTS::DError::W_RY_CO_PER);
     }
 
@@ -464,10 +546,30 @@ namespace PWTD::AMD {
         return ryzenAdjSet(ADJ_OPT_COPER, co);
     }
 
-    PWTS::ROData<int> RyzenAdj::getTemperature() const {
-        if (!refreshRyzenAdjTable())
+    PWTS::ROData<int> RyzenAdj::getTemperature(const int maxStaleness) const {
+        if (!refreshTable(maxStaleness))
             return {};
 
         return ryzenAdjRead(ADJ_OPT_TCTL_TEMP, 1);
     }
+
+    // no extra smu cmd, copies the table the refresh timer already keeps
+    PMTableSnapshot RyzenAdj::getPMTableSnapshot(const int maxStaleness) const {
+        PMTableSnapshot snapshot;
+
+        if (!refreshTable(maxStaleness))
+            return snapshot;
+
+        const float *table = ryzenadj_get_table_values();
+        const size_t size = ryzenadj_get_table_size() / sizeof(float);
+
+        if (table == nullptr || size == 0)
+            return snapshot;
+
+        snapshot.version = ryzenadj_get_table_ver();
+        snapshot.age = getTableAge();
+        snapshot.raw = QList<float>(table, table + size);
+
+        return snapshot;
+    }
 }
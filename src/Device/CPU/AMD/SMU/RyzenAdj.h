@@ -18,20 +18,42 @@
 #pragma once
 
 #include <QVariant>
+#include <QTimer>
+#include <QElapsedTimer>
 
 #include "libryzenadj/ryzenadj.h"
 #include "../../Utils/FileLogger/FileLogger.h"
+#include "../../../ApplyEngine.h"
+#include "../../../Telemetry/PMTableSnapshot.h"
 #include "pwtShared/Include/Feature.h"
 #include "pwtShared/Include/Packets/DaemonPacket.h"
 #include "pwtShared/Include/Packets/ClientPacket.h"
 
 namespace PWTD::AMD {
     class RyzenAdj final {
+    public:
+        // time reads spend blocked in refreshTable, reset when the refresh timer goes idle
+        struct ReadStats final {
+            quint64 reads = 0;
+            quint64 blockingRefreshes = 0;
+            qint64 stallNsecs = 0; // total, cached reads included
+            qint64 maxStallNsecs = 0;
+        };
+
     private:
         static constexpr uint32_t curveOptimizerBase = 0x100000;
+        static constexpr int RefreshInterval = 1000; // msecs
+        static constexpr int RefreshIdleTimeout = 10000; // msecs without reads before the refresh timer stops
         QSharedPointer<FileLogger> logger;
+        QSharedPointer<ApplyEngine> applyEngine;
         mutable QHash<int, QVariant> ryTable; // cache for values that may not have a read cmd
         int cpuCoreCount = 0;
+        mutable QScopedPointer<QTimer> refreshTimer; // created on first read, so it lives on the device thread
+        QElapsedTimer tableClock;
+        mutable qint64 refreshIssuedNsecs = -1; // last refresh cmd sent to the smu
+        mutable qint64 snapshotNsecs = -1; // the table is at least this fresh
+        mutable qint64 lastReadNsecs = -1;
+        mutable ReadStats readStats;
 
         void fillRyTableCache() const;
         [[nodiscard]] bool ryzenAdjSet(ADJ_OPT opt, uint32_t value) const;
@@ -40,6 +62,8 @@ namespace PWTD::AMD {
         PWTS::RWData<int> ryzenAdjGet(ADJ_OPT opt, int valueMult) const;
         PWTS::ROData<int> ryzenAdjRead(ADJ_OPT opt, int valueMult) const;
         [[nodiscard]] bool refreshRyzenAdjTable() const;
+        [[nodiscard]] bool refreshTable(int maxStaleness) const;
+        void onRefreshTimerTimeout() const;
         void fillPackageData(const QSet<PWTS::Feature> &features, const PWTS::DaemonPacket &packet) const;
         void fillCoreData(int cpu, const QSet<PWTS::Feature> &features, const PWTS::DaemonPacket &packet) const;
         void applyPackageSettings(const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
@@ -49,6 +73,10 @@ namespace PWTD::AMD {
         [[nodiscard]] bool setCurveOptimizerCore(int cpu, const PWTS::RWData<int> &data) const;
 
     public:
+        // a snapshot is dated to the previous refresh cmd, so it is almost 2 intervals old right before a tick
+        // one more interval of slack keeps late timer ticks off the blocking path
+        static constexpr int DefaultMaxStaleness = RefreshInterval * 3; // msecs
+
         RyzenAdj();
         ~RyzenAdj();
 
@@ -56,6 +84,9 @@ namespace PWTD::AMD {
         [[nodiscard]] QSet<PWTS::Feature> getFeatures();
         void fillPacketData(const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const;
         [[nodiscard]] QSet<PWTS::DError> applySettings(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const;
-        [[nodiscard]] PWTS::ROData<int> getTemperature() const;
+        [[nodiscard]] PWTS::ROData<int> getTemperature(int maxStaleness = DefaultMaxStaleness) const;
+        [[nodiscard]] qint64 getTableAge() const; // msecs, -1 if the table was never refreshed
+        [[nodiscard]] ReadStats getReadStats() const { return readStats; }
+        [[nodiscard]] PMTableSnapshot getPMTableSnapshot(int maxStaleness = DefaultMaxStaleness) const;
     };
 }
@@ -21,6 +21,8 @@
 namespace PWTD {
     CPUDevice::CPUDevice(const QSharedPointer<cpu_id_t> &cpuid, const QSharedPointer<cpu_raw_data_t> &cpuRawData) {
         logger = FileLogger::getInstance();
+        applyEngine = ApplyEngine::getInstance();
+        workerPool = CPUWorkerPool::getInstance();
         cpuidRaw = cpuRawData;
         cpuInfo = QSharedPointer<PWTS::CpuInfo>::create();
 
@@ -59,5 +61,16 @@ namespace PWTD {
 
             cpuInfo->l4Cache = QString("%1  %2-way").arg(l4Size).arg(cpuid->l4_assoc);
         }
+
+        // cpuid leaf 6 ecx bit 0, hardware coordination feedback (APERF/MPERF)
+        if (cpuRawData->basic_cpuid[6][cpu_registers_t::ECX] & 1)
+            frequencySampler.reset(new FrequencySampler(cpuInfo->numLogicalCpus));
+    }
+
+    FrequencySample CPUDevice::getFrequencySample() const {
+        if (frequencySampler.isNull())
+            return {};
+
+        return frequencySampler->sample();
     }
 }
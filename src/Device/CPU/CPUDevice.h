@@ -23,7 +23,11 @@
 #include "pwtShared/Include/Packets/DaemonPacket.h"
 #include "pwtShared/Include/Packets/ClientPacket.h"
 #include "../../Utils/FileLogger/FileLogger.h"
-#include "Utils/MSR/MSR.h"
+#include "../ApplyEngine.h"
+#include "../Telemetry/PMTableSnapshot.h"
+#include "Utils/MSR/MSRHandle.h"
+#include "Utils/CPUWorkerPool/CPUWorkerPool.h"
+#include "Utils/FrequencySampler/FrequencySampler.h"
 
 namespace PWTD {
     class CPUDevice {
@@ -32,6 +36,9 @@ namespace PWTD {
         QSharedPointer<PWTS::CpuInfo> cpuInfo;
         QSharedPointer<cpu_raw_data_t> cpuidRaw;
         QSharedPointer<MSR> msrDev;
+        QSharedPointer<ApplyEngine> applyEngine;
+        QSharedPointer<CPUWorkerPool> workerPool;
+        mutable QScopedPointer<FrequencySampler> frequencySampler;
 
     public:
         CPUDevice(const QSharedPointer<cpu_id_t> &cpuid, const QSharedPointer<cpu_raw_data_t> &cpuRawData);
@@ -41,7 +48,10 @@ namespace PWTD {
         virtual void fillDaemonPacket(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, PWTS::DaemonPacket &packet) const = 0;
         [[nodiscard]] virtual QSet<PWTS::DError> applySettings(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const = 0;
         [[nodiscard]] virtual PWTS::ROData<int> getTemperature() const = 0;
+        [[nodiscard]] virtual QMap<QString, int> getPower(const QList<int> &coreIdxList) const { return {}; } // milliwatts by domain, "package" is the socket total
+        [[nodiscard]] virtual PMTableSnapshot getPMTableSnapshot(int maxStaleness) const { return {}; } // version 0 without a pm table
 
         [[nodiscard]] QSharedPointer<PWTS::CpuInfo> getCpuInfo() const { return cpuInfo; }
+        [[nodiscard]] FrequencySample getFrequencySample() const; // empty lists without aperf/mperf
     };
 }
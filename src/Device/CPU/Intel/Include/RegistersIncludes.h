@@ -27,6 +27,7 @@
 #include "../Registers/IA32_HWP_CTL.h"
 #include "../Registers/MSR_PLATFORM_INFO/MSR_PLATFORM_INFO.h"
 #include "../Registers/MSR_PKG_POWER_LIMIT.h"
+#include "../Registers/MSR_ENERGY_STATUS.h"
 #include "../Registers/MSR_VR_CURRENT_CONFIG/MSR_VR_CURRENT_CONFIG.h"
 #include "../Registers/MSR_PP1_CURRENT_CONFIG.h"
 #include "../Registers/MSR_TURBO_POWER_CURRENT_LIMIT.h"
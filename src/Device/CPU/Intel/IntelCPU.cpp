@@ -154,6 +154,9 @@ namespace PWTD::Intel {
                 const std::unique_ptr<MSR_RAPL_POWER_UNIT> msrRaplPowUnit = std::make_unique<MSR_RAPL_POWER_UNIT>();
 
                 regsCache->raplPowerUnit = msrRaplPowUnit->getPowerUnitData();
+
+                if (regsCache->raplPowerUnit.isValid())
+                    raplSampler.init(regsCache->raplPowerUnit.getValue().energyUnit);
             }
 
             if (!msrTemperatureTarget.isNull()) {
@@ -172,144 +175,65 @@ namespace PWTD::Intel {
 
     bool IntelCPU::hasIA32PkgThermStatusBit() const {
         const uint32_t eax = cpuidRaw->basic_cpuid[6][cpu_registers_t::EAX];
-        bool ret;
-
-        try {
-            ret = getBitfield(6, 6, eax) == 1;
 
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<6, 6>(eax) == 1;
     }
 
     bool IntelCPU::hasEnergyPerfBiasBit() const {
         const uint32_t ecx = cpuidRaw->basic_cpuid[6][cpu_registers_t::ECX];
-        bool ret;
-
-        try {
-            ret = getBitfield(3, 3, ecx) == 1;
 
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<3, 3>(ecx) == 1;
     }
 
     bool IntelCPU::hasTurboBoostTechBit() const {
         const PWTS::RWData<PWTS::Intel::MiscProcFeatures> miscFeaturesData = ia32MiscEnable->getMiscProcessorFeaturesData();
         const uint32_t eax = cpuidRaw->basic_cpuid[6][cpu_registers_t::EAX];
         const int disableTurbo = !miscFeaturesData.isValid() ? 0 : miscFeaturesData.getValue().disableTurboMode;
-        bool ret;
-
-        try { // eax bit is cleared when disabled, so show the feature even when disable is 1
-            ret = getBitfield(1, 1, eax) == 1 || disableTurbo == 1;
-
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
 
-        return ret;
+        // eax bit is cleared when disabled, so show the feature even when disable is 1
+        return getBitfield<1, 1>(eax) == 1 || disableTurbo == 1;
     }
 
     bool IntelCPU::hasEnhancedSpeedStepBit() const {
         const uint32_t ecx = cpuidRaw->basic_cpuid[1][cpu_registers_t::ECX];
-        bool ret;
 
-        try {
-            ret = getBitfield(7, 7, ecx) == 1;
-
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<7, 7>(ecx) == 1;
     }
 
     bool IntelCPU::hasHWPBit() const {
         const uint32_t eax = cpuidRaw->basic_cpuid[6][cpu_registers_t::EAX];
-        bool ret;
-
-        try {
-            ret = getBitfield(7, 7, eax) == 1;
-
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
 
-        return ret;
+        return getBitfield<7, 7>(eax) == 1;
     }
 
     bool IntelCPU::hasHWPReqActivityWindowBit() const {
         const uint32_t eax = cpuidRaw->basic_cpuid[6][cpu_registers_t::EAX];
-        bool ret;
-
-        try {
-            ret = getBitfield(9, 9, eax) == 1;
 
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<9, 9>(eax) == 1;
     }
 
     bool IntelCPU::hasHWPReqEPPBit() const {
         const uint32_t eax = cpuidRaw->basic_cpuid[6][cpu_registers_t::EAX];
-        bool ret;
-
-        try {
-            ret = getBitfield(10, 10, eax) == 1;
 
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<10, 10>(eax) == 1;
     }
 
     bool IntelCPU::hasHWPRequestPkgBit() const {
         const uint32_t eax = cpuidRaw->basic_cpuid[6][cpu_registers_t::EAX];
-        bool ret;
-
-        try {
-            ret = getBitfield(11, 11, eax) == 1;
-
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
 
-        return ret;
+        return getBitfield<11, 11>(eax) == 1;
     }
 
     bool IntelCPU::hasHWPReqValidBitsBit() const {
         const uint32_t eax = cpuidRaw->basic_cpuid[6][cpu_registers_t::EAX];
-        bool ret;
 
-        try {
-            ret = getBitfield(17, 17, eax) == 1;
-
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<17, 17>(eax) == 1;
     }
 
     bool IntelCPU::hasHWPCtlBit() const {
         const uint32_t eax = cpuidRaw->basic_cpuid[6][cpu_registers_t::EAX];
-        bool ret;
 
-        try {
-            ret = getBitfield(22, 22, eax) == 1;
-
-        } catch ([[maybe_unused]] std::invalid_argument const &e) {
-            return false;
-        }
-
-        return ret;
+        return getBitfield<22, 22>(eax) == 1;
     }
 
     QSet<PWTS::Feature> IntelCPU::getFeatures() const {
@@ -469,7 +393,9 @@ namespace PWTD::Intel {
         if (!features.contains(PWTS::Feature::INTEL_CPU_GROUP))
             return;
 
-        if (!msrDev->openMsrFd(0)) {
+        const MSRHandle msrHandle {msrDev, 0};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QStringLiteral("failed to open msr fd"));
 
@@ -522,8 +448,6 @@ namespace PWTD::Intel {
             if (features.contains(PWTS::Feature::INTEL_HWP_CTL))
                 packet.intelData->hwpPkgCtlPolarity = ia32HwpCtl->getHwpCtlBit();
         }
-
-        msrDev->closeMsrFd(0);
     }
 
     void IntelCPU::fillCoreData(const int cpu, const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const {
@@ -534,7 +458,9 @@ namespace PWTD::Intel {
             return;
         }
 
-        if (!msrDev->openMsrFd(cpu)) {
+        const MSRHandle msrHandle {msrDev, cpu};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QString("failed to open msr fd for cpu %1").arg(cpu));
 
@@ -546,24 +472,20 @@ namespace PWTD::Intel {
         if (features.contains(PWTS::Feature::INTEL_PKG_CST_CONFIG_CONTROL))
             coreData.pkgCstConfigControl = msrPkgCstConfigControl->getPkgCstConfigControlData(cpu);
 
-        msrDev->closeMsrFd(cpu);
         packet.intelData->coreData.append(coreData);
     }
 
-    void IntelCPU::fillThreadData(const int cpu, const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const {
-        PWTS::Intel::IntelThreadData thdData {};
-
-        if (!features.contains(PWTS::Feature::INTEL_CPU_GROUP)) {
-            packet.intelData->threadData.append(thdData);
+    void IntelCPU::fillThreadData(const int cpu, const QSet<PWTS::Feature> &features, PWTS::Intel::IntelThreadData &thdData, QSet<PWTS::DError> &errors) const {
+        if (!features.contains(PWTS::Feature::INTEL_CPU_GROUP))
             return;
-        }
 
-        if (!msrDev->openMsrFd(cpu)) {
+        const MSRHandle msrHandle {msrDev, cpu};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QString("failed to open msr fd for cpu %1").arg(cpu));
 
-            packet.errors.insert(PWTS::DError::NO_MSR_FD);
-            packet.intelData->threadData.append(thdData);
+            errors.insert(PWTS::DError::NO_MSR_FD);
             return;
         }
 
@@ -571,9 +493,6 @@ namespace PWTD::Intel {
             thdData.hwpCapapabilities = ia32HWPCapabilities->getHWPCapabilitiesData(cpu);
             thdData.hwpRequest = ia32HWPRequest->getHWPRequestData(cpu);
         }
-
-        msrDev->closeMsrFd(cpu);
-        packet.intelData->threadData.append(thdData);
     }
 
     void IntelCPU::fillDaemonPacket(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, PWTS::DaemonPacket &packet) const {
@@ -592,8 +511,17 @@ namespace PWTD::Intel {
         for (int i=0,l=cpuInfo->numCores; i<l; ++i)
             fillCoreData(coreIdxList[i], features, packet);
 
-        for (int i=0,l=cpuInfo->numLogicalCpus; i<l; ++i)
-            fillThreadData(i, features, packet);
+        QList<PWTS::Intel::IntelThreadData> threadData(cpuInfo->numLogicalCpus);
+        QList<QSet<PWTS::DError>> threadErrors(cpuInfo->numLogicalCpus);
+        PWTS::Intel::IntelThreadData *threadDataPtr = threadData.data();
+        QSet<PWTS::DError> *threadErrorsPtr = threadErrors.data();
+
+        workerPool->run(cpuInfo->numLogicalCpus, [&](const int cpu) { fillThreadData(cpu, features, threadDataPtr[cpu], threadErrorsPtr[cpu]); });
+
+        packet.intelData->threadData = threadData;
+
+        for (const QSet<PWTS::DError> &errs: std::as_const(threadErrors))
+            packet.errors.unite(errs);
 
         if (!mchbar.isNull())
             mchbar->fillPacketData(features, packet);
@@ -603,7 +531,9 @@ namespace PWTD::Intel {
         if (!features.contains(PWTS::Feature::INTEL_CPU_GROUP))
             return;
 
-        if (!msrDev->openMsrFd(0)) {
+        const MSRHandle msrHandle {msrDev, 0};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QStringLiteral("failed to open msr fd"));
 
@@ -617,73 +547,78 @@ namespace PWTD::Intel {
         const bool hasTurboPowCurrentLimit = features.contains(PWTS::Feature::INTEL_TURBO_POWER_CURRENT_LIMIT) &&
                                              features.contains(PWTS::Feature::INTEL_TURBO_POWER_CURRENT_LIMIT_RW);
 
-        if (features.contains(PWTS::Feature::INTEL_VR_CURRENT_CFG) && !msrVrCurrentConfig->setVrCurrentConfig(data->vrCurrentCfg))
+        if (features.contains(PWTS::Feature::INTEL_VR_CURRENT_CFG) && !applyEngine->apply(PWTS::DError::W_VR_CURRENT_CFG, data->vrCurrentCfg, [&]()->bool { return msrVrCurrentConfig->setVrCurrentConfig(data->vrCurrentCfg); }))
             errors.insert(PWTS::DError::W_VR_CURRENT_CFG);
 
-        if (features.contains(PWTS::Feature::INTEL_PP1_CURRENT_CFG) && !msrPP1CurrentConfig->setPP1CurrentConfig(data->pp1CurrentCfg))
+        if (features.contains(PWTS::Feature::INTEL_PP1_CURRENT_CFG) && !applyEngine->apply(PWTS::DError::W_PP1_CURRENT_CFG, data->pp1CurrentCfg, [&]()->bool { return msrPP1CurrentConfig->setPP1CurrentConfig(data->pp1CurrentCfg); }))
             errors.insert(PWTS::DError::W_PP1_CURRENT_CFG);
 
-        if (features.contains(PWTS::Feature::INTEL_CPU_POWER_BALANCE) && !msrPP0Policy->setPP0Priority(data->pp0Priority))
+        if (features.contains(PWTS::Feature::INTEL_CPU_POWER_BALANCE) && !applyEngine->apply(PWTS::DError::W_CPU_BLNC, data->pp0Priority, [&]()->bool { return msrPP0Policy->setPP0Priority(data->pp0Priority); }))
             errors.insert(PWTS::DError::W_CPU_BLNC);
 
-        if (features.contains(PWTS::Feature::INTEL_GPU_POWER_BALANCE) && !msrPP1Policy->setPP1Priority(data->pp1Priority))
+        if (features.contains(PWTS::Feature::INTEL_GPU_POWER_BALANCE) && !applyEngine->apply(PWTS::DError::W_GPU_BLNC, data->pp1Priority, [&]()->bool { return msrPP1Policy->setPP1Priority(data->pp1Priority); }))
             errors.insert(PWTS::DError::W_GPU_BLNC);
 
-        if (features.contains(PWTS::Feature::INTEL_ENERGY_PERF_BIAS) && !ia32EnergyPerfBias->setPowerPolicyPreference(data->energyPerfBias))
+        if (features.contains(PWTS::Feature::INTEL_ENERGY_PERF_BIAS) && !applyEngine->apply(PWTS::DError::W_ENERGY_PERF_BIAS, data->energyPerfBias, [&]()->bool { return ia32EnergyPerfBias->setPowerPolicyPreference(data->energyPerfBias); }))
             errors.insert(PWTS::DError::W_ENERGY_PERF_BIAS);
 
-        if (hasTurboRatioLimit && !msrTurboRatioLimit->setTurboRatioLimit(data->turboRatioLimit))
+        if (hasTurboRatioLimit && !applyEngine->apply(PWTS::DError::W_TURBO_RATIO_LIMIT, data->turboRatioLimit, [&]()->bool { return msrTurboRatioLimit->setTurboRatioLimit(data->turboRatioLimit); }))
             errors.insert(PWTS::DError::W_TURBO_RATIO_LIMIT);
 
-        if (features.contains(PWTS::Feature::INTEL_IA32_MISC_ENABLE_GROUP) && !ia32MiscEnable->setMiscProcessorFeatures(data->miscProcFeatures))
+        if (features.contains(PWTS::Feature::INTEL_IA32_MISC_ENABLE_GROUP) && !applyEngine->apply(PWTS::DError::W_MISC_PROC_FEATURES, data->miscProcFeatures, [&]()->bool { return ia32MiscEnable->setMiscProcessorFeatures(data->miscProcFeatures); }))
             errors.insert(PWTS::DError::W_MISC_PROC_FEATURES);
 
-        if (features.contains(PWTS::Feature::INTEL_POWER_CTL) && !msrPowerCtl->setPowerCtl(data->powerCtl))
+        if (features.contains(PWTS::Feature::INTEL_POWER_CTL) && !applyEngine->apply(PWTS::DError::W_POWER_CTL, data->powerCtl, [&]()->bool { return msrPowerCtl->setPowerCtl(data->powerCtl); }))
             errors.insert(PWTS::DError::W_POWER_CTL);
 
-        if (features.contains(PWTS::Feature::INTEL_MISC_PWR_MGMT) && !msrMiscPwrMgmt->setMiscPwrMgmt(data->miscPwrMgmt))
+        if (features.contains(PWTS::Feature::INTEL_MISC_PWR_MGMT) && !applyEngine->apply(PWTS::DError::W_MISC_PWR_MGMT, data->miscPwrMgmt, [&]()->bool { return msrMiscPwrMgmt->setMiscPwrMgmt(data->miscPwrMgmt); }))
             errors.insert(PWTS::DError::W_MISC_PWR_MGMT);
 
         if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_GROUP)) {
-            const MSR_UNK_FIVR_CONTROL::FIVRWriteResult res = msrUnkFivrControl->setFIVRControl(data->undervoltData);
+            const qsizetype errorCount = errors.size();
 
-            if (data->undervoltData.isValid()) // don't save invalid data
-                fivr = data->undervoltData.getValue();
+            [[maybe_unused]] const bool uvApplied = applyEngine->apply(PWTS::DError::W_CPU_UV, data->undervoltData, [&]()->bool {
+                const MSR_UNK_FIVR_CONTROL::FIVRWriteResult res = msrUnkFivrControl->setFIVRControl(data->undervoltData);
+
+                if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_CPU) && !res.cpu)
+                    errors.insert(PWTS::DError::W_CPU_UV);
 
-            if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_CPU) && !res.cpu)
-                errors.insert(PWTS::DError::W_CPU_UV);
+                if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_GPU) && !res.gpu)
+                    errors.insert(PWTS::DError::W_GPU_UV);
 
-            if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_GPU) && !res.gpu)
-                errors.insert(PWTS::DError::W_GPU_UV);
+                if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_CACHE) && !res.cpuCache)
+                    errors.insert(PWTS::DError::W_CACHE_UV);
 
-            if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_CACHE) && !res.cpuCache)
-                errors.insert(PWTS::DError::W_CACHE_UV);
+                if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_UNSLICE) && !res.unslice)
+                    errors.insert(PWTS::DError::W_UNSLICE_UV);
 
-            if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_UNSLICE) && !res.unslice)
-                errors.insert(PWTS::DError::W_UNSLICE_UV);
+                if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_SYSAGENT) && !res.sysAgent)
+                    errors.insert(PWTS::DError::W_SA_UV);
 
-            if (features.contains(PWTS::Feature::INTEL_UNDERVOLT_SYSAGENT) && !res.sysAgent)
-                errors.insert(PWTS::DError::W_SA_UV);
+                return errors.size() == errorCount;
+            });
+
+            if (data->undervoltData.isValid()) // don't save invalid data
+                fivr = data->undervoltData.getValue();
         }
 
-        if (hasTurboPowCurrentLimit && !msrTurboPowerCurrentLimit->setTurboPowerCurrentLimit(data->turboPowerCurrentLimit))
+        if (hasTurboPowCurrentLimit && !applyEngine->apply(PWTS::DError::W_TURBO_POWER_CURRENT_LIMIT, data->turboPowerCurrentLimit, [&]()->bool { return msrTurboPowerCurrentLimit->setTurboPowerCurrentLimit(data->turboPowerCurrentLimit); }))
             errors.insert(PWTS::DError::W_TURBO_POWER_CURRENT_LIMIT);
 
-        if (features.contains(PWTS::Feature::INTEL_PKG_POWER_LIMIT) && !msrPkgPowerLimit->setPkgPowerLimit(data->pkgPowerLimit, regsCache->raplPowerUnit))
+        if (features.contains(PWTS::Feature::INTEL_PKG_POWER_LIMIT) && !applyEngine->apply(PWTS::DError::W_PKG_POWER_LIMIT, data->pkgPowerLimit, [&]()->bool { return msrPkgPowerLimit->setPkgPowerLimit(data->pkgPowerLimit, regsCache->raplPowerUnit); }))
             errors.insert(PWTS::DError::W_PKG_POWER_LIMIT);
 
         if (features.contains(PWTS::Feature::INTEL_HWP_GROUP)) {
-            if (ia32PmEnable->getHWPEnableBit().getValue() == 0 && !ia32PmEnable->setHWPEnableBit(data->hwpEnable))
+            // write-once bit, only set while disabled
+            if (!applyEngine->apply(PWTS::DError::W_HWP_ENABLE, data->hwpEnable, [&]()->bool { return ia32PmEnable->getHWPEnableBit().getValue() != 0 || ia32PmEnable->setHWPEnableBit(data->hwpEnable); }))
                 errors.insert(PWTS::DError::W_HWP_ENABLE);
 
-            if (features.contains(PWTS::Feature::INTEL_HWP_REQ_PKG) && !ia32HWPRequestPkg->setHWPRequestPkg(data->hwpRequestPkg))
+            if (features.contains(PWTS::Feature::INTEL_HWP_REQ_PKG) && !applyEngine->apply(PWTS::DError::W_HWP_REQ_PKG, data->hwpRequestPkg, [&]()->bool { return ia32HWPRequestPkg->setHWPRequestPkg(data->hwpRequestPkg); }))
                 errors.insert(PWTS::DError::W_HWP_REQ_PKG);
 
-            if (features.contains(PWTS::Feature::INTEL_HWP_CTL) && !ia32HwpCtl->setHWPCtlBit(data->hwpPkgCtlPolarity))
+            if (features.contains(PWTS::Feature::INTEL_HWP_CTL) && !applyEngine->apply(PWTS::DError::W_HWP_CTL, data->hwpPkgCtlPolarity, [&]()->bool { return ia32HwpCtl->setHWPCtlBit(data->hwpPkgCtlPolarity); }))
                 errors.insert(PWTS::DError::W_HWP_CTL);
         }
-
-        msrDev->closeMsrFd(0);
     }
 
     void IntelCPU::applyCoreSettings(const int cpu, const int coreIdx, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const {
@@ -692,36 +627,36 @@ namespace PWTD::Intel {
 
         const PWTS::Intel::IntelCoreData &data = packet.intelData->coreData[cpu];
 
-        if (!msrDev->openMsrFd(coreIdx)) {
+        const MSRHandle msrHandle {msrDev, coreIdx};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QString("failed to open msr fd for cpu %1").arg(coreIdx));
 
             return;
         }
 
-        if (features.contains(PWTS::Feature::INTEL_PKG_CST_CONFIG_CONTROL) && !msrPkgCstConfigControl->setPkgCstConfigControlData(coreIdx, data.pkgCstConfigControl))
+        if (features.contains(PWTS::Feature::INTEL_PKG_CST_CONFIG_CONTROL) && !applyEngine->apply(PWTS::DError::W_PKG_CST_CONFIG_CONTROL, coreIdx, data.pkgCstConfigControl, [&]()->bool { return msrPkgCstConfigControl->setPkgCstConfigControlData(coreIdx, data.pkgCstConfigControl); }))
             errors.insert(PWTS::DError::W_PKG_CST_CONFIG_CONTROL);
-
-        msrDev->closeMsrFd(cpu);
     }
 
     void IntelCPU::applyThreadSettings(const int cpu, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const {
         if (!features.contains(PWTS::Feature::INTEL_CPU_GROUP))
             return;
 
-        if (!msrDev->openMsrFd(cpu)) {
+        const MSRHandle msrHandle {msrDev, cpu};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QString("failed to open msr fd for cpu %1").arg(cpu));
 
             return;
         }
 
-        const PWTS::Intel::IntelThreadData &data = packet.intelData->threadData[cpu];
+        const PWTS::Intel::IntelThreadData &data = packet.intelData->threadData.at(cpu); // const access, runs on the cpu workers
 
-        if (features.contains(PWTS::Feature::INTEL_HWP_GROUP) && !ia32HWPRequest->setHWPRequest(cpu, data.hwpRequest))
+        if (features.contains(PWTS::Feature::INTEL_HWP_GROUP) && !applyEngine->apply(PWTS::DError::W_HWP_REQ, cpu, data.hwpRequest, [&]()->bool { return ia32HWPRequest->setHWPRequest(cpu, data.hwpRequest); }))
             errors.insert(PWTS::DError::W_HWP_REQ);
-
-        msrDev->closeMsrFd(cpu);
     }
 
     QSet<PWTS::DError> IntelCPU::applySettings(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const {
@@ -761,8 +696,13 @@ namespace PWTD::Intel {
         for (int i=0,l=cpuInfo->numCores; i<l; ++i)
             applyCoreSettings(i, coreIdxList[i], features, packet, errors);
 
-        for (int i=0,l=cpuInfo->numLogicalCpus; i<l; ++i)
-            applyThreadSettings(i, features, packet, errors);
+        QList<QSet<PWTS::DError>> threadErrors(cpuInfo->numLogicalCpus);
+        QSet<PWTS::DError> *threadErrorsPtr = threadErrors.data();
+
+        workerPool->run(cpuInfo->numLogicalCpus, [&](const int cpu) { applyThreadSettings(cpu, features, packet, threadErrorsPtr[cpu]); });
+
+        for (const QSet<PWTS::DError> &errs: std::as_const(threadErrors))
+            errors.unite(errs);
 
         if (!mchbar.isNull())
             errors.unite(mchbar->applySettings(features, packet));
@@ -774,7 +714,9 @@ namespace PWTD::Intel {
         if (ia32PackageThermStatus.isNull() || msrTemperatureTarget.isNull())
             return {};
 
-        if (!msrDev->openMsrFd(0)) {
+        const MSRHandle msrHandle {msrDev, 0};
+
+        if (!msrHandle.isOpen()) {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QString("failed to open msr fd"));
 
@@ -783,11 +725,25 @@ namespace PWTD::Intel {
 
         const PWTS::ROData<PWTS::Intel::PkgThermalStatusInfo> pkgThermInfo = ia32PackageThermStatus->getPkgThermStatusData();
 
-        msrDev->closeMsrFd(0);
-
         if (!pkgThermInfo.isValid() || !regsCache->temperatureTarget.isValid())
             return {};
 
         return PWTS::ROData<int>(regsCache->temperatureTarget.getValue() - pkgThermInfo.getValue().digitalReadout, true);
     }
+
+    QMap<QString, int> IntelCPU::getPower(const QList<int> &coreIdxList) const {
+        if (!raplSampler.isAvailable())
+            return {};
+
+        const MSRHandle msrHandle {msrDev, 0};
+
+        if (!msrHandle.isOpen()) {
+            if (logger->isLevel(PWTS::LogLevel::Error))
+                logger->write(QString("failed to open msr fd"));
+
+            return {};
+        }
+
+        return raplSampler.sample();
+    }
 }
@@ -19,6 +19,7 @@
 
 #include "../CPUDevice.h"
 #include "MCHBAR/MCHBAR.h"
+#include "RAPL/RAPLSampler.h"
 
 namespace PWTD::Intel {
     class IntelCPU final: public CPUDevice {
@@ -31,6 +32,7 @@ namespace PWTD::Intel {
         mutable PWTS::Intel::FIVRControlUV fivr {0, 0, 0, 0, 0};
         mutable QScopedPointer<RegistersCache> regsCache;
         QScopedPointer<MCHBAR> mchbar;
+        mutable RAPLSampler raplSampler;
         QScopedPointer<IA32_ENERGY_PERF_BIAS> ia32EnergyPerfBias;
         QScopedPointer<IA32_MISC_ENABLE> ia32MiscEnable;
         QScopedPointer<IA32_PM_ENABLE> ia32PmEnable;
@@ -67,7 +69,7 @@ namespace PWTD::Intel {
         [[nodiscard]] bool hasHWPCtlBit() const;
         void fillPackageData(const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const;
         void fillCoreData(int cpu, const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const;
-        void fillThreadData(int cpu, const QSet<PWTS::Feature> &features, PWTS::DaemonPacket &packet) const;
+        void fillThreadData(int cpu, const QSet<PWTS::Feature> &features, PWTS::Intel::IntelThreadData &thdData, QSet<PWTS::DError> &errors) const;
         void applyPackageSettings(const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
         void applyCoreSettings(int cpu, int coreIdx, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
         void applyThreadSettings(int cpu, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
@@ -79,5 +81,6 @@ namespace PWTD::Intel {
         void fillDaemonPacket(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, PWTS::DaemonPacket &packet) const override;
         [[nodiscard]] QSet<PWTS::DError> applySettings(const QSet<PWTS::Feature> &features, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const override;
         [[nodiscard]] PWTS::ROData<int> getTemperature() const override;
+        [[nodiscard]] QMap<QString, int> getPower(const QList<int> &coreIdxList) const override;
     };
 }
@@ -24,6 +24,7 @@
 
 namespace PWTD::Intel {
     MCHBAR::MCHBAR(const int cpuFamily) {
+        applyEngine = ApplyEngine::getInstance();
         baseAddress = getMCHBARBaseAddress(cpuFamily);
     }
 
@@ -97,7 +98,7 @@ namespace PWTD::Intel {
         const QSharedPointer<PWTS::Intel::IntelData> data = packet.intelData;
         QSet<PWTS::DError> errors;
 
-        if (features.contains(PWTS::Feature::INTEL_MCHBAR_PKG_RAPL_LIMIT) && !mchbarPackageRaplLimit->setPkgRaplLimit(data->mchbarPkgRaplLimit, regsCache->pkgPowerSkuUnit))
+        if (features.contains(PWTS::Feature::INTEL_MCHBAR_PKG_RAPL_LIMIT) && !applyEngine->apply(PWTS::DError::W_POWER_LIMIT_MCHBAR, data->mchbarPkgRaplLimit, [&]()->bool { return mchbarPackageRaplLimit->setPkgRaplLimit(data->mchbarPkgRaplLimit, regsCache->pkgPowerSkuUnit); }))
             errors.insert(PWTS::DError::W_POWER_LIMIT_MCHBAR);
 
         return errors;
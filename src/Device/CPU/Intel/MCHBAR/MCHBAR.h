@@ -18,6 +18,7 @@
 #pragma once
 
 #include "../Include/RegistersIncludes.h"
+#include "../../../ApplyEngine.h"
 #include "pwtShared/Include/Feature.h"
 #include "pwtShared/Include/Packets/DaemonPacket.h"
 #include "pwtShared/Include/Packets/ClientPacket.h"
@@ -29,6 +30,7 @@ namespace PWTD::Intel {
             PWTS::ROData<MCHBAR_PACKAGE_POWER_SKU_UNIT::PkgPowerSKUUnits> pkgPowerSkuUnit;
         };
 
+        QSharedPointer<ApplyEngine> applyEngine;
         uint32_t baseAddress;
         mutable QScopedPointer<RegistersCache> regsCache;
         QScopedPointer<MCHBAR_PACKAGE_RAPL_LIMIT> mchbarPackageRaplLimit;
@@ -0,0 +1,69 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RAPLSampler.h"
+
+namespace PWTD::Intel {
+    // msr fd of cpu 0 must be open, domains the cpu does not implement fail to read and are left out
+    void RAPLSampler::init(const double energyUnit) {
+        static constexpr std::pair<const char *, uint32_t> knownDomains[] {
+            {"package", MSR_ENERGY_STATUS::PKG},
+            {"core", MSR_ENERGY_STATUS::PP0},
+            {"uncore", MSR_ENERGY_STATUS::PP1},
+            {"dram", MSR_ENERGY_STATUS::DRAM},
+            {"platform", MSR_ENERGY_STATUS::PLATFORM}
+        };
+
+        domains.clear();
+
+        for (const auto &[name, addr]: knownDomains) {
+            const QSharedPointer<MSR_ENERGY_STATUS> reg = QSharedPointer<MSR_ENERGY_STATUS>::create(addr);
+
+            if (!reg->getEnergyCounter().isValid())
+                continue;
+
+            Domain domain {.name = name, .reg = reg, .counter = {}};
+
+            domain.counter.setEnergyUnit(energyUnit);
+            domains.append(domain);
+        }
+
+        clock.start();
+    }
+
+    // msr fd of cpu 0 must be open, milliwatts by domain, empty on the first sample
+    QMap<QString, int> RAPLSampler::sample() {
+        const qint64 nsecs = clock.nsecsElapsed();
+        QMap<QString, int> power;
+
+        for (Domain &domain: domains) {
+            const PWTS::ROData<uint32_t> count = domain.reg->getEnergyCounter();
+
+            if (!count.isValid()) {
+                domain.counter.reset();
+                continue;
+            }
+
+            const PWTS::ROData<int> mw = domain.counter.update(count.getValue(), nsecs);
+
+            if (mw.isValid())
+                power.insert(domain.name, mw.getValue());
+        }
+
+        return power;
+    }
+}
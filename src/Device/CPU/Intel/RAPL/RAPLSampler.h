@@ -0,0 +1,44 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QElapsedTimer>
+#include <QMap>
+
+#include "../Registers/MSR_ENERGY_STATUS.h"
+#include "../../Utils/EnergyCounter.h"
+
+namespace PWTD::Intel {
+    // per domain power from the rapl energy status counters, averaged between two samples
+    class RAPLSampler final {
+    private:
+        struct Domain final {
+            QString name;
+            QSharedPointer<MSR_ENERGY_STATUS> reg;
+            EnergyCounter counter;
+        };
+
+        QList<Domain> domains;
+        QElapsedTimer clock;
+
+    public:
+        void init(double energyUnit);
+        [[nodiscard]] bool isAvailable() const { return !domains.isEmpty(); }
+        [[nodiscard]] QMap<QString, int> sample();
+    };
+}
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/Intel/HWPCapabilities.h"
@@ -35,22 +33,11 @@ namespace PWTD::Intel {
             // 63:32 reserved:32
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, ia32HWPCapabilities &regVal) const {
-            try {
-                regVal.highestPerformance = getBitfield(7, 0, raw);
-                regVal.guaranteedPerformance = getBitfield(15, 8, raw);
-                regVal.mostEfficientPerformance = getBitfield(23, 16, raw);
-                regVal.lowestPerformance = getBitfield(31, 24, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, ia32HWPCapabilities &regVal) {
+            regVal.highestPerformance = getBitfield<7, 0>(raw);
+            regVal.guaranteedPerformance = getBitfield<15, 8>(raw);
+            regVal.mostEfficientPerformance = getBitfield<23, 16>(raw);
+            regVal.lowestPerformance = getBitfield<31, 24>(raw);
         }
 
     public:
@@ -62,9 +49,11 @@ namespace PWTD::Intel {
             ia32HWPCapabilities regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, cpu))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::ROData<PWTS::Intel::HWPCapabilities>({
                 .lowestPerf = static_cast<int>(regVal.lowestPerformance),
                 .highestPerf = static_cast<int>(regVal.highestPerformance)
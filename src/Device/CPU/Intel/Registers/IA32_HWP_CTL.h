@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/Types/RWData.h"
@@ -31,34 +29,12 @@ namespace PWTD::Intel {
             // 63:1 reserved:63
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, ia32HwpCtl &regVal) const {
-            try {
-                regVal.pkgCtlPolarity = getBitfield(0, 0, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, ia32HwpCtl &regVal) {
+            regVal.pkgCtlPolarity = getBitfield<0, 0>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const ia32HwpCtl &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(0, 0, regVal.pkgCtlPolarity, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const ia32HwpCtl &regVal, uint64_t &raw) {
+            setBitfield<0, 0>(regVal.pkgCtlPolarity, raw);
         }
 
     public:
@@ -70,9 +46,11 @@ namespace PWTD::Intel {
             ia32HwpCtl regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<int>(static_cast<int>(regVal.pkgCtlPolarity), true);
         }
 
@@ -86,7 +64,12 @@ namespace PWTD::Intel {
 
             regVal.pkgCtlPolarity = data.getValue();
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
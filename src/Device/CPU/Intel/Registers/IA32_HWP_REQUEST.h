@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "../Utils/IntelRegisterUtils.h"
@@ -28,6 +26,7 @@
 namespace PWTD::Intel {
     class IA32_HWP_REQUEST final: public CPURegister {
     private:
+        static constexpr uint64_t writeMask = getBitfieldMask<42, 0>() | getBitfieldMask<63, 59>();
         struct ia32HWPRequest final {
             uint64_t minimumPerformance :8; // 7:0
             uint64_t maximumPeformance :8; // 15:8
@@ -44,56 +43,34 @@ namespace PWTD::Intel {
             uint64_t minimumValid :1; // 63
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, ia32HWPRequest &regVal) const {
-            try {
-                regVal.minimumPerformance = getBitfield(7, 0, raw);
-                regVal.maximumPeformance = getBitfield(15, 8, raw);
-                regVal.desiredPerformance = getBitfield(23, 16, raw);
-                regVal.energyPerformancePreference = getBitfield(31, 24, raw);
-                regVal.activityWindowMantissa = getBitfield(38, 32, raw);
-                regVal.activityWindowExponent = getBitfield(41, 39, raw);
-                regVal.packageControl = getBitfield(42, 42, raw);
-                regVal.activityWindowValid = getBitfield(59, 59, raw);
-                regVal.eppValid = getBitfield(60, 60, raw);
-                regVal.desiredValid = getBitfield(61, 61, raw);
-                regVal.maximumValid = getBitfield(62, 62, raw);
-                regVal.minimumValid = getBitfield(63, 63, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, ia32HWPRequest &regVal) {
+            regVal.minimumPerformance = getBitfield<7, 0>(raw);
+            regVal.maximumPeformance = getBitfield<15, 8>(raw);
+            regVal.desiredPerformance = getBitfield<23, 16>(raw);
+            regVal.energyPerformancePreference = getBitfield<31, 24>(raw);
+            regVal.activityWindowMantissa = getBitfield<38, 32>(raw);
+            regVal.activityWindowExponent = getBitfield<41, 39>(raw);
+            regVal.packageControl = getBitfield<42, 42>(raw);
+            regVal.activityWindowValid = getBitfield<59, 59>(raw);
+            regVal.eppValid = getBitfield<60, 60>(raw);
+            regVal.desiredValid = getBitfield<61, 61>(raw);
+            regVal.maximumValid = getBitfield<62, 62>(raw);
+            regVal.minimumValid = getBitfield<63, 63>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const ia32HWPRequest &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(7, 0, regVal.minimumPerformance, raw);
-                setBitfield(15, 8, regVal.maximumPeformance, raw);
-                setBitfield(23, 16, regVal.desiredPerformance, raw);
-                setBitfield(31, 24, regVal.energyPerformancePreference, raw);
-                setBitfield(38, 32, regVal.activityWindowMantissa, raw);
-                setBitfield(41, 39, regVal.activityWindowExponent, raw);
-                setBitfield(42, 42, regVal.packageControl, raw);
-                setBitfield(59, 59, regVal.activityWindowValid, raw);
-                setBitfield(60, 60, regVal.eppValid, raw);
-                setBitfield(61, 61, regVal.desiredValid, raw);
-                setBitfield(62, 62, regVal.maximumValid, raw);
-                setBitfield(63, 63, regVal.minimumValid, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const ia32HWPRequest &regVal, uint64_t &raw) {
+            setBitfield<7, 0>(regVal.minimumPerformance, raw);
+            setBitfield<15, 8>(regVal.maximumPeformance, raw);
+            setBitfield<23, 16>(regVal.desiredPerformance, raw);
+            setBitfield<31, 24>(regVal.energyPerformancePreference, raw);
+            setBitfield<38, 32>(regVal.activityWindowMantissa, raw);
+            setBitfield<41, 39>(regVal.activityWindowExponent, raw);
+            setBitfield<42, 42>(regVal.packageControl, raw);
+            setBitfield<59, 59>(regVal.activityWindowValid, raw);
+            setBitfield<60, 60>(regVal.eppValid, raw);
+            setBitfield<61, 61>(regVal.desiredValid, raw);
+            setBitfield<62, 62>(regVal.maximumValid, raw);
+            setBitfield<63, 63>(regVal.minimumValid, raw);
         }
 
     public:
@@ -105,9 +82,11 @@ namespace PWTD::Intel {
             ia32HWPRequest regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, cpu))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::HWPRequest>({
                 .requestPkg = {
                     .min = static_cast<int>(regVal.minimumPerformance),
@@ -126,14 +105,14 @@ namespace PWTD::Intel {
         }
 
         [[nodiscard]]
-        bool setHWPRequest(const int cpu, const PWTS::RWData<PWTS::Intel::HWPRequest> &data) const {
+        bool submitHWPRequest(MSRBatch &batch, const int cpu, const PWTS::RWData<PWTS::Intel::HWPRequest> &data) const {
             if (!data.isValid() || data.isIgnored())
                 return true;
 
             const PWTS::Intel::HWPRequest hwpReq = data.getValue();
             const HWPActivityWindowBits acwBits = getHWPActivityWindowBitsFromMicroSecond(hwpReq.requestPkg.acw);
             ia32HWPRequest regVal {};
-            uint64_t raw = 0, cur = 0;
+            uint64_t raw = 0;
 
             regVal.minimumPerformance = hwpReq.requestPkg.min;
             regVal.maximumPeformance = hwpReq.requestPkg.max;
@@ -148,10 +127,17 @@ namespace PWTD::Intel {
             regVal.eppValid = hwpReq.eppValid;
             regVal.activityWindowValid = hwpReq.acwValid;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
-                return false;
+            setRawValue(regVal, raw);
+
+            batch.modify(cpu, addr, writeMask, raw, true);
+            return true;
+        }
+
+        [[nodiscard]]
+        bool setHWPRequest(const int cpu, const PWTS::RWData<PWTS::Intel::HWPRequest> &data) const {
+            MSRBatch batch;
 
-            return cur == raw;
+            return submitHWPRequest(batch, cpu, data) && msrUtils->runBatch(batch);
         }
     };
 }
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../Utils/IntelRegisterUtils.h"
 #include "../../Utils/CPUUtils.h"
@@ -38,44 +36,22 @@ namespace PWTD::Intel {
             // 63:42 reserved:22
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, ia32HWPRequestPkg &regVal) const {
-            try {
-                regVal.minimumPerformance = getBitfield(7, 0, raw);
-                regVal.maximumPerformance = getBitfield(15, 8, raw);
-                regVal.desiredPerformance = getBitfield(23, 16, raw);
-                regVal.energyPerformancePreference = getBitfield(31, 24, raw);
-                regVal.activityWindowMantissa = getBitfield(38, 32, raw);
-                regVal.activityWindowExponent = getBitfield(41, 39, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, ia32HWPRequestPkg &regVal) {
+            regVal.minimumPerformance = getBitfield<7, 0>(raw);
+            regVal.maximumPerformance = getBitfield<15, 8>(raw);
+            regVal.desiredPerformance = getBitfield<23, 16>(raw);
+            regVal.energyPerformancePreference = getBitfield<31, 24>(raw);
+            regVal.activityWindowMantissa = getBitfield<38, 32>(raw);
+            regVal.activityWindowExponent = getBitfield<41, 39>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const ia32HWPRequestPkg &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(7, 0, regVal.minimumPerformance, raw);
-                setBitfield(15, 8, regVal.maximumPerformance, raw);
-                setBitfield(23, 16, regVal.desiredPerformance, raw);
-                setBitfield(31, 24, regVal.energyPerformancePreference, raw);
-                setBitfield(38, 32, regVal.activityWindowMantissa, raw);
-                setBitfield(41, 39, regVal.activityWindowExponent, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const ia32HWPRequestPkg &regVal, uint64_t &raw) {
+            setBitfield<7, 0>(regVal.minimumPerformance, raw);
+            setBitfield<15, 8>(regVal.maximumPerformance, raw);
+            setBitfield<23, 16>(regVal.desiredPerformance, raw);
+            setBitfield<31, 24>(regVal.energyPerformancePreference, raw);
+            setBitfield<38, 32>(regVal.activityWindowMantissa, raw);
+            setBitfield<41, 39>(regVal.activityWindowExponent, raw);
         }
 
     public:
@@ -87,9 +63,11 @@ namespace PWTD::Intel {
             ia32HWPRequestPkg regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::HWPRequestPkg>({
                 .min = static_cast<int>(regVal.minimumPerformance),
                 .max = static_cast<int>(regVal.maximumPerformance),
@@ -116,7 +94,12 @@ namespace PWTD::Intel {
             regVal.activityWindowMantissa = acwBits.mantissa;
             regVal.activityWindowExponent = acwBits.exponent;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/Intel/MiscProcFeatures.h"
@@ -48,44 +46,22 @@ namespace PWTD::Intel {
             // 63:39 reserved:25
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, ia32MiscEnable &regVal) const {
-            try {
-                regVal.fastStringsEnable = getBitfield(0, 0, raw);
-                regVal.performanceMonitoringAvailable = getBitfield(7, 7, raw);
-                regVal.branchTraceStorageUnavailable = getBitfield(11, 11, raw);
-                regVal.processorEventBasedSampling = getBitfield(12, 12, raw);
-                regVal.enhancedIntelSpeedStepTechnology = getBitfield(16, 16, raw);
-                regVal.enableMonitorFsm = getBitfield(18, 18, raw);
-                regVal.limitCpuidMaxVal = getBitfield(22, 22, raw);
-                regVal.xtrpMessageDisable = getBitfield(23, 23, raw);
-                regVal.xdBitDisable = getBitfield(34, 34, raw);
-                regVal.turboModeDisable = getBitfield(38, 38, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, ia32MiscEnable &regVal) {
+            regVal.fastStringsEnable = getBitfield<0, 0>(raw);
+            regVal.performanceMonitoringAvailable = getBitfield<7, 7>(raw);
+            regVal.branchTraceStorageUnavailable = getBitfield<11, 11>(raw);
+            regVal.processorEventBasedSampling = getBitfield<12, 12>(raw);
+            regVal.enhancedIntelSpeedStepTechnology = getBitfield<16, 16>(raw);
+            regVal.enableMonitorFsm = getBitfield<18, 18>(raw);
+            regVal.limitCpuidMaxVal = getBitfield<22, 22>(raw);
+            regVal.xtrpMessageDisable = getBitfield<23, 23>(raw);
+            regVal.xdBitDisable = getBitfield<34, 34>(raw);
+            regVal.turboModeDisable = getBitfield<38, 38>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const ia32MiscEnable &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(16, 16, regVal.enhancedIntelSpeedStepTechnology, raw);
-                setBitfield(38, 38, regVal.turboModeDisable, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const ia32MiscEnable &regVal, uint64_t &raw) {
+            setBitfield<16, 16>(regVal.enhancedIntelSpeedStepTechnology, raw);
+            setBitfield<38, 38>(regVal.turboModeDisable, raw);
         }
 
     public:
@@ -97,9 +73,11 @@ namespace PWTD::Intel {
             ia32MiscEnable regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::MiscProcFeatures>({
                 .enhancedSpeedStep = regVal.enhancedIntelSpeedStepTechnology == 1,
                 .disableTurboMode = regVal.turboModeDisable == 1
@@ -118,7 +96,12 @@ namespace PWTD::Intel {
             regVal.enhancedIntelSpeedStepTechnology = miscFeat.enhancedSpeedStep;
             regVal.turboModeDisable = miscFeat.disableTurboMode;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/Intel/PkgThermalStatusInfo.h"
@@ -47,19 +45,8 @@ namespace PWTD::Intel {
             // 63:27 reserved:37
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, ia32PkgThermStatus &regVal) const {
-            try {
-                regVal.pkgDigitalReadout = getBitfield(22, 16, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, ia32PkgThermStatus &regVal) {
+            regVal.pkgDigitalReadout = getBitfield<22, 16>(raw);
         }
 
     public:
@@ -71,9 +58,11 @@ namespace PWTD::Intel {
             ia32PkgThermStatus regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::ROData<PWTS::Intel::PkgThermalStatusInfo>({
                 .digitalReadout = static_cast<int>(regVal.pkgDigitalReadout)
             }, true);
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../MCHBAR/MCHBARRegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/Types/ROData.h"
@@ -35,21 +33,10 @@ namespace PWTD::Intel {
             // 31:20 reserved:12
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint32_t raw, packagePowerSkuUnit &regVal) const {
-            try {
-                regVal.powerUnit = getBitfield(3, 0, raw);
-                regVal.energyUnit = getBitfield(12, 8, raw);
-                regVal.timeUnit = getBitfield(19, 16, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint32_t raw, packagePowerSkuUnit &regVal) {
+            regVal.powerUnit = getBitfield<3, 0>(raw);
+            regVal.energyUnit = getBitfield<12, 8>(raw);
+            regVal.timeUnit = getBitfield<19, 16>(raw);
         }
 
     public:
@@ -64,9 +51,11 @@ namespace PWTD::Intel {
             packagePowerSkuUnit regVal {};
             uint64_t raw = 0;
 
-            if (!memory->readMem32(raw, addr) || !setBitfields(raw, regVal))
+            if (!memory->readMem32(raw, addr))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::ROData<PkgPowerSKUUnits>({
                 .powerUnit = 1 / qPow(2, regVal.powerUnit),
                 .timeUnit = 1 / qPow(2, regVal.timeUnit)
@@ -36,46 +36,24 @@ namespace PWTD::Intel {
             uint64_t lock :1; // 63
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, packageRaplLimit &regVal) const {
-            try {
-                regVal.packagePowerLimit1 = getBitfield(14, 0, raw);
-                regVal.packagePowerLimit1Enable = getBitfield(15, 15, raw);
-                regVal.packageLimitation1TimeWindowY = getBitfield(21, 17, raw);
-                regVal.packageLimitation1TimeWindowX = getBitfield(23, 22, raw);
-                regVal.packagePowerLimit2 = getBitfield(46, 32, raw);
-                regVal.packagePowerLimit2Enable = getBitfield(47, 47, raw);
-                regVal.lock = getBitfield(63, 63, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, packageRaplLimit &regVal) {
+            regVal.packagePowerLimit1 = getBitfield<14, 0>(raw);
+            regVal.packagePowerLimit1Enable = getBitfield<15, 15>(raw);
+            regVal.packageLimitation1TimeWindowY = getBitfield<21, 17>(raw);
+            regVal.packageLimitation1TimeWindowX = getBitfield<23, 22>(raw);
+            regVal.packagePowerLimit2 = getBitfield<46, 32>(raw);
+            regVal.packagePowerLimit2Enable = getBitfield<47, 47>(raw);
+            regVal.lock = getBitfield<63, 63>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const packageRaplLimit &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(14, 0, regVal.packagePowerLimit1, raw);
-                setBitfield(15, 15, regVal.packagePowerLimit1Enable, raw);
-                setBitfield(21, 17, regVal.packageLimitation1TimeWindowY, raw);
-                setBitfield(23, 22, regVal.packageLimitation1TimeWindowX, raw);
-                setBitfield(46, 32, regVal.packagePowerLimit2, raw);
-                setBitfield(47, 47, regVal.packagePowerLimit2Enable, raw);
-                setBitfield(63, 63, regVal.lock, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const packageRaplLimit &regVal, uint64_t &raw) {
+            setBitfield<14, 0>(regVal.packagePowerLimit1, raw);
+            setBitfield<15, 15>(regVal.packagePowerLimit1Enable, raw);
+            setBitfield<21, 17>(regVal.packageLimitation1TimeWindowY, raw);
+            setBitfield<23, 22>(regVal.packageLimitation1TimeWindowX, raw);
+            setBitfield<46, 32>(regVal.packagePowerLimit2, raw);
+            setBitfield<47, 47>(regVal.packagePowerLimit2Enable, raw);
+            setBitfield<63, 63>(regVal.lock, raw);
         }
 
     public:
@@ -86,9 +64,11 @@ namespace PWTD::Intel {
             packageRaplLimit regVal {};
             uint64_t raw = 0;
 
-            if (!powerSkuUnit.isValid() || !memory->readMem64(raw, addr) || !setBitfields(raw, regVal))
+            if (!powerSkuUnit.isValid() || !memory->readMem64(raw, addr))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::MCHBARPkgRaplLimit>({
                 .pl1 = static_cast<int>(regVal.packagePowerLimit1 * skuUnit.powerUnit * 1000),
                 .pl2 = static_cast<int>(regVal.packagePowerLimit2 * skuUnit.powerUnit * 1000),
@@ -125,7 +105,9 @@ namespace PWTD::Intel {
                 regVal.packageLimitation1TimeWindowX = timeWindow.z;
             }
 
-            if (!setRawValue(regVal, raw) || !memory->writeMem64(raw, addr) || !memory->readMem64(cur, addr))
+            setRawValue(regVal, raw);
+
+            if (!memory->writeMem64(raw, addr) || !memory->readMem64(cur, addr))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../MCHBAR/MCHBARRegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/Types/ROData.h"
@@ -34,20 +32,9 @@ namespace PWTD::Intel {
             // 31:24 reserved:7
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint32_t raw, rpStateCap &regVal) const {
-            try {
-                regVal.rp0Capability = getBitfield(8, 0, raw);
-                regVal.pnCapability = getBitfield(24, 16, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint32_t raw, rpStateCap &regVal) {
+            regVal.rp0Capability = getBitfield<8, 0>(raw);
+            regVal.pnCapability = getBitfield<24, 16>(raw);
         }
 
     public:
@@ -57,9 +44,11 @@ namespace PWTD::Intel {
             rpStateCap regVal {};
             uint64_t raw = 0;
 
-            if (!memory->readMem32(raw, addr) || !setBitfields(raw, regVal))
+            if (!memory->readMem32(raw, addr))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::ROData<PWTS::Intel::MCHBARRPStateCap>({
                 .rp0 = static_cast<int>(regVal.rp0Capability),
                 .pn = static_cast<int>(regVal.pnCapability)
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_MISC_PWR_MGMT.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -31,34 +29,12 @@ namespace PWTD::Intel {
             // 63:2 reserved:62
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, miscPwrMgmt &regVal) const {
-            try {
-                regVal.eistHardwareCoordinationDisable = getBitfield(0, 0, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, miscPwrMgmt &regVal) {
+            regVal.eistHardwareCoordinationDisable = getBitfield<0, 0>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const miscPwrMgmt &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(0, 0, regVal.eistHardwareCoordinationDisable, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const miscPwrMgmt &regVal, uint64_t &raw) {
+            setBitfield<0, 0>(regVal.eistHardwareCoordinationDisable, raw);
         }
 
     public:
@@ -66,9 +42,11 @@ namespace PWTD::Intel {
             miscPwrMgmt regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::MiscPwrMgmt>({
                 .eistHWCoordinationDisable = regVal.eistHardwareCoordinationDisable == 1,
             }, true);
@@ -84,7 +62,12 @@ namespace PWTD::Intel {
 
             regVal.eistHardwareCoordinationDisable = data.getValue().eistHWCoordinationDisable;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_PKG_CST_CONFIG_CONTROL.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -43,54 +41,32 @@ namespace PWTD::Intel {
             // 63:32 reserved:32
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, pkgCstConfigControl &regVal) const {
-            try {
-                regVal.packageCStateLimit = getBitfield(3, 0, raw);
-                regVal.maxCoreCstate = getBitfield(7, 4, raw);
-                regVal.ioMwaitRedirectionEnable = getBitfield(10, 10, raw);
-                regVal.cfgLock = getBitfield(15, 15, raw);
-                regVal.c3StateAutodemotionEnable = getBitfield(25, 25, raw);
-                regVal.c1StateAutodemotionEnable = getBitfield(26, 26, raw);
-                regVal.c3UndemotionEnable = getBitfield(27, 27, raw);
-                regVal.c1UndemotionEnable = getBitfield(28, 28, raw);
-                regVal.pkgcAutodemotionEnable = getBitfield(29, 29, raw);
-                regVal.pkgcUndemotionEnable = getBitfield(30, 30, raw);
-                regVal.timedMwaitEnable = getBitfield(31, 31, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, pkgCstConfigControl &regVal) {
+            regVal.packageCStateLimit = getBitfield<3, 0>(raw);
+            regVal.maxCoreCstate = getBitfield<7, 4>(raw);
+            regVal.ioMwaitRedirectionEnable = getBitfield<10, 10>(raw);
+            regVal.cfgLock = getBitfield<15, 15>(raw);
+            regVal.c3StateAutodemotionEnable = getBitfield<25, 25>(raw);
+            regVal.c1StateAutodemotionEnable = getBitfield<26, 26>(raw);
+            regVal.c3UndemotionEnable = getBitfield<27, 27>(raw);
+            regVal.c1UndemotionEnable = getBitfield<28, 28>(raw);
+            regVal.pkgcAutodemotionEnable = getBitfield<29, 29>(raw);
+            regVal.pkgcUndemotionEnable = getBitfield<30, 30>(raw);
+            regVal.timedMwaitEnable = getBitfield<31, 31>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const pkgCstConfigControl &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(3, 0, regVal.packageCStateLimit, raw);
-                setBitfield(7, 4, regVal.maxCoreCstate, raw);
-                setBitfield(10, 10, regVal.ioMwaitRedirectionEnable, raw);
-                setBitfield(15, 15, regVal.cfgLock, raw);
-                setBitfield(25, 25, regVal.c3StateAutodemotionEnable, raw);
-                setBitfield(26, 26, regVal.c1StateAutodemotionEnable, raw);
-                setBitfield(27, 27, regVal.c3UndemotionEnable, raw);
-                setBitfield(28, 28, regVal.c1UndemotionEnable, raw);
-                setBitfield(29, 29, regVal.pkgcAutodemotionEnable, raw);
-                setBitfield(30, 30, regVal.pkgcUndemotionEnable, raw);
-                setBitfield(31, 31, regVal.timedMwaitEnable, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const pkgCstConfigControl &regVal, uint64_t &raw) {
+            setBitfield<3, 0>(regVal.packageCStateLimit, raw);
+            setBitfield<7, 4>(regVal.maxCoreCstate, raw);
+            setBitfield<10, 10>(regVal.ioMwaitRedirectionEnable, raw);
+            setBitfield<15, 15>(regVal.cfgLock, raw);
+            setBitfield<25, 25>(regVal.c3StateAutodemotionEnable, raw);
+            setBitfield<26, 26>(regVal.c1StateAutodemotionEnable, raw);
+            setBitfield<27, 27>(regVal.c3UndemotionEnable, raw);
+            setBitfield<28, 28>(regVal.c1UndemotionEnable, raw);
+            setBitfield<29, 29>(regVal.pkgcAutodemotionEnable, raw);
+            setBitfield<30, 30>(regVal.pkgcUndemotionEnable, raw);
+            setBitfield<31, 31>(regVal.timedMwaitEnable, raw);
         }
 
     public:
@@ -98,9 +74,11 @@ namespace PWTD::Intel {
             pkgCstConfigControl regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, cpu))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::PkgCstConfigControl>({
                 .packageCStateLimit = static_cast<short>(regVal.packageCStateLimit),
                 .maxCoreCState = static_cast<short>(regVal.maxCoreCstate),
@@ -137,7 +115,12 @@ namespace PWTD::Intel {
             regVal.pkgcUndemotionEnable = pkgCstCfgCtrl.pkgcUndemotionEnable;
             regVal.timedMwaitEnable = pkgCstCfgCtrl.timedMwaitEnable;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
+            if (!msrUtils->readMSR(raw, addr, cpu))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_PKG_CST_CONFIG_CONTROL.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -39,46 +37,24 @@ namespace PWTD::Intel {
             // 63:29 reserved:35
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, pkgCstConfigControl &regVal) const {
-            try {
-                regVal.packageCStateLimit = getBitfield(2, 0, raw);
-                regVal.ioMwaitRedirectionEnable = getBitfield(10, 10, raw);
-                regVal.cfgLock = getBitfield(15, 15, raw);
-                regVal.c3StateAutodemotionEnable = getBitfield(25, 25, raw);
-                regVal.c1StateAutodemotionEnable = getBitfield(26, 26, raw);
-                regVal.c3UndemotionEnable = getBitfield(27, 27, raw);
-                regVal.c1UndemotionEnable = getBitfield(28, 28, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, pkgCstConfigControl &regVal) {
+            regVal.packageCStateLimit = getBitfield<2, 0>(raw);
+            regVal.ioMwaitRedirectionEnable = getBitfield<10, 10>(raw);
+            regVal.cfgLock = getBitfield<15, 15>(raw);
+            regVal.c3StateAutodemotionEnable = getBitfield<25, 25>(raw);
+            regVal.c1StateAutodemotionEnable = getBitfield<26, 26>(raw);
+            regVal.c3UndemotionEnable = getBitfield<27, 27>(raw);
+            regVal.c1UndemotionEnable = getBitfield<28, 28>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const pkgCstConfigControl &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(2, 0, regVal.packageCStateLimit, raw);
-                setBitfield(10, 10, regVal.ioMwaitRedirectionEnable, raw);
-                setBitfield(15, 15, regVal.cfgLock, raw);
-                setBitfield(25, 25, regVal.c3StateAutodemotionEnable, raw);
-                setBitfield(26, 26, regVal.c1StateAutodemotionEnable, raw);
-                setBitfield(27, 27, regVal.c3UndemotionEnable, raw);
-                setBitfield(28, 28, regVal.c1UndemotionEnable, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const pkgCstConfigControl &regVal, uint64_t &raw) {
+            setBitfield<2, 0>(regVal.packageCStateLimit, raw);
+            setBitfield<10, 10>(regVal.ioMwaitRedirectionEnable, raw);
+            setBitfield<15, 15>(regVal.cfgLock, raw);
+            setBitfield<25, 25>(regVal.c3StateAutodemotionEnable, raw);
+            setBitfield<26, 26>(regVal.c1StateAutodemotionEnable, raw);
+            setBitfield<27, 27>(regVal.c3UndemotionEnable, raw);
+            setBitfield<28, 28>(regVal.c1UndemotionEnable, raw);
         }
 
     public:
@@ -86,9 +62,11 @@ namespace PWTD::Intel {
             pkgCstConfigControl regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, cpu))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::PkgCstConfigControl>({
                 .packageCStateLimit = static_cast<short>(regVal.packageCStateLimit),
                 .ioMwaitRedirectionEnable = regVal.ioMwaitRedirectionEnable == 1,
@@ -117,7 +95,12 @@ namespace PWTD::Intel {
             regVal.c3UndemotionEnable = pkgCstCfgCtrl.c3UndemotionEnable;
             regVal.c1UndemotionEnable = pkgCstCfgCtrl.c1UndemotionEnable;
 
-            if (!msrUtils->readMSR(raw, addr, cpu) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
+            if (!msrUtils->readMSR(raw, addr, cpu))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, cpu) || !msrUtils->readMSR(cur, addr, cpu))
                 return false;
 
             return cur == raw;
@@ -25,6 +25,7 @@
 namespace PWTD::Intel {
     class MSR_PKG_POWER_LIMIT final: public CPURegister {
     private:
+        static constexpr uint64_t writeMask = getBitfieldMask<23, 0>() | getBitfieldMask<55, 32>() | getBitfieldMask<63, 63>();
         struct pkgPowerLimit final {
             uint64_t pl1 :15; // 14:0
             uint64_t pl1Enable :1; // 15
@@ -41,54 +42,32 @@ namespace PWTD::Intel {
             uint64_t lock :1; // 63
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, pkgPowerLimit &regVal) const {
-            try {
-                regVal.pl1 = getBitfield(14, 0, raw);
-                regVal.pl1Enable = getBitfield(15, 15, raw);
-                regVal.pl1Clamp = getBitfield(16, 16, raw);
-                regVal.pl1TimeY = getBitfield(21, 17, raw);
-                regVal.pl1TimeZ = getBitfield(23, 22, raw);
-                regVal.pl2 = getBitfield(46, 32, raw);
-                regVal.pl2Enable = getBitfield(47, 47, raw);
-                regVal.pl2Clamp = getBitfield(48, 48, raw);
-                regVal.pl2TimeY = getBitfield(53, 49, raw);
-                regVal.pl2TimeZ = getBitfield(55, 54, raw);
-                regVal.lock = getBitfield(63, 63, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, pkgPowerLimit &regVal) {
+            regVal.pl1 = getBitfield<14, 0>(raw);
+            regVal.pl1Enable = getBitfield<15, 15>(raw);
+            regVal.pl1Clamp = getBitfield<16, 16>(raw);
+            regVal.pl1TimeY = getBitfield<21, 17>(raw);
+            regVal.pl1TimeZ = getBitfield<23, 22>(raw);
+            regVal.pl2 = getBitfield<46, 32>(raw);
+            regVal.pl2Enable = getBitfield<47, 47>(raw);
+            regVal.pl2Clamp = getBitfield<48, 48>(raw);
+            regVal.pl2TimeY = getBitfield<53, 49>(raw);
+            regVal.pl2TimeZ = getBitfield<55, 54>(raw);
+            regVal.lock = getBitfield<63, 63>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const pkgPowerLimit &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(14, 0, regVal.pl1, raw);
-                setBitfield(15, 15, regVal.pl1Enable, raw);
-                setBitfield(16, 16, regVal.pl1Clamp, raw);
-                setBitfield(21, 17, regVal.pl1TimeY, raw);
-                setBitfield(23, 22, regVal.pl1TimeZ, raw);
-                setBitfield(46, 32, regVal.pl2, raw);
-                setBitfield(47, 47, regVal.pl2Enable, raw);
-                setBitfield(48, 48, regVal.pl2Clamp, raw);
-                setBitfield(53, 49, regVal.pl2TimeY, raw);
-                setBitfield(55, 54, regVal.pl2TimeZ, raw);
-                setBitfield(63, 63, regVal.lock, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const pkgPowerLimit &regVal, uint64_t &raw) {
+            setBitfield<14, 0>(regVal.pl1, raw);
+            setBitfield<15, 15>(regVal.pl1Enable, raw);
+            setBitfield<16, 16>(regVal.pl1Clamp, raw);
+            setBitfield<21, 17>(regVal.pl1TimeY, raw);
+            setBitfield<23, 22>(regVal.pl1TimeZ, raw);
+            setBitfield<46, 32>(regVal.pl2, raw);
+            setBitfield<47, 47>(regVal.pl2Enable, raw);
+            setBitfield<48, 48>(regVal.pl2Clamp, raw);
+            setBitfield<53, 49>(regVal.pl2TimeY, raw);
+            setBitfield<55, 54>(regVal.pl2TimeZ, raw);
+            setBitfield<63, 63>(regVal.lock, raw);
         }
 
     public:
@@ -101,9 +80,11 @@ namespace PWTD::Intel {
             pkgPowerLimit regVal {};
             uint64_t raw = 0;
 
-            if (!powerUnits.isValid() || !msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!powerUnits.isValid() || !msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::PkgPowerLimit>({
                 .pl1 = static_cast<int>(regVal.pl1 * raplUnit.powerUnit * 1000),
                 .pl2 = static_cast<int>(regVal.pl2 * raplUnit.powerUnit * 1000),
@@ -118,7 +99,7 @@ namespace PWTD::Intel {
         }
 
         [[nodiscard]]
-        bool setPkgPowerLimit(const PWTS::RWData<PWTS::Intel::PkgPowerLimit> &data, const PWTS::ROData<MSR_RAPL_POWER_UNIT::RAPLPowerUnits> &powerUnits) const {
+        bool submitPkgPowerLimit(MSRBatch &batch, const PWTS::RWData<PWTS::Intel::PkgPowerLimit> &data, const PWTS::ROData<MSR_RAPL_POWER_UNIT::RAPLPowerUnits> &powerUnits) const {
             if (!data.isValid())
                 return true;
 
@@ -126,9 +107,9 @@ namespace PWTD::Intel {
             const PWTS::Intel::PkgPowerLimit pkgPowerLim = data.getValue();
             PowerLimitRawTimeWindow timeWindow;
             pkgPowerLimit regVal {};
-            uint64_t raw = 0, cur = 0;
+            uint64_t raw = 0;
 
-            if (!powerUnits.isValid() || !msrUtils->readMSR(raw, addr, 0))
+            if (!powerUnits.isValid())
                 return false;
 
             regVal.pl1 = static_cast<uint64_t>(pkgPowerLim.pl1 / powUnits.powerUnit / 1000);
@@ -151,10 +132,17 @@ namespace PWTD::Intel {
                 regVal.pl2TimeZ = timeWindow.z;
             }
 
-            if (!setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
-                return false;
+            setRawValue(regVal, raw);
+
+            batch.modify(0, addr, writeMask, raw, true);
+            return true;
+        }
+
+        [[nodiscard]]
+        bool setPkgPowerLimit(const PWTS::RWData<PWTS::Intel::PkgPowerLimit> &data, const PWTS::ROData<MSR_RAPL_POWER_UNIT::RAPLPowerUnits> &powerUnits) const {
+            MSRBatch batch;
 
-            return cur == raw;
+            return submitPkgPowerLimit(batch, data, powerUnits) && msrUtils->runBatch(batch);
         }
     };
 }
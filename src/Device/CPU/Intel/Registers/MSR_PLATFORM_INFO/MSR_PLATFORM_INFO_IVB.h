@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_PLATFORM_INFO.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -40,25 +38,14 @@ namespace PWTD::Intel {
             // 63:56 reserved:8
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, platformInfoReg &regVal) const {
-            try {
-                regVal.maxNonTurboRatio = getBitfield(15, 8, raw);
-                regVal.programmableRatioLimitForTurboMode = getBitfield(28, 28, raw);
-                regVal.programmableTDPLimitForTurboMode = getBitfield(29, 29, raw);
-                regVal.lowPowerModeSupport = getBitfield(32, 32, raw);
-                regVal.numberOfConfigTDPLevels = getBitfield(34, 33, raw);
-                regVal.maxEfficiencyRatio = getBitfield(47, 40, raw);
-                regVal.minOperatingRatio = getBitfield(55, 48, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, platformInfoReg &regVal) {
+            regVal.maxNonTurboRatio = getBitfield<15, 8>(raw);
+            regVal.programmableRatioLimitForTurboMode = getBitfield<28, 28>(raw);
+            regVal.programmableTDPLimitForTurboMode = getBitfield<29, 29>(raw);
+            regVal.lowPowerModeSupport = getBitfield<32, 32>(raw);
+            regVal.numberOfConfigTDPLevels = getBitfield<34, 33>(raw);
+            regVal.maxEfficiencyRatio = getBitfield<47, 40>(raw);
+            regVal.minOperatingRatio = getBitfield<55, 48>(raw);
         }
 
     public:
@@ -66,9 +53,11 @@ namespace PWTD::Intel {
             platformInfoReg regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::ROData<PlatformInfoData>({
                 .programmableRatioLimitForTurboMode = regVal.programmableRatioLimitForTurboMode == 1,
                 .programmableTDPLimitForTurboMode = regVal.programmableTDPLimitForTurboMode == 1,
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_POWER_CTL.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -47,64 +45,42 @@ namespace PWTD::Intel {
             // 63:31 reserved:33
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, powerCtl &regVal) const {
-            try {
-                regVal.bdProcHot = getBitfield(0, 0, raw);
-                regVal.c1eEnable = getBitfield(1, 1, raw);
-                regVal.sapmImcC2Policy = getBitfield(2, 2, raw);
-                regVal.fastBrkSnpEn = getBitfield(3, 3, raw);
-                regVal.powerPerformancePlatformOverride = getBitfield(18, 18, raw);
-                regVal.disableEnergyEfficiencyOptimization = getBitfield(19, 19, raw);
-                regVal.disableRaceToHaltOptimization = getBitfield(20, 20, raw);
-                regVal.prochotOutputDisable = getBitfield(21, 21, raw);
-                regVal.prochotConfigurableResponseEnable = getBitfield(22, 22, raw);
-                regVal.vrThermAlertDisableLock = getBitfield(23, 23, raw);
-                regVal.vrThermAlertDisable = getBitfield(24, 24, raw);
-                regVal.ringEEDisable = getBitfield(25, 25, raw);
-                regVal.saOptimizationDisable = getBitfield(26, 26, raw);
-                regVal.ookDisable = getBitfield(27, 27, raw);
-                regVal.hwpAutonomousDisable = getBitfield(28, 28, raw);
-                regVal.cstatePrewakeDisable = getBitfield(30, 30, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, powerCtl &regVal) {
+            regVal.bdProcHot = getBitfield<0, 0>(raw);
+            regVal.c1eEnable = getBitfield<1, 1>(raw);
+            regVal.sapmImcC2Policy = getBitfield<2, 2>(raw);
+            regVal.fastBrkSnpEn = getBitfield<3, 3>(raw);
+            regVal.powerPerformancePlatformOverride = getBitfield<18, 18>(raw);
+            regVal.disableEnergyEfficiencyOptimization = getBitfield<19, 19>(raw);
+            regVal.disableRaceToHaltOptimization = getBitfield<20, 20>(raw);
+            regVal.prochotOutputDisable = getBitfield<21, 21>(raw);
+            regVal.prochotConfigurableResponseEnable = getBitfield<22, 22>(raw);
+            regVal.vrThermAlertDisableLock = getBitfield<23, 23>(raw);
+            regVal.vrThermAlertDisable = getBitfield<24, 24>(raw);
+            regVal.ringEEDisable = getBitfield<25, 25>(raw);
+            regVal.saOptimizationDisable = getBitfield<26, 26>(raw);
+            regVal.ookDisable = getBitfield<27, 27>(raw);
+            regVal.hwpAutonomousDisable = getBitfield<28, 28>(raw);
+            regVal.cstatePrewakeDisable = getBitfield<30, 30>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const powerCtl &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(0, 0, regVal.bdProcHot, raw);
-                setBitfield(1, 1, regVal.c1eEnable, raw);
-                setBitfield(2, 2, regVal.sapmImcC2Policy, raw);
-                setBitfield(3, 3, regVal.fastBrkSnpEn, raw);
-                setBitfield(18, 18, regVal.powerPerformancePlatformOverride, raw);
-                setBitfield(19, 19, regVal.disableEnergyEfficiencyOptimization, raw);
-                setBitfield(20, 20, regVal.disableRaceToHaltOptimization, raw);
-                setBitfield(21, 21, regVal.prochotOutputDisable, raw);
-                setBitfield(22, 22, regVal.prochotConfigurableResponseEnable, raw);
-                setBitfield(23, 23, regVal.vrThermAlertDisableLock, raw);
-                setBitfield(24, 24, regVal.vrThermAlertDisable, raw);
-                setBitfield(25, 25, regVal.ringEEDisable, raw);
-                setBitfield(26, 26, regVal.saOptimizationDisable, raw);
-                setBitfield(27, 27, regVal.ookDisable, raw);
-                setBitfield(28, 28, regVal.hwpAutonomousDisable, raw);
-                setBitfield(30, 30, regVal.cstatePrewakeDisable, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const powerCtl &regVal, uint64_t &raw) {
+            setBitfield<0, 0>(regVal.bdProcHot, raw);
+            setBitfield<1, 1>(regVal.c1eEnable, raw);
+            setBitfield<2, 2>(regVal.sapmImcC2Policy, raw);
+            setBitfield<3, 3>(regVal.fastBrkSnpEn, raw);
+            setBitfield<18, 18>(regVal.powerPerformancePlatformOverride, raw);
+            setBitfield<19, 19>(regVal.disableEnergyEfficiencyOptimization, raw);
+            setBitfield<20, 20>(regVal.disableRaceToHaltOptimization, raw);
+            setBitfield<21, 21>(regVal.prochotOutputDisable, raw);
+            setBitfield<22, 22>(regVal.prochotConfigurableResponseEnable, raw);
+            setBitfield<23, 23>(regVal.vrThermAlertDisableLock, raw);
+            setBitfield<24, 24>(regVal.vrThermAlertDisable, raw);
+            setBitfield<25, 25>(regVal.ringEEDisable, raw);
+            setBitfield<26, 26>(regVal.saOptimizationDisable, raw);
+            setBitfield<27, 27>(regVal.ookDisable, raw);
+            setBitfield<28, 28>(regVal.hwpAutonomousDisable, raw);
+            setBitfield<30, 30>(regVal.cstatePrewakeDisable, raw);
         }
 
     public:
@@ -112,9 +88,11 @@ namespace PWTD::Intel {
             powerCtl regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::PowerCtl>({
                 .bdProcHot = regVal.bdProcHot == 1,
                 .c1eEnable = regVal.c1eEnable == 1,
@@ -161,7 +139,12 @@ namespace PWTD::Intel {
             regVal.hwpAutonomousDisable = powCtl.hwpAutonomousDisable;
             regVal.cstatePrewakeDisable = powCtl.cstatePrewakeDisable;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_POWER_CTL.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -31,34 +29,12 @@ namespace PWTD::Intel {
             // 63:2 reserved:62
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, powerCtl &regVal) const {
-            try {
-                regVal.c1eEnable = getBitfield(1, 1, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, powerCtl &regVal) {
+            regVal.c1eEnable = getBitfield<1, 1>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const powerCtl &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(1, 1, regVal.c1eEnable, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const powerCtl &regVal, uint64_t &raw) {
+            setBitfield<1, 1>(regVal.c1eEnable, raw);
         }
 
     public:
@@ -66,9 +42,11 @@ namespace PWTD::Intel {
             powerCtl regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::PowerCtl>({
                 .c1eEnable = regVal.c1eEnable == 1,
             }, true);
@@ -85,7 +63,12 @@ namespace PWTD::Intel {
 
             regVal.c1eEnable = powCtl.c1eEnable;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_POWER_CTL.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -34,40 +32,18 @@ namespace PWTD::Intel {
             // 63:21 reserved:43
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, powerCtl &regVal) const {
-            try {
-                regVal.bdProcHot = getBitfield(0, 0, raw);
-                regVal.c1eEnable = getBitfield(1, 1, raw);
-                regVal.disableEnergyEfficiencyOptimization = getBitfield(19, 19, raw);
-                regVal.disableRaceToHaltOptimization = getBitfield(20, 20, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, powerCtl &regVal) {
+            regVal.bdProcHot = getBitfield<0, 0>(raw);
+            regVal.c1eEnable = getBitfield<1, 1>(raw);
+            regVal.disableEnergyEfficiencyOptimization = getBitfield<19, 19>(raw);
+            regVal.disableRaceToHaltOptimization = getBitfield<20, 20>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const powerCtl &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(0, 0, regVal.bdProcHot, raw);
-                setBitfield(1, 1, regVal.c1eEnable, raw);
-                setBitfield(19, 19, regVal.disableEnergyEfficiencyOptimization, raw);
-                setBitfield(20, 20, regVal.disableRaceToHaltOptimization, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const powerCtl &regVal, uint64_t &raw) {
+            setBitfield<0, 0>(regVal.bdProcHot, raw);
+            setBitfield<1, 1>(regVal.c1eEnable, raw);
+            setBitfield<19, 19>(regVal.disableEnergyEfficiencyOptimization, raw);
+            setBitfield<20, 20>(regVal.disableRaceToHaltOptimization, raw);
         }
 
     public:
@@ -75,9 +51,11 @@ namespace PWTD::Intel {
             powerCtl regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::PowerCtl>({
                 .bdProcHot = regVal.bdProcHot == 1,
                 .c1eEnable = regVal.c1eEnable == 1,
@@ -100,7 +78,12 @@ namespace PWTD::Intel {
             regVal.disableEnergyEfficiencyOptimization = powCtl.disableEnergyEfficiencyOpt;
             regVal.disableRaceToHaltOptimization = powCtl.disableRaceToHaltOpt;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
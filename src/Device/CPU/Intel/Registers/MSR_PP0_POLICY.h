@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/Types/RWData.h"
@@ -31,34 +29,12 @@ namespace PWTD::Intel {
             // 63:5 reserved:59
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, PP0Policy &regVal) const {
-            try {
-                regVal.priority = getBitfield(4, 0, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, PP0Policy &regVal) {
+            regVal.priority = getBitfield<4, 0>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const PP0Policy &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(4, 0, regVal.priority, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const PP0Policy &regVal, uint64_t &raw) {
+            setBitfield<4, 0>(regVal.priority, raw);
         }
 
     public:
@@ -70,9 +46,11 @@ namespace PWTD::Intel {
             PP0Policy regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<int>(static_cast<int>(regVal.priority), true);
         }
 
@@ -86,7 +64,12 @@ namespace PWTD::Intel {
 
             regVal.priority = data.getValue();
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
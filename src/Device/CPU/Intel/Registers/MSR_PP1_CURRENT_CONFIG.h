@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/Intel/PP1CurrentConfig.h"
@@ -34,36 +32,14 @@ namespace PWTD::Intel {
             // 63:32 reserved:32
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, PP1CurrentConfig &regVal) const {
-            try {
-                regVal.limit = getBitfield(12, 0, raw);
-                regVal.lock = getBitfield(31, 31, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, PP1CurrentConfig &regVal) {
+            regVal.limit = getBitfield<12, 0>(raw);
+            regVal.lock = getBitfield<31, 31>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const PP1CurrentConfig &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(12, 0, regVal.limit, raw);
-                setBitfield(31, 31, regVal.lock, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const PP1CurrentConfig &regVal, uint64_t &raw) {
+            setBitfield<12, 0>(regVal.limit, raw);
+            setBitfield<31, 31>(regVal.lock, raw);
         }
 
     public:
@@ -75,9 +51,11 @@ namespace PWTD::Intel {
             PP1CurrentConfig regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::PP1CurrentConfig>({
                 .limit = static_cast<int>(regVal.limit * 0.125 * 1000), //todo check
                 .lock = regVal.lock == 1
@@ -96,7 +74,12 @@ namespace PWTD::Intel {
             regVal.limit = static_cast<uint64_t>(pp1Cfg.limit / 0.125 / 1000);
             regVal.lock = pp1Cfg.lock;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/Types/ROData.h"
@@ -35,26 +33,16 @@ namespace PWTD::Intel {
             // 63:20 reserved:44
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, raplPowerUnit &regVal) const {
-            try {
-                regVal.powerUnits = getBitfield(3, 0, raw);
-                regVal.energyStatusUnits = getBitfield(7, 4, raw);
-                regVal.timeUnits = getBitfield(19, 16, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, raplPowerUnit &regVal) {
+            regVal.powerUnits = getBitfield<3, 0>(raw);
+            regVal.energyStatusUnits = getBitfield<12, 8>(raw);
+            regVal.timeUnits = getBitfield<19, 16>(raw);
         }
 
     public:
         struct [[nodiscard]] RAPLPowerUnits final {
             double powerUnit;
+            double energyUnit;
             double timeUnit;
         };
 
@@ -66,11 +54,14 @@ namespace PWTD::Intel {
             raplPowerUnit regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::ROData<RAPLPowerUnits>({
                 .powerUnit = 1 / qPow(2, regVal.powerUnits),
+                .energyUnit = 1 / qPow(2, regVal.energyStatusUnits),
                 .timeUnit = 1 / qPow(2, regVal.timeUnits)
             }, true);
         }
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_TEMPERATURE_TARGET.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -31,19 +29,8 @@ namespace PWTD::Intel {
             // 63:24 reserved:40
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, temperatureTarget &regVal) const {
-            try {
-                regVal.tempTarget = getBitfield(23, 16, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, temperatureTarget &regVal) {
+            regVal.tempTarget = getBitfield<23, 16>(raw);
         }
 
     public:
@@ -51,9 +38,11 @@ namespace PWTD::Intel {
             temperatureTarget regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::TemperatureTarget>({
                 .temperatureTarget = static_cast<int>(regVal.tempTarget)
             }, true);
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/Intel/TurboPowerCurrentLimit.h"
@@ -35,40 +33,18 @@ namespace PWTD::Intel {
             // 63:32 reserved:32
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, turboPowerCurrentLimit &regVal) const {
-            try {
-                regVal.tdpLimit = getBitfield(14, 0, raw);
-                regVal.tdpLimitOverrideEnable = getBitfield(15, 15, raw);
-                regVal.tdcLimit = getBitfield(30, 16, raw);
-                regVal.tdcLimitOverrideEnable = getBitfield(31, 31, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, turboPowerCurrentLimit &regVal) {
+            regVal.tdpLimit = getBitfield<14, 0>(raw);
+            regVal.tdpLimitOverrideEnable = getBitfield<15, 15>(raw);
+            regVal.tdcLimit = getBitfield<30, 16>(raw);
+            regVal.tdcLimitOverrideEnable = getBitfield<31, 31>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const turboPowerCurrentLimit &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(14, 0, regVal.tdpLimit, raw);
-                setBitfield(15, 15, regVal.tdpLimitOverrideEnable, raw);
-                setBitfield(30, 16, regVal.tdcLimit, raw);
-                setBitfield(31, 31, regVal.tdcLimitOverrideEnable, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const turboPowerCurrentLimit &regVal, uint64_t &raw) {
+            setBitfield<14, 0>(regVal.tdpLimit, raw);
+            setBitfield<15, 15>(regVal.tdpLimitOverrideEnable, raw);
+            setBitfield<30, 16>(regVal.tdcLimit, raw);
+            setBitfield<31, 31>(regVal.tdcLimitOverrideEnable, raw);
         }
 
     public:
@@ -80,9 +56,11 @@ namespace PWTD::Intel {
             turboPowerCurrentLimit regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::TurboPowerCurrentLimit>({
                 .tdpLimit = static_cast<int>(regVal.tdpLimit * 0.125 * 1000),
                 .tdpLimitOverride = regVal.tdpLimitOverrideEnable == 1,
@@ -105,7 +83,12 @@ namespace PWTD::Intel {
             regVal.tdcLimit = static_cast<uint64_t>(limit.tdcLimit / 0.125 / 1000);
             regVal.tdcLimitOverrideEnable = limit.tdcLimitOverride;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "../../CPURegister.h"
 #include "../../Utils/CPUUtils.h"
 #include "pwtShared/Include/CPU/Intel/TurboRatioLimit.h"
@@ -38,48 +36,26 @@ namespace PWTD::Intel {
             uint64_t maxRatioLimit8C :8; // 63:56
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, turboRatioLimit &regVal) const {
-            try {
-                regVal.maxRatioLimit1C = getBitfield(7, 0, raw);
-                regVal.maxRatioLimit2C = getBitfield(15, 8, raw);
-                regVal.maxRatioLimit3C = getBitfield(23, 16, raw);
-                regVal.maxRatioLimit4C = getBitfield(31, 24, raw);
-                regVal.maxRatioLimit5C = getBitfield(39, 32, raw);
-                regVal.maxRatioLimit6C = getBitfield(47, 40, raw);
-                regVal.maxRatioLimit7C = getBitfield(55, 48, raw);
-                regVal.maxRatioLimit8C = getBitfield(63, 56, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, turboRatioLimit &regVal) {
+            regVal.maxRatioLimit1C = getBitfield<7, 0>(raw);
+            regVal.maxRatioLimit2C = getBitfield<15, 8>(raw);
+            regVal.maxRatioLimit3C = getBitfield<23, 16>(raw);
+            regVal.maxRatioLimit4C = getBitfield<31, 24>(raw);
+            regVal.maxRatioLimit5C = getBitfield<39, 32>(raw);
+            regVal.maxRatioLimit6C = getBitfield<47, 40>(raw);
+            regVal.maxRatioLimit7C = getBitfield<55, 48>(raw);
+            regVal.maxRatioLimit8C = getBitfield<63, 56>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const turboRatioLimit &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(7, 0, regVal.maxRatioLimit1C, raw);
-                setBitfield(15, 8, regVal.maxRatioLimit2C, raw);
-                setBitfield(23, 16, regVal.maxRatioLimit3C, raw);
-                setBitfield(31, 24, regVal.maxRatioLimit4C, raw);
-                setBitfield(39, 32, regVal.maxRatioLimit5C, raw);
-                setBitfield(47, 40, regVal.maxRatioLimit6C, raw);
-                setBitfield(55, 48, regVal.maxRatioLimit7C, raw);
-                setBitfield(63, 56, regVal.maxRatioLimit8C, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const turboRatioLimit &regVal, uint64_t &raw) {
+            setBitfield<7, 0>(regVal.maxRatioLimit1C, raw);
+            setBitfield<15, 8>(regVal.maxRatioLimit2C, raw);
+            setBitfield<23, 16>(regVal.maxRatioLimit3C, raw);
+            setBitfield<31, 24>(regVal.maxRatioLimit4C, raw);
+            setBitfield<39, 32>(regVal.maxRatioLimit5C, raw);
+            setBitfield<47, 40>(regVal.maxRatioLimit6C, raw);
+            setBitfield<55, 48>(regVal.maxRatioLimit7C, raw);
+            setBitfield<63, 56>(regVal.maxRatioLimit8C, raw);
         }
 
     public:
@@ -91,9 +67,11 @@ namespace PWTD::Intel {
             turboRatioLimit regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::TurboRatioLimit>({
                 .maxRatioLimit1C = static_cast<int>(regVal.maxRatioLimit1C),
                 .maxRatioLimit2C = static_cast<int>(regVal.maxRatioLimit2C),
@@ -124,7 +102,12 @@ namespace PWTD::Intel {
             regVal.maxRatioLimit7C = limit.maxRatioLimit7C;
             regVal.maxRatioLimit8C = limit.maxRatioLimit8C;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,8 +17,6 @@
  */
 #pragma once
 
-#include <stdexcept>
-
 #include "MSR_VR_CURRENT_CONFIG.h"
 #include "../../../Utils/CPUUtils.h"
 
@@ -32,36 +30,14 @@ namespace PWTD::Intel {
             // 63:32 reserved:32
         };
 
-        [[nodiscard]]
-        bool setBitfields(const uint64_t raw, vrCurrentConfig &regVal) const {
-            try {
-                regVal.pl4 = getBitfield(15, 0, raw);
-                regVal.lock = getBitfield(31, 31, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setBitfields(const uint64_t raw, vrCurrentConfig &regVal) {
+            regVal.pl4 = getBitfield<15, 0>(raw);
+            regVal.lock = getBitfield<31, 31>(raw);
         }
 
-        [[nodiscard]]
-        bool setRawValue(const vrCurrentConfig &regVal, uint64_t &raw) const {
-            try {
-                setBitfield(15, 0, regVal.pl4, raw);
-                setBitfield(31, 31, regVal.lock, raw);
-
-            } catch ([[maybe_unused]] std::invalid_argument const &e) {
-                if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(e.what());
-
-                return false;
-            }
-
-            return true;
+        static constexpr void setRawValue(const vrCurrentConfig &regVal, uint64_t &raw) {
+            setBitfield<15, 0>(regVal.pl4, raw);
+            setBitfield<31, 31>(regVal.lock, raw);
         }
 
     public:
@@ -69,9 +45,11 @@ namespace PWTD::Intel {
             vrCurrentConfig regVal {};
             uint64_t raw = 0;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setBitfields(raw, regVal))
+            if (!msrUtils->readMSR(raw, addr, 0))
                 return {};
 
+            setBitfields(raw, regVal);
+
             return PWTS::RWData<PWTS::Intel::VRCurrentConfig>({
                 .pl4 = static_cast<int>(regVal.pl4 * 0.125 * 1000),
                 .lock = regVal.lock == 1
@@ -90,7 +68,12 @@ namespace PWTD::Intel {
             regVal.pl4 = static_cast<int>(vrCfg.pl4 / 0.125 / 1000);
             regVal.lock = vrCfg.lock;
 
-            if (!msrUtils->readMSR(raw, addr, 0) || !setRawValue(regVal, raw) || !msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
+            if (!msrUtils->readMSR(raw, addr, 0))
+                return false;
+
+            setRawValue(regVal, raw);
+
+            if (!msrUtils->writeMSR(raw, addr, 0) || !msrUtils->readMSR(cur, addr, 0))
                 return false;
 
             return cur == raw;
@@ -17,11 +17,34 @@
  */
 #pragma once
 
+#include <concepts>
 #include <cstdint>
 
 namespace PWTD {
-    [[nodiscard]] uint64_t getBitfield(unsigned highbit, unsigned lowbit, uint64_t data);
-    void setBitfield(unsigned highbit, unsigned lowbit, uint64_t value, uint64_t &data);
-    [[nodiscard]] uint32_t getBitfield(unsigned highbit, unsigned lowbit, uint32_t data);
-    void setBitfield(unsigned highbit, unsigned lowbit, uint32_t value, uint32_t &data);
+    // register field highbit:lowbit, bounds are checked at compile time
+    template <std::unsigned_integral T, unsigned Highbit, unsigned Lowbit>
+    struct Bitfield final {
+        static_assert(Highbit < sizeof(T) * 8, "high bit out of register range");
+        static_assert(Lowbit <= Highbit, "low bit above high bit");
+
+        static constexpr unsigned width = Highbit - Lowbit + 1;
+        static constexpr T mask = static_cast<T>(static_cast<T>(~T(0)) >> (sizeof(T) * 8 - width)) << Lowbit;
+    };
+
+    template <unsigned Highbit, unsigned Lowbit, std::unsigned_integral T>
+    [[nodiscard]] constexpr T getBitfield(const T data) {
+        return (data & Bitfield<T, Highbit, Lowbit>::mask) >> Lowbit;
+    }
+
+    template <unsigned Highbit, unsigned Lowbit, std::unsigned_integral T>
+    constexpr void setBitfield(const uint64_t value, T &data) {
+        constexpr T mask = Bitfield<T, Highbit, Lowbit>::mask;
+
+        data = (data & ~mask) | (static_cast<T>(value << Lowbit) & mask);
+    }
+
+    template <unsigned Highbit, unsigned Lowbit, std::unsigned_integral T = uint64_t>
+    [[nodiscard]] constexpr T getBitfieldMask() {
+        return Bitfield<T, Highbit, Lowbit>::mask;
+    }
 }
@@ -0,0 +1,163 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "CPUWorkerPool.h"
+
+namespace PWTD {
+    CPUWorkerPool::CPUWorkerPool() {
+        logger = FileLogger::getInstance();
+    }
+
+    CPUWorkerPool::~CPUWorkerPool() {
+        stopWorkers();
+    }
+
+    QSharedPointer<CPUWorkerPool> CPUWorkerPool::getInstance() {
+        if (instance.isNull())
+            instance.reset(new CPUWorkerPool);
+
+        return instance;
+    }
+
+    bool CPUWorkerPool::isPinningSupported() {
+#ifdef __linux__
+        return true;
+#else
+        return false; // winring0 already moves the calling thread to the target cpu
+#endif
+    }
+
+    bool CPUWorkerPool::pinCurrentThread(const int cpu) {
+#ifdef __linux__
+        cpu_set_t set;
+
+        // running on the cpu is not enough, the scheduler can still migrate an unpinned thread
+        if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0 && CPU_COUNT(&set) == 1 && CPU_ISSET(cpu, &set))
+            return true;
+
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    void CPUWorkerPool::startWorkers(const int count) {
+        stopWorkers();
+
+        for (int i=0; i<count; ++i) {
+            QThread *thd = QThread::create([this, i]() { workerLoop(i); });
+
+            thd->setObjectName(QString("cpuworker%1").arg(i));
+            thd->start();
+            workers.append(thd);
+        }
+    }
+
+    void CPUWorkerPool::stopWorkers() {
+        if (workers.isEmpty())
+            return;
+
+        mutex.lock();
+        quit = true;
+        taskCond.wakeAll();
+        mutex.unlock();
+
+        for (QThread *thd: std::as_const(workers))
+            thd->wait();
+
+        qDeleteAll(workers);
+        workers.clear();
+        quit = false;
+    }
+
+    void CPUWorkerPool::workerLoop(const int cpu) {
+        quint64 seen = 0;
+
+        if (!pinCurrentThread(cpu) && logger->isLevel(PWTS::LogLevel::Warning))
+            logger->write(QString("failed to pin worker to cpu %1").arg(cpu));
+
+        QMutexLocker locker(&mutex);
+
+        while (true) {
+            while (!quit && generation == seen)
+                taskCond.wait(&mutex);
+
+            if (quit)
+                return;
+
+            seen = generation;
+
+            if (cpu >= taskCount)
+                continue;
+
+            const std::function<void(int)> *fn = task;
+
+            locker.unlock();
+
+            // affinity is reset by the kernel if the cpu went offline in the meantime
+            pinCurrentThread(cpu);
+            (*fn)(cpu);
+
+            locker.relock();
+
+            if (--pending == 0)
+                doneCond.wakeAll();
+        }
+    }
+
+    void CPUWorkerPool::setEnabled(const bool enable) {
+        enabled = enable;
+
+        if (!enabled)
+            stopWorkers();
+    }
+
+    void CPUWorkerPool::run(const int count, const std::function<void(int)> &fn) {
+        if (!enabled || count <= 1 || !isPinningSupported()) {
+            for (int i=0; i<count; ++i)
+                fn(i);
+
+            return;
+        }
+
+        if (workers.size() != count)
+            startWorkers(count);
+
+        QMutexLocker locker(&mutex);
+
+        task = &fn;
+        taskCount = count;
+        pending = count;
+        ++generation;
+
+        taskCond.wakeAll();
+
+        while (pending > 0)
+            doneCond.wait(&mutex);
+
+        task = nullptr;
+        taskCount = 0;
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <functional>
+#include <QSharedPointer>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+
+#include "../../../../Utils/FileLogger/FileLogger.h"
+
+namespace PWTD {
+    // one worker per logical cpu, pinned to it, so msr access runs locally instead of through an IPI
+    // run() blocks until every cpu is done, callers store results per cpu and merge them in cpu order
+    class CPUWorkerPool final {
+    private:
+        inline static QSharedPointer<CPUWorkerPool> instance;
+        QSharedPointer<FileLogger> logger;
+        QList<QThread *> workers;
+        QMutex mutex;
+        QWaitCondition taskCond;
+        QWaitCondition doneCond;
+        const std::function<void(int)> *task = nullptr;
+        quint64 generation = 0;
+        int taskCount = 0;
+        int pending = 0;
+        bool enabled = true;
+        bool quit = false;
+
+        CPUWorkerPool();
+
+        [[nodiscard]] static bool isPinningSupported();
+        [[nodiscard]] static bool pinCurrentThread(int cpu);
+        void startWorkers(int count);
+        void stopWorkers();
+        void workerLoop(int cpu);
+
+    public:
+        CPUWorkerPool(const CPUWorkerPool &) = delete;
+        CPUWorkerPool &operator=(const CPUWorkerPool &) = delete;
+
+        ~CPUWorkerPool();
+
+        [[nodiscard]] static QSharedPointer<CPUWorkerPool> getInstance();
+        void setEnabled(bool enable);
+        [[nodiscard]] bool isEnabled() const { return enabled; }
+        void run(int count, const std::function<void(int)> &fn);
+    };
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "pwtShared/Include/Types/ROData.h"
+
+namespace PWTD {
+    // 32 bit running energy counter, turns two consecutive reads into average power
+    // the counter wraps in minutes at high load, updates must come more often than one full wrap
+    class EnergyCounter final {
+    private:
+        double energyUnit = 0; // joules per count
+        uint32_t lastCount = 0;
+        qint64 lastNsecs = 0;
+        bool hasLast = false;
+
+    public:
+        void setEnergyUnit(const double unit) {
+            energyUnit = unit;
+            reset();
+        }
+
+        void reset() {
+            hasLast = false;
+        }
+
+        // milliwatts since the previous update, invalid on the first one
+        [[nodiscard]] PWTS::ROData<int> update(const uint32_t count, const qint64 nsecs) {
+            const bool valid = hasLast && nsecs > lastNsecs && energyUnit > 0;
+            const uint32_t delta = count - lastCount; // unsigned math handles a single wrap
+            const qint64 elapsed = nsecs - lastNsecs;
+
+            lastCount = count;
+            lastNsecs = nsecs;
+            hasLast = true;
+
+            if (!valid)
+                return {};
+
+            return PWTS::ROData<int>(static_cast<int>(delta * energyUnit * 1e12 / elapsed), true);
+        }
+    };
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "FrequencySampler.h"
+#include "../MSR/MSRFactory.h"
+#include "../MSR/MSRHandle.h"
+
+namespace PWTD {
+    FrequencySampler::FrequencySampler(const int numLogicalCPUs) {
+        logger = FileLogger::getInstance();
+        msrDev = MSRFactory::getMSRInstance();
+        workerPool = CPUWorkerPool::getInstance();
+        lastCounters.resize(numLogicalCPUs);
+
+        clock.start();
+    }
+
+    // mperf first and tsc last, so c0 residency cannot go above 100% from read skew
+    FrequencySampler::Counters FrequencySampler::readCounters(const int cpu) const {
+        const MSRHandle msrHandle {msrDev, cpu};
+        Counters counters;
+
+        if (!msrHandle.isOpen())
+            return counters;
+
+        counters.valid = msrDev->readMSR(counters.mperf, IA32_MPERF, cpu) &&
+                         msrDev->readMSR(counters.aperf, IA32_APERF, cpu) &&
+                         msrDev->readMSR(counters.tsc, IA32_TIME_STAMP_COUNTER, cpu);
+
+        return counters;
+    }
+
+    FrequencySample FrequencySampler::sample() {
+        const qint64 startNsecs = clock.nsecsElapsed();
+
+        if (lastNsecs > 0 && (startNsecs - lastNsecs) < (lastSample.costNsecs * MaxDutyCycle))
+            return lastSample;
+
+        const int numCPUs = lastCounters.size();
+        QList<Counters> counters(numCPUs);
+        Counters *countersPtr = counters.data();
+        FrequencySample ret;
+
+        workerPool->run(numCPUs, [&](const int cpu) { countersPtr[cpu] = readCounters(cpu); });
+
+        const qint64 endNsecs = clock.nsecsElapsed();
+        const qint64 windowNsecs = startNsecs - lastNsecs;
+
+        ret.effectiveFrequency.fill(FrequencySample::Unavailable, numCPUs);
+        ret.c0Residency.fill(FrequencySample::Unavailable, numCPUs);
+        ret.costNsecs = endNsecs - startNsecs;
+
+        for (int i=0; i<numCPUs; ++i) {
+            const Counters &prev = lastCounters[i];
+            const Counters &cur = counters[i];
+
+            if (!prev.valid || !cur.valid || lastNsecs == 0 || windowNsecs <= 0 || cur.tsc <= prev.tsc)
+                continue;
+
+            const double deltaAperf = static_cast<double>(cur.aperf - prev.aperf);
+            const double deltaMperf = static_cast<double>(cur.mperf - prev.mperf);
+            const double deltaTsc = static_cast<double>(cur.tsc - prev.tsc);
+            const double tscMhz = deltaTsc * 1000 / static_cast<double>(windowNsecs);
+
+            ret.c0Residency[i] = static_cast<int>(qMin(deltaMperf / deltaTsc, 1.0) * 1000);
+            ret.effectiveFrequency[i] = deltaMperf > 0 ? static_cast<int>(tscMhz * deltaAperf / deltaMperf) : 0;
+        }
+
+        if (logger->isLevel(PWTS::LogLevel::Info) && ret.costNsecs > 1000000)
+            logger->write(QString("frequency sampling took %1us for %2 cpus").arg(ret.costNsecs / 1000).arg(numCPUs));
+
+        lastCounters = counters;
+        lastNsecs = startNsecs;
+        lastSample = ret;
+
+        return ret;
+    }
+}
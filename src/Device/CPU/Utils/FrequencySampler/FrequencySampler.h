@@ -0,0 +1,68 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QSharedPointer>
+
+#include "../MSR/MSR.h"
+#include "../CPUWorkerPool/CPUWorkerPool.h"
+#include "../../../../Utils/FileLogger/FileLogger.h"
+
+namespace PWTD {
+    struct FrequencySample final {
+        static constexpr int Unavailable = -1;
+
+        QList<int> effectiveFrequency; // mhz while in c0, per logical cpu
+        QList<int> c0Residency; // per mille of the sample window
+        qint64 costNsecs = 0; // time spent reading the counters
+    };
+
+    // effective frequency from APERF/MPERF/TSC deltas between two samples, read through the msr layer
+    // reading costs three msr reads per cpu, samples come back cached when asked faster than the cost budget allows
+    class FrequencySampler final {
+    private:
+        static constexpr uint32_t IA32_TIME_STAMP_COUNTER = 0x10;
+        static constexpr uint32_t IA32_MPERF = 0xe7;
+        static constexpr uint32_t IA32_APERF = 0xe8;
+        static constexpr int MaxDutyCycle = 50; // sampling takes at most 1/50 of the time between samples
+
+        struct Counters final {
+            uint64_t aperf = 0;
+            uint64_t mperf = 0;
+            uint64_t tsc = 0;
+            bool valid = false;
+        };
+
+        QSharedPointer<FileLogger> logger;
+        QSharedPointer<MSR> msrDev;
+        QSharedPointer<CPUWorkerPool> workerPool;
+        QList<Counters> lastCounters;
+        FrequencySample lastSample;
+        QElapsedTimer clock;
+        qint64 lastNsecs = 0;
+
+        [[nodiscard]] Counters readCounters(int cpu) const;
+
+    public:
+        explicit FrequencySampler(int numLogicalCPUs);
+
+        [[nodiscard]] FrequencySample sample();
+    };
+}
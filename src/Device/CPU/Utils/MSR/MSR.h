@@ -19,8 +19,34 @@
 
 #include <cstdint>
 
+#include "MSRBatch.h"
+
 namespace PWTD {
     class MSR {
+    protected:
+        template <typename R, typename W>
+        [[nodiscard]] static bool runOp(MSROp &op, R &&readFn, W &&writeFn) {
+            uint64_t raw = op.value;
+            uint64_t cur = 0;
+
+            if (op.type == MSROpType::Read)
+                return readFn(op.value);
+
+            if (op.type == MSROpType::Modify) {
+                if (!readFn(cur))
+                    return false;
+
+                raw = MSRBatch::merge(cur, op.mask, op.value);
+            }
+
+            if (!writeFn(raw))
+                return false;
+
+            op.value = raw;
+
+            return !op.verify || (readFn(cur) && cur == raw);
+        }
+
     public:
         virtual ~MSR() = default;
 
@@ -30,5 +56,6 @@ namespace PWTD {
         [[nodiscard]] virtual bool writeMSR(uint64_t value, uint32_t adr, int cpu) const = 0;
         [[nodiscard]] virtual bool writeMSR(uint32_t value, uint32_t adr, int cpu) const = 0;
         virtual void closeMsrFd(int cpu) = 0;
+        [[nodiscard]] virtual bool runBatch(MSRBatch &batch) = 0;
     };
 }
@@ -0,0 +1,92 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <QList>
+
+namespace PWTD {
+    enum struct MSROpType: int {
+        Read,
+        Write,
+        Modify
+    };
+
+    struct MSROp final {
+        int cpu;
+        uint32_t addr;
+        MSROpType type;
+        uint64_t mask; // bits changed by Modify
+        uint64_t value; // value to write, read or written value after run
+        bool verify; // read back and compare after write, the register setters that always checked their write pass true
+        bool ok;
+    };
+
+    // msr operations submitted by the register classes, run by MSR::runBatch grouped by cpu
+    class MSRBatch final {
+    private:
+        QList<MSROp> ops;
+
+        int append(const int cpu, const uint32_t addr, const MSROpType type, const uint64_t mask, const uint64_t value, const bool verify) {
+            ops.append(MSROp {cpu, addr, type, mask, value, verify, false});
+            return ops.size() - 1;
+        }
+
+    public:
+        [[nodiscard]]
+        static uint64_t merge(const uint64_t cur, const uint64_t mask, const uint64_t value) {
+            return (cur & ~mask) | (value & mask);
+        }
+
+        int read(const int cpu, const uint32_t addr) {
+            return append(cpu, addr, MSROpType::Read, 0, 0, false);
+        }
+
+        int write(const int cpu, const uint32_t addr, const uint64_t value, const bool verify = false) {
+            return append(cpu, addr, MSROpType::Write, ~0ULL, value, verify);
+        }
+
+        int modify(const int cpu, const uint32_t addr, const uint64_t mask, const uint64_t value, const bool verify = false) {
+            return append(cpu, addr, MSROpType::Modify, mask, value, verify);
+        }
+
+        // op indexes ordered by cpu, submission order is kept within a cpu
+        [[nodiscard]]
+        QList<int> getCPUOrder() const {
+            QList<int> order(ops.size());
+
+            for (int i=0,l=ops.size(); i<l; ++i)
+                order[i] = i;
+
+            std::ranges::stable_sort(order, [this](const int a, const int b) { return ops[a].cpu < ops[b].cpu; });
+            return order;
+        }
+
+        [[nodiscard]] QList<MSROp> &getOps() { return ops; }
+        [[nodiscard]] bool isEmpty() const { return ops.isEmpty(); }
+        [[nodiscard]] bool isOk(const int idx) const { return ops[idx].ok; }
+        [[nodiscard]] uint64_t getValue(const int idx) const { return ops[idx].value; }
+        void clear() { ops.clear(); }
+
+        [[nodiscard]]
+        bool allOk() const {
+            return std::ranges::all_of(ops, [](const MSROp &op) { return op.ok; });
+        }
+    };
+}
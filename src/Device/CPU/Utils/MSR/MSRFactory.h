@@ -47,5 +47,10 @@ namespace PWTD {
 #endif
             return instance;
         }
+
+        // tests swap in a fake backend, registers pick it up when they are created
+        static void setMSRInstance(const QSharedPointer<MSR> &msr) {
+            instance = msr;
+        }
     };
 }
@@ -0,0 +1,47 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QSharedPointer>
+
+#include "MSR.h"
+
+namespace PWTD {
+    // scoped access to the msr device of a cpu
+    class MSRHandle final {
+    private:
+        QSharedPointer<MSR> msr;
+        int cpu;
+        bool opened;
+
+    public:
+        MSRHandle(const QSharedPointer<MSR> &msrDev, const int cpu): msr(msrDev), cpu(cpu) {
+            opened = msr->openMsrFd(cpu);
+        }
+
+        ~MSRHandle() {
+            if (opened)
+                msr->closeMsrFd(cpu);
+        }
+
+        MSRHandle(const MSRHandle &) = delete;
+        MSRHandle &operator=(const MSRHandle &) = delete;
+
+        [[nodiscard]] bool isOpen() const { return opened; }
+    };
+}
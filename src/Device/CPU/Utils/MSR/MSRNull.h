@@ -28,5 +28,6 @@ namespace PWTD {
         [[nodiscard]] bool writeMSR(const uint64_t value, const uint32_t adr, const int cpu) const override { return false; }
         [[nodiscard]] bool writeMSR(const uint32_t value, const uint32_t adr, const int cpu) const override { return false; }
         void closeMsrFd(const int cpu) override {}
+        [[nodiscard]] bool runBatch(MSRBatch &batch) override { return batch.isEmpty(); }
     };
 }
@@ -18,18 +18,28 @@
 #include <libkmod.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <cerrno>
+#include <QString>
 
 #include "MSRLinux.h"
 
 namespace PWTD::LNX {
-    void MSRLinux::addSlotForCPU(const int cpu) {
-        if (msrFDMap.contains(cpu))
-            return;
+    MSRLinux::MSRLinux() {
+        const long numCpus = sysconf(_SC_NPROCESSORS_CONF);
 
-        msrFDMap.insert(cpu, {.fd = -1, .openCount = 0});
+        msrFDList.resize(numCpus > 0 ? numCpus : 1, -1);
+    }
+
+    MSRLinux::~MSRLinux() {
+        for (const int fd: std::as_const(msrFDList)) {
+            if (fd >= 0)
+                close(fd);
+        }
     }
 
     bool MSRLinux::loadMsrModule() {
+        const QMutexLocker locker(&moduleMutex);
+
         if (moduleLoaded)
             return true;
 
@@ -54,69 +64,118 @@ namespace PWTD::LNX {
         return moduleLoaded;
     }
 
-    bool MSRLinux::openMsrFd(const int cpu) {
-        if (!loadMsrModule())
-            return false;
+    int MSRLinux::getMsrFd(const int cpu) const {
+        if (cpu < 0 || cpu >= msrFDList.size()) [[unlikely]]
+            return -1;
 
-        addSlotForCPU(cpu);
+        return msrFDList[cpu];
+    }
 
-        if (msrFDMap[cpu].fd >= 0) {
-            ++msrFDMap[cpu].openCount;
-            return true;
-        }
+    void MSRLinux::dropMsrFd(const int cpu) const {
+        const int fd = getMsrFd(cpu);
 
-        const std::string path {QString("/dev/cpu/%1/msr").arg(cpu).toStdString()};
+        if (fd < 0)
+            return;
 
-        msrFDMap[cpu].fd = open(path.c_str(), O_RDWR | O_SYNC);
+        close(fd);
+        msrFDList[cpu] = -1;
+    }
 
-        if (msrFDMap[cpu].fd >= 0) {
-            ++msrFDMap[cpu].openCount;
+    bool MSRLinux::checkIOResult(const ssize_t ret, const size_t expected, const int cpu) const {
+        if (ret == static_cast<ssize_t>(expected))
             return true;
-        }
+
+        // cpu went offline, reopen on next access
+        if (ret < 0 && (errno == ENXIO || errno == ENODEV))
+            dropMsrFd(cpu);
 
         return false;
     }
 
-    void MSRLinux::closeMsrFd(const int cpu) {
-        if (msrFDMap[cpu].openCount == 0) [[unlikely]]
-            return;
+    bool MSRLinux::openMsrFd(const int cpu) {
+        if (cpu < 0 || cpu >= msrFDList.size())
+            return false;
 
-        --msrFDMap[cpu].openCount;
+        if (getMsrFd(cpu) >= 0)
+            return true;
 
-        if (msrFDMap[cpu].openCount > 0)
-            return;
+        if (!loadMsrModule())
+            return false;
+
+        const std::string path {QString("/dev/cpu/%1/msr").arg(cpu).toStdString()};
 
-        close(msrFDMap[cpu].fd);
+        msrFDList[cpu] = open(path.c_str(), O_RDWR | O_SYNC | O_CLOEXEC);
 
-        msrFDMap[cpu].fd = -1;
-        msrFDMap[cpu].openCount = 0;
+        return msrFDList[cpu] >= 0;
     }
 
+    void MSRLinux::closeMsrFd([[maybe_unused]] const int cpu) {}
+
     bool MSRLinux::readMSR(uint64_t &ret, const uint32_t adr, const int cpu) const {
-        if (msrFDMap[cpu].openCount == 0) [[unlikely]]
+        const int fd = getMsrFd(cpu);
+
+        if (fd < 0) [[unlikely]]
             return false;
 
-        return pread(msrFDMap[cpu].fd, &ret, sizeof ret, adr) == sizeof ret;
+        return checkIOResult(pread(fd, &ret, sizeof ret, adr), sizeof ret, cpu);
     }
 
     bool MSRLinux::readMSR(uint32_t &ret, const uint32_t adr, const int cpu) const {
-        if (msrFDMap[cpu].openCount == 0) [[unlikely]]
+        const int fd = getMsrFd(cpu);
+
+        if (fd < 0) [[unlikely]]
             return false;
 
-        return pread(msrFDMap[cpu].fd, &ret, sizeof ret, adr) == sizeof ret;
+        return checkIOResult(pread(fd, &ret, sizeof ret, adr), sizeof ret, cpu);
     }
 
     bool MSRLinux::writeMSR(const uint64_t value, const uint32_t adr, const int cpu) const {
-        if (msrFDMap[cpu].openCount == 0) [[unlikely]]
+        const int fd = getMsrFd(cpu);
+
+        if (fd < 0) [[unlikely]]
             return false;
 
-        return pwrite(msrFDMap[cpu].fd, &value, sizeof value, adr) == sizeof value;
+        return checkIOResult(pwrite(fd, &value, sizeof value, adr), sizeof value, cpu);
     }
 
     bool MSRLinux::writeMSR(const uint32_t value, const uint32_t adr, const int cpu) const {
-        if (msrFDMap[cpu].openCount == 0) [[unlikely]]
+        const int fd = getMsrFd(cpu);
+
+        if (fd < 0) [[unlikely]]
             return false;
 
-        return pwrite(msrFDMap[cpu].fd, &value, sizeof value, adr) == sizeof value;
+        return checkIOResult(pwrite(fd, &value, sizeof value, adr), sizeof value, cpu);
+    }
+
+    bool MSRLinux::runBatch(MSRBatch &batch) {
+        QList<MSROp> &ops = batch.getOps();
+        int cpu = -1;
+        int fd = -1;
+
+        for (const int i: batch.getCPUOrder()) {
+            MSROp &op = ops[i];
+
+            if (op.cpu != cpu) {
+                cpu = op.cpu;
+                fd = openMsrFd(cpu) ? getMsrFd(cpu) : -1;
+            }
+
+            if (fd < 0) {
+                op.ok = false;
+                continue;
+            }
+
+            op.ok = runOp(op, [&](uint64_t &ret)->bool {
+                return checkIOResult(pread(fd, &ret, sizeof ret, op.addr), sizeof ret, cpu);
+            }, [&](const uint64_t value)->bool {
+                return checkIOResult(pwrite(fd, &value, sizeof value, op.addr), sizeof value, cpu);
+            });
+
+            // cpu went offline, skip the rest of its ops
+            if (!op.ok && getMsrFd(cpu) < 0)
+                fd = -1;
+        }
+
+        return batch.allOk();
     }
 }
@@ -17,30 +17,36 @@
  */
 #pragma once
 
-#include <QHash>
+#include <sys/types.h>
+#include <QList>
+#include <QMutex>
 
 #include "../../MSR.h"
 
 namespace PWTD::LNX {
     class MSRLinux final: public MSR {
     private:
-        struct msrFD final {
-            int fd;
-            int openCount;
-        };
-
-        QHash<int, msrFD> msrFDMap;
+        // fds are kept open until the cpu goes offline
+        // sized once for all possible cpus, each slot is only touched by the thread working on that cpu
+        mutable QList<int> msrFDList;
+        QMutex moduleMutex;
         bool moduleLoaded = false;
 
         [[nodiscard]] bool loadMsrModule();
-        void addSlotForCPU(int cpu);
+        [[nodiscard]] int getMsrFd(int cpu) const;
+        void dropMsrFd(int cpu) const;
+        [[nodiscard]] bool checkIOResult(ssize_t ret, size_t expected, int cpu) const;
 
     public:
+        MSRLinux();
+        ~MSRLinux() override;
+
         [[nodiscard]] bool openMsrFd(int cpu) override;
         [[nodiscard]] bool readMSR(uint64_t &ret, uint32_t adr, int cpu) const override;
         [[nodiscard]] bool readMSR(uint32_t &ret, uint32_t adr, int cpu) const override;
         [[nodiscard]] bool writeMSR(uint64_t value, uint32_t adr, int cpu) const override;
         [[nodiscard]] bool writeMSR(uint32_t value, uint32_t adr, int cpu) const override;
         void closeMsrFd(int cpu) override;
+        [[nodiscard]] bool runBatch(MSRBatch &batch) override;
     };
 }
@@ -64,4 +64,27 @@ namespace PWTD::WIN {
     bool MSRWindows::writeMSR(const uint64_t value, const uint32_t adr, const int cpu) const {
         return isDriverOpen && WrmsrTx(adr, value & 0x00000000ffffffff, value >> 32, 1ULL << cpu);
     }
+
+    bool MSRWindows::runBatch(MSRBatch &batch) {
+        QList<MSROp> &ops = batch.getOps();
+
+        if (!ops.isEmpty() && !openMsrFd(0)) {
+            for (MSROp &op: ops)
+                op.ok = false;
+
+            return false;
+        }
+
+        for (const int i: batch.getCPUOrder()) {
+            MSROp &op = ops[i];
+
+            op.ok = runOp(op, [&](uint64_t &ret)->bool {
+                return readMSR(ret, op.addr, op.cpu);
+            }, [&](const uint64_t value)->bool {
+                return writeMSR(value, op.addr, op.cpu);
+            });
+        }
+
+        return batch.allOk();
+    }
 }
@@ -27,6 +27,7 @@ namespace PWTD::WIN {
     public:
         [[nodiscard]] bool openMsrFd(int cpu) override;
         void closeMsrFd(int cpu) override;
+        [[nodiscard]] bool runBatch(MSRBatch &batch) override;
         [[nodiscard]] bool readMSR(uint64_t &ret, uint32_t adr, int cpu) const override;
         [[nodiscard]] bool readMSR(uint32_t &ret, uint32_t adr, int cpu) const override;
         [[nodiscard]] bool writeMSR(uint64_t value, uint32_t adr, int cpu) const override;
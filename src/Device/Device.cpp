@@ -16,18 +16,22 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <QCryptographicHash>
+#include <QDateTime>
 
 #include "Device.h"
 #include "CPU/CPUDeviceFactory.h"
 #include "GPU/GPUDeviceFactory.h"
 #include "FAN/FANFactory.h"
 #include "OS/OSFactory.h"
+#include "../Utils/DaemonUtils.h"
+#include "pwtShared/Utils.h"
 
 namespace PWTD {
     Device::Device() {
         QSharedPointer<PWTS::CpuInfo> cpuInfo;
 
         logger = FileLogger::getInstance();
+        applyEngine = ApplyEngine::getInstance();
         os = OSFactory::getOS();
 
         if (!os->setupOSAccess() && logger->isLevel(PWTS::LogLevel::Error))
@@ -143,6 +147,9 @@ namespace PWTD {
     }
 
     void Device::prepareForSleep() const {
+        applyEngine->reset(); // hardware state is lost on sleep
+        applyEngine->clearBaseline();
+
         if (os->setupOSAccess()) {
             for (const QSharedPointer<FANDevice> &fan: fans)
                 fan->prepareForSleep();
@@ -173,13 +180,71 @@ namespace PWTD {
             fanCurveTimer->start();
     }
 
-    QSet<PWTS::DError> Device::applySettings(const PWTS::ClientPacket &packet) const {
+    // without perCpu only package level sources are read, no per cpu msr reads and no smu command when the os has a sensor
+    TelemetrySample Device::getTelemetrySample(const bool perCpu) const {
+        TelemetrySample sample;
+
+        sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+
+        if (!os->setupOSAccess()) {
+            if (logger->isLevel(PWTS::LogLevel::Error))
+                logger->write(QStringLiteral("failed to setup os access"));
+
+            return sample;
+        }
+
+        const PWTS::ROData<int> osTemp = perCpu ? PWTS::ROData<int>() : os->getCPUPackageTemperature();
+        const PWTS::ROData<int> temp = osTemp.isValid() ? osTemp : cpu->getTemperature();
+
+        if (temp.isValid())
+            sample.packageTemp = temp.getValue();
+
+        sample.domainPower = cpu->getPower(perCpu ? coreIdxList : QList<int>());
+        sample.packagePower = sample.domainPower.value(QStringLiteral("package"), TelemetrySample::Unavailable);
+
+        const FrequencySample freqSample = perCpu ? cpu->getFrequencySample() : FrequencySample();
+
+        if (!freqSample.effectiveFrequency.isEmpty()) {
+            sample.cpuFrequency = freqSample.effectiveFrequency;
+            sample.c0Residency = freqSample.c0Residency;
+            sample.frequencySamplingCost = static_cast<int>(freqSample.costNsecs / 1000);
+        } else {
+            sample.cpuFrequency = os->getCPUCurrentFrequency(cpu->getCpuInfo()->numLogicalCpus);
+        }
+
+        for (const QSharedPointer<FANDevice> &fan: fans) {
+            const PWTS::ROData<int> speed = os->getFanSpeed(fan->getControls());
+
+            sample.fanSpeed.insert(fan->getID(), speed.isValid() ? speed.getValue() : TelemetrySample::Unavailable);
+        }
+
+        os->unsetOSAccess();
+        return sample;
+    }
+
+    PMTableSnapshot Device::getPMTableSnapshot(const int maxStaleness) const {
+        if (!os->setupOSAccess()) {
+            if (logger->isLevel(PWTS::LogLevel::Error))
+                logger->write(QStringLiteral("failed to setup os access"));
+
+            return {};
+        }
+
+        const PMTableSnapshot snapshot = cpu->getPMTableSnapshot(maxStaleness);
+
+        os->unsetOSAccess();
+        return snapshot;
+    }
+
+    QSet<PWTS::DError> Device::applyPacket(const PWTS::ClientPacket &packet, const bool differential) const {
         if (!fanCurveTimer.isNull())
             fanCurveTimer->stop();
 
         QSet<PWTS::DError> errors;
         bool hasFanCurve = false;
 
+        applyEngine->begin(differential);
+
         if (!os->setupOSAccess())
             errors.insert(PWTS::DError::OS_ACCESS_FAIL);
 
@@ -201,14 +266,104 @@ namespace PWTD {
         }
 
         os->unsetOSAccess();
+        applyEngine->end();
         setupFanCurveTimer(hasFanCurve);
 
+        if (logger->isLevel(PWTS::LogLevel::Info))
+            logger->write(QString("apply: %1 writes issued, %2 skipped").arg(applyEngine->getWritesIssued()).arg(applyEngine->getWritesSkipped()));
+
         if (!fanCurveTimer.isNull())
             onFanCurveTimerTimeout(); // apply curve immediately
 
         return errors;
     }
 
+    // run the apply path with the current hardware state as target, the engine records it without writing
+    // only targets the client packet set in the last apply pass are kept, see ApplyEngine::endObserve
+    // fans are left out, their speed is driven by the fan curve timer
+    QHash<quint64, QByteArray> Device::observeSettings(const PWTS::ClientPacket &packet) const {
+        PWTS::DaemonPacket current;
+        PWTS::ClientPacket observed = packet;
+
+        fillPacketDeviceData(current);
+
+        if (!packet.intelData.isNull())
+            observed.intelData = current.intelData;
+
+        if (!packet.amdData.isNull())
+            observed.amdData = current.amdData;
+
+        if (!packet.linuxData.isNull())
+            observed.linuxData = current.linuxData;
+
+        if (!packet.linuxAmdData.isNull())
+            observed.linuxAmdData = current.linuxAmdData;
+
+        applyEngine->beginObserve();
+
+        if (os->setupOSAccess()) {
+            QSet<PWTS::DError> errors = cpu->applySettings(deviceFeatures.cpu, coreIdxList, observed);
+
+            // windows os settings don't go through the apply engine
+            if (isLinux())
+                errors.unite(os->applySettings(deviceFeatures, cpu->getCpuInfo()->vendor, cpu->getCpuInfo()->numLogicalCpus, coreIdxList, observed));
+
+            os->unsetOSAccess();
+
+            if (!errors.isEmpty() && logger->isLevel(PWTS::LogLevel::Error))
+                logger->write(QString("observe: %1 errors in read back data").arg(errors.size()));
+
+        } else if (logger->isLevel(PWTS::LogLevel::Error)) {
+            logger->write(QStringLiteral("failed to setup os access"));
+        }
+
+        return applyEngine->endObserve();
+    }
+
+    QSet<PWTS::DError> Device::applySettings(const PWTS::ClientPacket &packet, const bool differential) const {
+        applyEngine->clearBaseline(); // new target or forced apply, take a new baseline on next reconcile
+
+        return applyPacket(packet, differential);
+    }
+
+    QSet<PWTS::DError> Device::reconcileSettings(const PWTS::ClientPacket &packet, int &driftCount) const {
+        QSet<PWTS::DError> errors;
+
+        driftCount = 0;
+
+        if (!applyEngine->isReconcileEnabled())
+            return applySettings(packet, false);
+
+        if (!applyEngine->hasBaseline()) {
+            errors = applyPacket(packet, false);
+
+            applyEngine->setBaseline(observeSettings(packet));
+            return errors;
+        }
+
+        const QList<quint64> drifted = applyEngine->markDrifted(observeSettings(packet));
+
+        driftCount = drifted.size();
+        errors = applyPacket(packet, true);
+
+        if (drifted.isEmpty())
+            return errors;
+
+        if (logger->isLevel(PWTS::LogLevel::Info)) {
+            const QHash<quint64, ApplyEngine::DriftStat> stats = applyEngine->getDriftStats();
+
+            for (const quint64 key: drifted) {
+                const ApplyEngine::DriftStat stat = stats.value(key);
+
+                logger->write(QString("drift: %1 [%2], %3 times, %4s since last drift").arg(PWTS::getErrorStr(ApplyEngine::getKeyTarget(key))).arg(ApplyEngine::getKeyIndex(key))
+                                  .arg(stat.count).arg(stat.lastInterval / 1000));
+            }
+        }
+
+        applyEngine->setBaseline(observeSettings(packet));
+        return errors;
+    }
+
     void Device::onFanCurveTimerTimeout() const {
         const bool logErrorLev = logger->isLevel(PWTS::LogLevel::Error);
 
@@ -22,6 +22,9 @@
 #include "CPU/CPUDevice.h"
 #include "GPU/GPUDevice.h"
 #include "FAN/FANDevice.h"
+#include "ApplyEngine.h"
+#include "Telemetry/TelemetrySample.h"
+#include "Telemetry/PMTableSnapshot.h"
 #include "../Utils/FileLogger/FileLogger.h"
 
 namespace PWTD {
@@ -31,6 +34,7 @@ namespace PWTD {
     private:
         inline static QSharedPointer<Device> instance;
         QSharedPointer<FileLogger> logger;
+        QSharedPointer<ApplyEngine> applyEngine;
         QSharedPointer<CPUDevice> cpu;
         QList<QSharedPointer<GPUDevice>> gpus;
         QList<QSharedPointer<FANDevice>> fans;
@@ -42,6 +46,8 @@ namespace PWTD {
         Device();
 
         void setupFanCurveTimer(bool enable) const;
+        [[nodiscard]] QSet<PWTS::DError> applyPacket(const PWTS::ClientPacket &packet, bool differential) const;
+        [[nodiscard]] QHash<quint64, QByteArray> observeSettings(const PWTS::ClientPacket &packet) const;
 
     public:
         Device(const Device &) = delete;
@@ -60,7 +66,11 @@ namespace PWTD {
         [[nodiscard]] QMap<QString, QString> getFanLabelsMap() const;
         void prepareForSleep() const;
         void fillPacketDeviceData(PWTS::DaemonPacket &packet) const;
-        [[nodiscard]] QSet<PWTS::DError> applySettings(const PWTS::ClientPacket &packet) const;
+        [[nodiscard]] TelemetrySample getTelemetrySample(bool perCpu) const;
+        [[nodiscard]] PMTableSnapshot getPMTableSnapshot(int maxStaleness) const;
+        [[nodiscard]] QSet<PWTS::DError> applySettings(const PWTS::ClientPacket &packet, bool differential = true) const;
+        [[nodiscard]] QSet<PWTS::DError> reconcileSettings(const PWTS::ClientPacket &packet, int &driftCount) const;
+        [[nodiscard]] bool isReconcileEnabled() const { return applyEngine->isReconcileEnabled(); }
 
     private slots:
         void onFanCurveTimerTimeout() const;
@@ -20,6 +20,7 @@
 namespace PWTD {
     FANDevice::FANDevice(const QSharedPointer<OS> &os, const QString &id) {
         logger = FileLogger::getInstance();
+        applyEngine = ApplyEngine::getInstance();
         this->os = os;
         this->id = id;
     }
@@ -57,10 +58,12 @@ namespace PWTD {
             return a.first < b.first;
         });
 
-        if (!os->setFanMode(control, data.mode))
+        if (!applyEngine->apply(PWTS::DError::W_FAN_MODE, id, data.mode, [&]()->bool { return os->setFanMode(control, data.mode); }))
             errors.insert(PWTS::DError::W_FAN_MODE);
 
-        if (curve.size() == 1 && !os->setFanSpeed(control, curve[0].second))
+        if (curve.size() > 1) // speed is driven by the curve
+            applyEngine->invalidate(PWTS::DError::W_FAN_SPEED, id);
+        else if (curve.size() == 1 && !applyEngine->apply(PWTS::DError::W_FAN_SPEED, id, curve[0].second, [&]()->bool { return os->setFanSpeed(control, curve[0].second); }))
             errors.insert(PWTS::DError::W_FAN_SPEED);
 
         return errors;
@@ -20,12 +20,14 @@
 #include "Include/FanControls.h"
 #include "Include/FanType.h"
 #include "../OS/OS.h"
+#include "../ApplyEngine.h"
 
 namespace PWTD {
     class FANDevice {
     private:
         QSharedPointer<FileLogger> logger;
         QSharedPointer<OS> os;
+        QSharedPointer<ApplyEngine> applyEngine;
         QList<std::pair<int, int>> curve;
         QString id;
 
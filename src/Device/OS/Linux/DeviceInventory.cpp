@@ -0,0 +1,178 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+extern "C" {
+#include <pci/pci.h>
+}
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include "DeviceInventory.h"
+
+namespace PWTD::LNX {
+    DeviceInventory::DeviceInventory() {
+        sockaddr_nl addr {};
+
+        ueventFd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+        if (ueventFd < 0)
+            return;
+
+        // group 1 is the kernel broadcast, udev rebroadcasts on group 2
+        addr.nl_family = AF_NETLINK;
+        addr.nl_groups = 1;
+
+        if (bind(ueventFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close(ueventFd);
+            ueventFd = -1;
+        }
+    }
+
+    DeviceInventory::~DeviceInventory() {
+        if (ueventFd >= 0)
+            close(ueventFd);
+
+        if (pciAccess != nullptr)
+            pci_cleanup(pciAccess);
+    }
+
+    DeviceInventory::UEvent DeviceInventory::parseUEvent(const QByteArrayView msg) {
+        UEvent event {};
+        qsizetype pos = msg.indexOf('\0');
+
+        // kernel messages start with action@devpath, anything else is not ours
+        if (pos <= 0 || !msg.first(pos).contains('@'))
+            return event;
+
+        while (++pos < msg.size()) {
+            qsizetype end = msg.indexOf('\0', pos);
+
+            if (end < 0)
+                end = msg.size();
+
+            const QByteArrayView field = msg.sliced(pos, end - pos);
+
+            if (field.startsWith("ACTION="))
+                event.action = field.sliced(7);
+            else if (field.startsWith("DEVPATH="))
+                event.devpath = field.sliced(8);
+            else if (field.startsWith("SUBSYSTEM="))
+                event.subsystem = field.sliced(10);
+
+            pos = end;
+        }
+
+        return event;
+    }
+
+    quint32 DeviceInventory::getSourcesForUEvent(const UEvent &event) {
+        // change events only update attributes, the entries stay the same
+        if (event.action.isEmpty() || event.action == "change")
+            return 0;
+
+        if (event.subsystem == "block")
+            return static_cast<quint32>(Source::BlockQueue) | static_cast<quint32>(Source::Disk);
+        else if (event.subsystem == "scsi" || event.subsystem == "scsi_disk")
+            return static_cast<quint32>(Source::Disk);
+        else if (event.subsystem == "i2c")
+            return static_cast<quint32>(Source::I2c);
+        else if (event.subsystem == "pci" || event.subsystem == "ata_port")
+            return static_cast<quint32>(Source::PCI);
+        else if (event.subsystem == "usb")
+            return static_cast<quint32>(Source::USB);
+        else if (event.subsystem == "cpu")
+            return static_cast<quint32>(Source::CPU);
+        else if (event.subsystem == "drm")
+            return static_cast<quint32>(Source::DRM);
+
+        return 0;
+    }
+
+    void DeviceInventory::sync() {
+        char buf[8192];
+
+        if (ueventFd < 0) {
+            dirty = allSources;
+            return;
+        }
+
+        while (true) {
+            sockaddr_nl sender {};
+            socklen_t senderLen = sizeof(sender);
+            const ssize_t len = recvfrom(ueventFd, buf, sizeof(buf), MSG_DONTWAIT, reinterpret_cast<sockaddr *>(&sender), &senderLen);
+
+            if (len < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                // the socket buffer overflowed and events were lost, rescan everything
+                if (errno == ENOBUFS) {
+                    dirty = allSources;
+                    continue;
+                }
+
+                break;
+            }
+
+            if (sender.nl_pid != 0)
+                continue;
+
+            dirty |= getSourcesForUEvent(parseUEvent(QByteArrayView(buf, len)));
+        }
+    }
+
+    bool DeviceInventory::takeDirty(const Source source) {
+        const quint32 bit = static_cast<quint32>(source);
+        const bool ret = (dirty & bit) != 0;
+
+        dirty &= ~bit;
+        return ret;
+    }
+
+    QString DeviceInventory::getPCIName(const quint16 vendorID, const quint16 deviceID) {
+        const quint32 key = (static_cast<quint32>(vendorID) << 16) | deviceID;
+        const auto it = pciNames.constFind(key);
+        char nameBuf[1024] = {};
+
+        if (it != pciNames.constEnd())
+            return it.value();
+
+        if (!pciAccessInit) {
+            pciAccessInit = true;
+            pciAccess = pci_alloc();
+
+            if (pciAccess != nullptr)
+                pci_init(pciAccess);
+        }
+
+        if (pciAccess == nullptr)
+            return {};
+
+        pci_lookup_name(pciAccess, nameBuf, sizeof(nameBuf), PCI_LOOKUP_VENDOR | PCI_LOOKUP_DEVICE, vendorID, deviceID);
+        pciNames.insert(key, QString(nameBuf));
+
+        return pciNames[key];
+    }
+
+    const QList<DeviceInventory::MiscPMEntry> &DeviceInventory::getMiscPMDevices(const Source source) const {
+        static const QList<MiscPMEntry> empty;
+        const auto it = miscPMDevices.constFind(source);
+
+        return it != miscPMDevices.constEnd() ? it.value() : empty;
+    }
+}
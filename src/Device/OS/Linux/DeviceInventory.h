@@ -0,0 +1,89 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QByteArrayView>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+struct pci_access;
+
+namespace PWTD::LNX {
+    // cached list of block and runtime pm capable devices, rescanned only when a kernel uevent reports a change
+    // the uevent socket is drained at poll time, no extra thread or event loop is needed
+    class DeviceInventory final {
+    public:
+        enum class Source: quint32 {
+            BlockQueue = 1 << 0, // block devices with a queue scheduler
+            I2c = 1 << 1,
+            PCI = 1 << 2,
+            Disk = 1 << 3, // sd* disks runtime pm
+            USB = 1 << 4,
+            CPU = 1 << 5,
+            DRM = 1 << 6
+        };
+
+        struct BlockEntry {
+            QString device;
+            QString name;
+            QString schedulerPath;
+        };
+
+        struct MiscPMEntry {
+            QString name;
+            QString controlPath;
+            QString runtimePMPath; // empty if the device does not need the runtime pm check
+        };
+
+        struct UEvent {
+            QByteArrayView action;
+            QByteArrayView devpath;
+            QByteArrayView subsystem;
+        };
+
+    private:
+        static constexpr quint32 allSources = 0x7f;
+        QList<BlockEntry> blockDevices;
+        QMap<Source, QList<MiscPMEntry>> miscPMDevices;
+        QHash<quint32, QString> pciNames;
+        struct pci_access *pciAccess = nullptr;
+        bool pciAccessInit = false;
+        quint32 dirty = allSources;
+        int ueventFd = -1;
+
+    public:
+        DeviceInventory();
+        DeviceInventory(const DeviceInventory &) = delete;
+        DeviceInventory &operator=(const DeviceInventory &) = delete;
+
+        ~DeviceInventory();
+
+        [[nodiscard]] static UEvent parseUEvent(QByteArrayView msg);
+        [[nodiscard]] static quint32 getSourcesForUEvent(const UEvent &event);
+        [[nodiscard]] bool isListening() const { return ueventFd >= 0; }
+        void sync();
+        [[nodiscard]] bool takeDirty(Source source);
+        [[nodiscard]] QString getPCIName(quint16 vendorID, quint16 deviceID);
+        [[nodiscard]] const QList<BlockEntry> &getBlockDevices() const { return blockDevices; }
+        [[nodiscard]] const QList<MiscPMEntry> &getMiscPMDevices(Source source) const;
+        void setBlockDevices(const QList<BlockEntry> &list) { blockDevices = list; }
+        void setMiscPMDevices(const Source source, const QList<MiscPMEntry> &list) { miscPMDevices.insert(source, list); }
+    };
+}
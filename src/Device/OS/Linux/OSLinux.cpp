@@ -15,15 +15,36 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-extern "C" {
-#include <pci/pci.h>
-}
 #include <sys/sysinfo.h>
+#include <algorithm>
+#include <cstring>
 #include <QDir>
 
 #include "OSLinux.h"
 
 namespace PWTD::LNX {
+    OSLinux::OSLinux() {
+        const long numCpus = sysconf(_SC_NPROCESSORS_CONF);
+        QList<int> policyIds;
+
+        cpufreqPolicies = getCPUFreqPolicies();
+
+        for (const CPUFreqPolicy &policy: std::as_const(cpufreqPolicies))
+            policyIds.append(policy.id);
+
+        sysfsPaths.buildGlobal(sysfsCPU);
+        sysfsPaths.buildCPUs(sysfsCPU, numCpus > 0 ? numCpus : 1);
+        sysfsPaths.buildPolicies(sysfsCPUFreq, policyIds);
+        sysfsPaths.buildGPUs(sysfsDRM, getGPUIndexList());
+        cpuTempInputPath = getCPUTempInputPath();
+#ifdef WITH_GPD_FAN
+        sysfsPaths.buildFan(sysfsGpdfan, getGPDFanHWMon());
+#endif
+
+        if (!deviceInventory.isListening() && logger->isLevel(PWTS::LogLevel::Warning))
+            logger->write("uevent listener unavailable, devices will be rescanned on every update");
+    }
+
     bool OSLinux::setupOSAccess() const {
         return true;
     }
@@ -43,7 +64,7 @@ namespace PWTD::LNX {
         if (QDir(QString("%1cpufreq").arg(sysfsCPU)).exists())
             features.unite({PWTS::Feature::CPUFREQ_SYSFS, PWTS::Feature::SYSFS_GROUP});
 
-        if (QFile::exists(QString("%1current_governor").arg(sysfsCPUIdle)))
+        if (QFile::exists(QFile::decodeName(sysfsPaths.global(SysfsPaths::Global::CPUIdleCurrentGovernor))))
             features.unite({PWTS::Feature::CPUIDLE_GOV_SYSFS, PWTS::Feature::SYSFS_GROUP});
 
 #ifdef WITH_AMD
@@ -189,6 +210,7 @@ namespace PWTD::LNX {
     void OSLinux::fillDaemonPacket(const PWTS::Features &features, const PWTS::CPUVendor cpuVendor, const int numLogicalCPUs, PWTS::DaemonPacket &packet) const {
         packet.linuxData = QSharedPointer<PWTS::LNX::LinuxData>::create();
 
+        syncDeviceInventory();
         fillPackageData(features, packet);
 
         for (int i=0; i<numLogicalCPUs; ++i)
@@ -204,10 +226,10 @@ namespace PWTD::LNX {
         if (!features.contains(PWTS::Feature::INTEL_GPU_SYSFS_GROUP) || !packet.linuxData->intelGpuData.contains(index))
             return;
 
-        if (features.contains(PWTS::Feature::INTEL_GPU_RPS_FREQ_SYSFS) && !setIntelGPUFrequency(index, packet.linuxData->intelGpuData[index].frequency))
+        if (features.contains(PWTS::Feature::INTEL_GPU_RPS_FREQ_SYSFS) && !applyEngine->apply(PWTS::DError::W_INTEL_GPU_FREQ, index, packet.linuxData->intelGpuData[index].frequency, [&]()->bool { return setIntelGPUFrequency(index, packet.linuxData->intelGpuData[index].frequency); }))
             errors.insert(PWTS::DError::W_INTEL_GPU_FREQ);
 
-        if (features.contains(PWTS::Feature::INTEL_GPU_BOOST_SYSFS) && !setIntelGPUBoost(index, packet.linuxData->intelGpuData[index].boostFrequency))
+        if (features.contains(PWTS::Feature::INTEL_GPU_BOOST_SYSFS) && !applyEngine->apply(PWTS::DError::W_INTEL_GPU_BOOST, index, packet.linuxData->intelGpuData[index].boostFrequency, [&]()->bool { return setIntelGPUBoost(index, packet.linuxData->intelGpuData[index].boostFrequency); }))
             errors.insert(PWTS::DError::W_INTEL_GPU_BOOST);
     }
 
@@ -215,10 +237,10 @@ namespace PWTD::LNX {
         if (!features.contains(PWTS::Feature::AMD_GPU_SYSFS_GROUP) || !packet.linuxData->amdGpuData.contains(index))
             return;
 
-        if (features.contains(PWTS::Feature::AMD_GPU_DPM_FORCE_PERF_LEVEL_SYSFS) && !setAMDGPUDpmForcePerfLevel(index, packet.linuxData->amdGpuData[index].dpmForcePerfLevel))
+        if (features.contains(PWTS::Feature::AMD_GPU_DPM_FORCE_PERF_LEVEL_SYSFS) && !applyEngine->apply(PWTS::DError::W_AMD_GPU_DPM_FORCE_PERF_LEVEL, index, packet.linuxData->amdGpuData[index].dpmForcePerfLevel, [&]()->bool { return setAMDGPUDpmForcePerfLevel(index, packet.linuxData->amdGpuData[index].dpmForcePerfLevel); }))
             errors.insert(PWTS::DError::W_AMD_GPU_DPM_FORCE_PERF_LEVEL);
 
-        if (features.contains(PWTS::Feature::AMD_GPU_POWER_DPM_STATE_SYSFS) && !setAMDGPUPowerDpmState(index, packet.linuxData->amdGpuData[index].powerDpmState))
+        if (features.contains(PWTS::Feature::AMD_GPU_POWER_DPM_STATE_SYSFS) && !applyEngine->apply(PWTS::DError::W_AMD_GPU_POWER_DPM_STATE, index, packet.linuxData->amdGpuData[index].powerDpmState, [&]()->bool { return setAMDGPUPowerDpmState(index, packet.linuxData->amdGpuData[index].powerDpmState); }))
             errors.insert(PWTS::DError::W_AMD_GPU_POWER_DPM_STATE);
     }
 
@@ -230,10 +252,11 @@ namespace PWTD::LNX {
             errors.insert(PWTS::DError::W_MISC_PM_DEVICES);
 
         if (features.cpu.contains(PWTS::Feature::SYSFS_GROUP)) {
-            if (features.cpu.contains(PWTS::Feature::CPU_SMT_SYSFS) && !setSMT(packet.linuxData->smtState))
+            // cpus going offline lose their per-cpu state, rewrite everything after this
+            if (features.cpu.contains(PWTS::Feature::CPU_SMT_SYSFS) && !applyEngine->apply(PWTS::DError::W_CPU_SMT, packet.linuxData->smtState, [&]()->bool { applyEngine->requestReset(); return setSMT(packet.linuxData->smtState); }))
                 errors.insert(PWTS::DError::W_CPU_SMT);
 
-            if (features.cpu.contains(PWTS::Feature::CPUIDLE_GOV_SYSFS) && !setCPUIdleGovernor(packet.linuxData->cpuIdleGovernor))
+            if (features.cpu.contains(PWTS::Feature::CPUIDLE_GOV_SYSFS) && !applyEngine->apply(PWTS::DError::W_CPU_IDLE_GOV, packet.linuxData->cpuIdleGovernor, [&]()->bool { return setCPUIdleGovernor(packet.linuxData->cpuIdleGovernor); }))
                 errors.insert(PWTS::DError::W_CPU_IDLE_GOV);
         }
 
@@ -257,14 +280,76 @@ namespace PWTD::LNX {
 
         const PWTS::LNX::LinuxThreadData &data = packet.linuxData->threadData[cpu];
 
-        if (features.contains(PWTS::Feature::CPU_PARK_SYSFS) && !setCPUOnlineStatus(cpu, data.cpuOnlineStatus))
+        // only this cpu loses its state
+        if (features.contains(PWTS::Feature::CPU_PARK_SYSFS) && !applyEngine->apply(PWTS::DError::W_CPUS_ONLINE, cpu, data.cpuOnlineStatus, [&]()->bool { applyEngine->invalidateIndex(cpu); return setCPUOnlineStatus(cpu, data.cpuOnlineStatus); }))
             errors.insert(PWTS::DError::W_CPUS_ONLINE);
+    }
+
+    // cpus sharing a policy get one write to policyN when the packet agrees for all of them, per cpu writes otherwise
+    // engine keys stay per cpu, the first stale cpu writes the policy and the others reuse the result
+    void OSLinux::applyCPUFreqSettings(const int numLogicalCPUs, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const {
+        if (!features.contains(PWTS::Feature::SYSFS_GROUP) || !features.contains(PWTS::Feature::CPUFREQ_SYSFS))
+            return;
+
+        const QList<PWTS::LNX::LinuxThreadData> &threadData = packet.linuxData->threadData;
+        QList<bool> freqDone (numLogicalCPUs, false);
+        QList<bool> govDone (numLogicalCPUs, false);
+
+        for (const CPUFreqPolicy &policy: cpufreqPolicies) {
+            if (std::ranges::any_of(policy.cpus, [&](const int cpu) { return cpu >= numLogicalCPUs; }))
+                continue;
+
+            const PWTS::RWData<PWTS::MinMax> &freq = threadData[policy.cpus.first()].cpuFrequency;
+            const PWTS::RWData<QString> &gov = threadData[policy.cpus.first()].scalingGovernor;
+            const bool sameFreq = freq.isValid() && std::ranges::all_of(policy.cpus, [&](const int cpu) {
+                const PWTS::RWData<PWTS::MinMax> &cpuFreq = threadData[cpu].cpuFrequency;
+
+                return cpuFreq.isValid() && cpuFreq.getValue().min == freq.getValue().min && cpuFreq.getValue().max == freq.getValue().max;
+            });
+            const bool sameGov = gov.isValid() && std::ranges::all_of(policy.cpus, [&](const int cpu) {
+                return threadData[cpu].scalingGovernor.isValid() && threadData[cpu].scalingGovernor.getValue() == gov.getValue();
+            });
 
-        if (features.contains(PWTS::Feature::CPUFREQ_SYSFS)) {
-            if (!setCPUFrequency(cpu, data.cpuFrequency))
+            if (sameFreq) {
+                std::optional<bool> res;
+
+                for (const int cpu: policy.cpus) {
+                    if (!applyEngine->apply(PWTS::DError::W_CPU_FREQ_MIN_MAX, cpu, freq, [&]()->bool {
+                        if (!res.has_value())
+                            res = setCPUFrequency(sysfsPaths.policy(policy.id, SysfsPaths::Policy::ScalingMinFreq), sysfsPaths.policy(policy.id, SysfsPaths::Policy::ScalingMaxFreq), freq);
+
+                        return res.value();
+                    }))
+                        errors.insert(PWTS::DError::W_CPU_FREQ_MIN_MAX);
+
+                    freqDone[cpu] = true;
+                }
+            }
+
+            if (sameGov) {
+                std::optional<bool> res;
+
+                for (const int cpu: policy.cpus) {
+                    if (!applyEngine->apply(PWTS::DError::W_CPU_SCALING_GOV, cpu, gov, [&]()->bool {
+                        if (!res.has_value())
+                            res = setCPUScalingGovernor(sysfsPaths.policy(policy.id, SysfsPaths::Policy::ScalingGovernor), gov);
+
+                        return res.value();
+                    }))
+                        errors.insert(PWTS::DError::W_CPU_SCALING_GOV);
+
+                    govDone[cpu] = true;
+                }
+            }
+        }
+
+        for (int cpu=0; cpu<numLogicalCPUs; ++cpu) {
+            const PWTS::LNX::LinuxThreadData &data = threadData[cpu];
+
+            if (!freqDone[cpu] && !applyEngine->apply(PWTS::DError::W_CPU_FREQ_MIN_MAX, cpu, data.cpuFrequency, [&]()->bool { return setCPUFrequency(sysfsPaths.cpu(cpu, SysfsPaths::CPU::ScalingMinFreq), sysfsPaths.cpu(cpu, SysfsPaths::CPU::ScalingMaxFreq), data.cpuFrequency); }))
                 errors.insert(PWTS::DError::W_CPU_FREQ_MIN_MAX);
 
-            if (!setCPUScalingGovernor(cpu, data.scalingGovernor))
+            if (!govDone[cpu] && !applyEngine->apply(PWTS::DError::W_CPU_SCALING_GOV, cpu, data.scalingGovernor, [&]()->bool { return setCPUScalingGovernor(sysfsPaths.cpu(cpu, SysfsPaths::CPU::ScalingGovernor), data.scalingGovernor); }))
                 errors.insert(PWTS::DError::W_CPU_SCALING_GOV);
         }
     }
@@ -287,11 +372,15 @@ namespace PWTD::LNX {
             return errors;
         }
 
+        syncDeviceInventory();
         applyPackageSettings(features, packet, errors);
 
         for (int i=0; i<numLogicalCPUs; ++i)
             applyThreadSettings(i, features.cpu, packet, errors);
 
+        // after online status, offline cpus have no cpufreq
+        applyCPUFreqSettings(numLogicalCPUs, features.cpu, packet, errors);
+
 #ifdef WITH_AMD
         if (cpuVendor == PWTS::CPUVendor::AMD)
             applyAMDSettings(features.cpu, numLogicalCPUs, coreIdxList, packet, errors);
@@ -301,17 +390,37 @@ namespace PWTD::LNX {
     }
 
     QString OSLinux::readSysfs(const QString &path, const bool existsErrorLog) const {
-        QFile sysfsF {path};
+        return readSysfs(path.toLocal8Bit(), existsErrorLog);
+    }
+
+    QString OSLinux::readSysfs(const QByteArray &path, const bool existsErrorLog) const {
+        QString value;
+
+        switch (sysfsCache.read(path, value)) {
+            case SysfsCache::Result::Ok:
+                return value;
+            case SysfsCache::Result::Failed: {
+                if (logger->isLevel(PWTS::LogLevel::Error))
+                    logger->write(QString("failed to read '%1': %2").arg(QFile::decodeName(path), QString::fromLocal8Bit(std::strerror(sysfsCache.getLastError()))));
+
+                return "";
+            }
+            default:
+                break;
+        }
+
+        const QString filePath = QFile::decodeName(path);
+        QFile sysfsF {filePath};
 
         if (!sysfsF.exists()) {
             if (existsErrorLog && logger->isLevel(PWTS::LogLevel::Warning))
-                logger->write(QString("'%1' does not exist").arg(path));
+                logger->write(QString("'%1' does not exist").arg(filePath));
 
             return "";
 
         } else if (!sysfsF.open(ROTextOpenFlags)) {
             if (logger->isLevel(PWTS::LogLevel::Error))
-                logger->write(QString("failed to open '%1': %2").arg(path, sysfsF.errorString()));
+                logger->write(QString("failed to open '%1': %2").arg(filePath, sysfsF.errorString()));
 
             return "";
         }
@@ -320,13 +429,31 @@ namespace PWTD::LNX {
     }
 
     bool OSLinux::writeSysfs(const QString &path, const QString &value) const {
-        QFile sysfsF {path};
+        return writeSysfs(path.toLocal8Bit(), value);
+    }
+
+    bool OSLinux::writeSysfs(const QByteArray &path, const QString &value) const {
+        switch (sysfsCache.write(path, value.toUtf8())) {
+            case SysfsCache::Result::Ok:
+                return true;
+            case SysfsCache::Result::Failed: {
+                if (logger->isLevel(PWTS::LogLevel::Error))
+                    logger->write(QString("failed to write '%1': %2").arg(QFile::decodeName(path), QString::fromLocal8Bit(std::strerror(sysfsCache.getLastError()))));
+
+                return false;
+            }
+            default:
+                break;
+        }
+
+        const QString filePath = QFile::decodeName(path);
+        QFile sysfsF {filePath};
         QTextStream ts {&sysfsF};
         bool success;
 
         if (!sysfsF.open(WOTextOpenFlags)) {
             if (logger->isLevel(PWTS::LogLevel::Error))
-                logger->write(QString("failed to open '%1': %2").arg(path, sysfsF.errorString()));
+                logger->write(QString("failed to open '%1': %2").arg(filePath, sysfsF.errorString()));
 
             return false;
         }
@@ -337,19 +464,19 @@ namespace PWTD::LNX {
         success = ts.status() == QTextStream::Ok;
 
         if (!success && logger->isLevel(PWTS::LogLevel::Error))
-            logger->write(QString("failed to write '%1', status: %2").arg(path).arg(ts.status()));
+            logger->write(QString("failed to write '%1', status: %2").arg(filePath).arg(ts.status()));
 
         return success;
     }
 
     bool OSLinux::hasSMT() const {
-        const QString smt = readSysfs(sysfsSMT);
+        const QString smt = readSysfs(sysfsPaths.global(SysfsPaths::Global::SMTControl));
 
         return !smt.isEmpty() && smt != "notsupported";
     }
 
     PWTS::ROData<bool> OSLinux::hasCPULogicalOffFeature(const int cpu) const {
-        return PWTS::ROData<bool>(QFile::exists(QString("%1cpu%2/online").arg(sysfsCPU).arg(cpu)), true);
+        return PWTS::ROData<bool>(QFile::exists(QFile::decodeName(sysfsPaths.cpu(cpu, SysfsPaths::CPU::Online))), true);
     }
 
     bool OSLinux::deviceHasRuntimePM(const QString &path) const {
@@ -408,7 +535,7 @@ namespace PWTD::LNX {
     }
 
     QString OSLinux::getMicrocodeRevision(const int cpu) const {
-        return readSysfs(QString("%1cpu%2/microcode/version").arg(sysfsCPU).arg(cpu));
+        return readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::MicrocodeVersion));
     }
 
     quint64 OSLinux::getAvailableRam() const {
@@ -450,7 +577,7 @@ namespace PWTD::LNX {
     }
 
     PWTS::GPUVendor OSLinux::getGPUVendor(const int index) const {
-        const QString vendorID = readSysfs(QString("%1card%2/device/vendor").arg(sysfsDRM).arg(index)).toLower();
+        const QString vendorID = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::Vendor)).toLower();
 
         if (vendorID.isEmpty())
             return PWTS::GPUVendor::Unknown;
@@ -465,15 +592,15 @@ namespace PWTD::LNX {
     }
 
     QString OSLinux::getGPUDeviceID(const int index) const {
-        return readSysfs(QString("%1card%2/device/device").arg(sysfsDRM).arg(index));
+        return readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::DeviceID));
     }
 
     QString OSLinux::getGPURevisionID(const int index) const {
-        return readSysfs(QString("%1card%2/device/revision").arg(sysfsDRM).arg(index));
+        return readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::Revision));
     }
 
     QString OSLinux::getGPUVBiosVersion(const int index) const {
-        return readSysfs(QString("%1card%2/device/vbios_version").arg(sysfsDRM).arg(index));
+        return readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::VBiosVersion));
     }
 
     QString OSLinux::getFanControlPath(const FanBoard board) const {
@@ -562,7 +689,7 @@ namespace PWTD::LNX {
     }
 
     PWTS::ROData<int> OSLinux::getCoreID(const int cpu) const {
-        const QString coreID = readSysfs(QString("%1cpu%2/topology/core_id").arg(sysfsCPU).arg(cpu));
+        const QString coreID = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::CoreID));
         bool res;
         int id;
 
@@ -612,11 +739,54 @@ namespace PWTD::LNX {
         return coreMap.values();
     }
 
+    QList<int> OSLinux::getCPUCurrentFrequency(const int numLogicalCPUs) const {
+        QList<int> freqList;
+
+        freqList.reserve(numLogicalCPUs);
+
+        for (int i=0; i<numLogicalCPUs; ++i) {
+            const QString freq = readSysfs(sysfsPaths.cpu(i, SysfsPaths::CPU::ScalingCurFreq), false);
+            bool res;
+            const int freqI = freq.toInt(&res);
+
+            freqList.append(res ? (freqI / 1000) : TelemetrySample::Unavailable);
+        }
+
+        return freqList;
+    }
+
+    QList<OSLinux::CPUFreqPolicy> OSLinux::getCPUFreqPolicies() const {
+        const QList<QString> policyDirs = QDir(sysfsCPUFreq).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        QList<CPUFreqPolicy> ret;
+
+        for (const QString &dir: policyDirs) {
+            const QRegularExpressionMatch match = cpufreqPolicyFolderRex.match(dir);
+
+            if (!match.hasMatch())
+                continue;
+
+            const QString relatedCpus = readSysfs(QString("%1%2/related_cpus").arg(sysfsCPUFreq, dir));
+            CPUFreqPolicy policy {.id = match.captured(1).toInt()};
+
+            for (const QString &cpu: relatedCpus.split(u' ', Qt::SkipEmptyParts)) {
+                bool res;
+                const int cpuIdx = cpu.toInt(&res);
+
+                if (res)
+                    policy.cpus.append(cpuIdx);
+            }
+
+            if (!policy.cpus.isEmpty())
+                ret.append(policy);
+        }
+
+        return ret;
+    }
+
     PWTS::ROData<PWTS::LNX::CPUFrequencyLimits> OSLinux::getCPUFrequencyLimits(const int cpu) const {
-        const QString cpufreqPath = QString("%1cpu%2/cpufreq").arg(sysfsCPU).arg(cpu);
-        const QString minFreq = readSysfs(QString("%1/cpuinfo_min_freq").arg(cpufreqPath));
-        const QString maxFreq = readSysfs(QString("%1/cpuinfo_max_freq").arg(cpufreqPath));
-        const QString relatedCpus = readSysfs(QString("%1/related_cpus").arg(cpufreqPath));
+        const QString minFreq = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::CPUInfoMinFreq));
+        const QString maxFreq = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::CPUInfoMaxFreq));
+        const QString relatedCpus = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::RelatedCPUs));
         PWTS::LNX::CPUFrequencyLimits data;
         bool minRes, maxRes;
 
@@ -635,9 +805,8 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<PWTS::MinMax> OSLinux::getCPUFrequency(const int cpu) const {
-        const QString cpufreqPath = QString("%1cpu%2/cpufreq").arg(sysfsCPU).arg(cpu);
-        const QString minFreq = readSysfs(QString("%1/scaling_min_freq").arg(cpufreqPath));
-        const QString maxFreq = readSysfs(QString("%1/scaling_max_freq").arg(cpufreqPath));
+        const QString minFreq = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::ScalingMinFreq));
+        const QString maxFreq = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::ScalingMaxFreq));
         bool minRes, maxRes;
         int min, max;
 
@@ -654,23 +823,25 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<QString> OSLinux::getSMT() const {
-        const QString smt = readSysfs(sysfsSMT);
+        const QString smt = readSysfs(sysfsPaths.global(SysfsPaths::Global::SMTControl));
 
         return PWTS::RWData<QString>(smt, !smt.isEmpty());
     }
 
     PWTS::RWData<int> OSLinux::getCPUOnlineStatus(const int cpu) const {
-        QFile online {QString("%1cpu%2/online").arg(sysfsCPU).arg(cpu)};
-        const bool isValid = !online.exists() || online.open(ROTextOpenFlags);
-        const int isOn = !online.exists() || (online.isOpen() && QString::fromUtf8(online.readAll()).trimmed() == "1");
+        const QByteArray &onlinePath = sysfsPaths.cpu(cpu, SysfsPaths::CPU::Online);
+        const QString online = readSysfs(onlinePath, false);
+
+        // cpus that cannot go offline have no online attribute
+        if (online.isEmpty() && !QFile::exists(QFile::decodeName(onlinePath)))
+            return PWTS::RWData<int>(1, true);
 
-        return PWTS::RWData<int>(isOn, isValid);
+        return PWTS::RWData<int>(online == "1", !online.isEmpty());
     }
 
     PWTS::ROData<PWTS::LNX::CPUScalingAvailableGovernors> OSLinux::getCPUScalingAvailableGovernors(const int cpu) const {
-        const QString cpufreqPath = QString("%1cpu%2/cpufreq").arg(sysfsCPU).arg(cpu);
-        const QString availGovernors = readSysfs(QString("%1/scaling_available_governors").arg(cpufreqPath));
-        const QString relatedCpus = readSysfs(QString("%1/related_cpus").arg(cpufreqPath));
+        const QString availGovernors = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::ScalingAvailableGovernors));
+        const QString relatedCpus = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::RelatedCPUs));
         PWTS::LNX::CPUScalingAvailableGovernors data;
 
         if (availGovernors.isEmpty() || relatedCpus.isEmpty())
@@ -685,13 +856,13 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<QString> OSLinux::getCPUScalingGovernor(const int cpu) const {
-        const QString scalingGov = readSysfs(QString("%1cpu%2/cpufreq/scaling_governor").arg(sysfsCPU).arg(cpu));
+        const QString scalingGov = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::ScalingGovernor));
 
         return PWTS::RWData<QString>(scalingGov, !scalingGov.isEmpty());
     }
 
     PWTS::ROData<QList<QString>> OSLinux::getAvailableCPUIdleGovernors() const {
-        const QString availIdleGov = readSysfs(QString("%1available_governors").arg(sysfsCPUIdle));
+        const QString availIdleGov = readSysfs(sysfsPaths.global(SysfsPaths::Global::CPUIdleAvailableGovernors));
 
         if (availIdleGov.isEmpty())
             return {};
@@ -702,14 +873,24 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<QString> OSLinux::getCPUIdleGovernor() const {
-        const QString idleGov = readSysfs(QString("%1current_governor").arg(sysfsCPUIdle));
+        const QString idleGov = readSysfs(sysfsPaths.global(SysfsPaths::Global::CPUIdleCurrentGovernor));
 
         return PWTS::RWData<QString>(idleGov, !idleGov.isEmpty());
     }
 
-    QMap<QString, PWTS::LNX::BlockDeviceQueSched> OSLinux::getBlockDevices() const {
+    void OSLinux::syncDeviceInventory() const {
+        deviceInventory.sync();
+
+        if (deviceInventory.takeDirty(DeviceInventory::Source::CPU))
+            sysfsCache.invalidate(QByteArray(sysfsCPU));
+
+        if (deviceInventory.takeDirty(DeviceInventory::Source::DRM))
+            sysfsCache.invalidate(QByteArray(sysfsDRM));
+    }
+
+    QList<DeviceInventory::BlockEntry> OSLinux::scanBlockDevices() const {
         const QDirListing dit(sysfsBlock, QDirListing::IteratorFlag::DirsOnly | QDirListing::IteratorFlag::ResolveSymlinks);
-        QMap<QString, PWTS::LNX::BlockDeviceQueSched> blockDevs;
+        QList<DeviceInventory::BlockEntry> blockDevs;
 
         for (const QDirListing::DirEntry &entry: dit) {
             const QString devPath = entry.filePath();
@@ -721,81 +902,65 @@ namespace PWTD::LNX {
             const QString model = readSysfs(QString("%1/device/model").arg(devPath), false);
             const QString vendor = readSysfs(QString("%1/device/vendor").arg(devPath), false);
             const QString device = devPath.split('/', Qt::SkipEmptyParts).last().trimmed();
-            const QString scheduler = readSysfs(schedPath);
-            PWTS::LNX::BlockDeviceQueSched blkDev;
-
-            blkDev.name = QString("%1 %2").arg(vendor, model).trimmed();
-
-            for (const QString &sched: scheduler.split(' ', Qt::SkipEmptyParts)) {
-                const bool isSelected = sched.startsWith('[');
-
-                blkDev.availableQueueSchedulers.append(isSelected ? sched.mid(1, sched.size() - 2) : sched);
-
-                if (isSelected)
-                    blkDev.scheduler = blkDev.availableQueueSchedulers.last();
-            }
 
-            if (device.isEmpty() || blkDev.availableQueueSchedulers.isEmpty()) {
+            if (device.isEmpty()) {
                 if (logger->isLevel(PWTS::LogLevel::Error))
-                    logger->write(QString("invalid block device %1, or no schedulers available").arg(device));
+                    logger->write(QString("invalid block device %1").arg(devPath));
 
                 continue;
             }
 
-            blockDevs.insert(device, blkDev);
+            blockDevs.append({
+                .device = device,
+                .name = QString("%1 %2").arg(vendor, model).trimmed(),
+                .schedulerPath = schedPath
+            });
         }
 
         return blockDevs;
     }
 
-    QList<PWTS::LNX::MiscPMDevice> OSLinux::getMiscPMI2cDevices() const {
+    QList<DeviceInventory::MiscPMEntry> OSLinux::scanMiscPMI2cDevices() const {
         const QDirListing dit("/sys/bus/i2c/devices", QDirListing::IteratorFlag::DirsOnly | QDirListing::IteratorFlag::ResolveSymlinks);
-        QList<PWTS::LNX::MiscPMDevice> i2cDevs;
+        QList<DeviceInventory::MiscPMEntry> i2cDevs;
 
         for (const QDirListing::DirEntry &entry: dit) {
             const QString devPath = entry.filePath();
             const bool isAdapter = QFile::exists(QString("%1/new_device").arg(devPath));
             const QString controlPath = QString("%1/%2power/control").arg(devPath, isAdapter ? "device/":"");
             const QString name = readSysfs(QString("%1/name").arg(devPath), false);
-            const QString control = readSysfs(controlPath, false);
 
-            if (name.isEmpty() || control.isEmpty() || !deviceHasRuntimePM(QString("%1/device").arg(devPath)))
+            if (name.isEmpty() || !QFile::exists(controlPath))
                 continue;
 
             i2cDevs.append({
                 .name = QString("%1 [I2C %2]").arg(name, isAdapter ? "Adapter":"Device"),
-                .control = controlPath,
-                .controlValue = control
+                .controlPath = controlPath,
+                .runtimePMPath = QString("%1/device").arg(devPath)
             });
         }
 
         return i2cDevs;
     }
 
-    QList<PWTS::LNX::MiscPMDevice> OSLinux::getMiscPMPCIDevices() const {
+    QList<DeviceInventory::MiscPMEntry> OSLinux::scanMiscPMPCIDevices() const {
         const QDirListing dit("/sys/bus/pci/devices", QDirListing::IteratorFlag::DirsOnly | QDirListing::IteratorFlag::ResolveSymlinks);
-        QList<PWTS::LNX::MiscPMDevice> pciDevs;
-        struct pci_access *pacc = pci_alloc();
-
-        if (pacc != nullptr)
-            pci_init(pacc);
+        QList<DeviceInventory::MiscPMEntry> pciDevs;
 
         for (const QDirListing::DirEntry &entry: dit) {
             const QString devPath = entry.filePath();
             const QString controlPath = QString("%1/power/control").arg(devPath);
-            const QString control = readSysfs(controlPath, false);
             QString device;
             QString vendor;
             QString devName;
 
-            if (control.isEmpty() || !deviceHasRuntimePM(devPath))
+            if (!QFile::exists(controlPath))
                 continue;
 
             device = readSysfs(QString("%1/device").arg(devPath), false);
             vendor = readSysfs(QString("%1/vendor").arg(devPath), false);
 
-            if (pacc != nullptr && !device.isEmpty() && !vendor.isEmpty()) {
-                char nameBuf[1024] = {};
+            if (!device.isEmpty() && !vendor.isEmpty()) {
                 uint16_t deviceID, vendorID;
                 bool dres, vres;
 
@@ -803,9 +968,7 @@ namespace PWTD::LNX {
                 vendorID = vendor.toUInt(&vres, 16);
 
                 if (dres && vres)
-                    pci_lookup_name(pacc, nameBuf, sizeof(nameBuf), PCI_LOOKUP_VENDOR | PCI_LOOKUP_DEVICE, vendorID, deviceID);
-
-                devName.assign(nameBuf);
+                    devName = deviceInventory.getPCIName(vendorID, deviceID);
             }
 
             if (devName.isEmpty())
@@ -813,57 +976,52 @@ namespace PWTD::LNX {
 
             pciDevs.append({
                .name = devName,
-               .control = controlPath,
-               .controlValue = control
+               .controlPath = controlPath,
+               .runtimePMPath = devPath
             });
 
             for (const QDirListing::DirEntry &ataEntry: QDirListing(devPath, {"ata*"}, QDirListing::IteratorFlag::DirsOnly | QDirListing::IteratorFlag::ResolveSymlinks)) {
                 const QString ataDev = ataEntry.filePath();
                 const QString ataControlPath = QString("%1/power/control").arg(ataDev);
-                const QString ataControl = readSysfs(ataControlPath, false);
 
-                if (ataControl.isEmpty() || !deviceHasRuntimePM(ataDev))
+                if (!QFile::exists(ataControlPath))
                     continue;
 
                 pciDevs.append({
                     .name = QString("%1 [%2 port]").arg(devName, ataEntry.baseName()),
-                    .control = ataControlPath,
-                    .controlValue = ataControl
+                    .controlPath = ataControlPath,
+                    .runtimePMPath = ataDev
                 });
             }
         }
 
-        if (pacc != nullptr)
-            pci_cleanup(pacc);
-
         return pciDevs;
     }
 
-    QList<PWTS::LNX::MiscPMDevice> OSLinux::getMiscPMBlockDevices() const {
+    QList<DeviceInventory::MiscPMEntry> OSLinux::scanMiscPMDiskDevices() const {
         const QDirListing dit("/sys/block", {"sd*"}, QDirListing::IteratorFlag::DirsOnly | QDirListing::IteratorFlag::ResolveSymlinks);
-        QList<PWTS::LNX::MiscPMDevice> blkDevs;
+        QList<DeviceInventory::MiscPMEntry> blkDevs;
 
         for (const QDirListing::DirEntry &entry: dit) {
             const QString blkPath = entry.filePath();
             const QString controlPath = QString("%1/device/power/control").arg(blkPath);
-            const QString control = readSysfs(controlPath, false);
 
-            if (control.isEmpty() || !deviceHasRuntimePM(QString("%1/device").arg(blkPath)))
+            if (!QFile::exists(controlPath))
                 continue;
 
             blkDevs.append({
                 .name = QString("Disk [%1]").arg(entry.baseName()),
-                .control = controlPath,
-                .controlValue = control
+                .controlPath = controlPath,
+                .runtimePMPath = QString("%1/device").arg(blkPath)
             });
         }
 
         return blkDevs;
     }
 
-    QList<PWTS::LNX::MiscPMDevice> OSLinux::getMiscPMUSBDevices() const {
+    QList<DeviceInventory::MiscPMEntry> OSLinux::scanMiscPMUSBDevices() const {
         const QDirListing dit("/sys/bus/usb/devices", QDirListing::IteratorFlag::DirsOnly | QDirListing::IteratorFlag::ResolveSymlinks);
-        QList<PWTS::LNX::MiscPMDevice> usbDevs;
+        QList<DeviceInventory::MiscPMEntry> usbDevs;
 
         for (const QDirListing::DirEntry &entry: dit) {
             if (!QFile::exists(QString("%1/power/active_duration").arg(entry.filePath())))
@@ -871,13 +1029,12 @@ namespace PWTD::LNX {
 
             const QString devPath = entry.filePath();
             const QString controlPath = QString("%1/power/control").arg(devPath);
-            const QString control = readSysfs(controlPath, false);
             bool hasUSBPM = true;
             QString idProduct;
             QString idVendor;
             QString devName;
 
-            if (control.isEmpty())
+            if (!QFile::exists(controlPath))
                 continue;
 
             for (const QDirListing::DirEntry &usbEntry: QDirListing(devPath, QDirListing::IteratorFlag::DirsOnly)) {
@@ -906,32 +1063,101 @@ namespace PWTD::LNX {
 
             usbDevs.append({
                 .name = QString("%1 [%2:%3]").arg(devName.isEmpty() ? "Unknown USB device" : devName, idVendor, idProduct),
-                .control = controlPath,
-                .controlValue = control
+                .controlPath = controlPath,
+                .runtimePMPath = {}
             });
         }
 
         return usbDevs;
     }
 
+    QMap<QString, PWTS::LNX::BlockDeviceQueSched> OSLinux::getBlockDevices() const {
+        QMap<QString, PWTS::LNX::BlockDeviceQueSched> blockDevs;
+
+        if (deviceInventory.takeDirty(DeviceInventory::Source::BlockQueue))
+            deviceInventory.setBlockDevices(scanBlockDevices());
+
+        for (const DeviceInventory::BlockEntry &entry: deviceInventory.getBlockDevices()) {
+            const QString scheduler = readSysfs(entry.schedulerPath);
+            PWTS::LNX::BlockDeviceQueSched blkDev;
+
+            blkDev.name = entry.name;
+
+            for (const QString &sched: scheduler.split(' ', Qt::SkipEmptyParts)) {
+                const bool isSelected = sched.startsWith('[');
+
+                blkDev.availableQueueSchedulers.append(isSelected ? sched.mid(1, sched.size() - 2) : sched);
+
+                if (isSelected)
+                    blkDev.scheduler = blkDev.availableQueueSchedulers.last();
+            }
+
+            if (blkDev.availableQueueSchedulers.isEmpty()) {
+                if (logger->isLevel(PWTS::LogLevel::Error))
+                    logger->write(QString("no schedulers available for block device %1").arg(entry.device));
+
+                continue;
+            }
+
+            blockDevs.insert(entry.device, blkDev);
+        }
+
+        return blockDevs;
+    }
+
     QList<PWTS::LNX::MiscPMDevice> OSLinux::getMiscPMDevices() const {
+        static constexpr DeviceInventory::Source sources[] = {
+            DeviceInventory::Source::I2c,
+            DeviceInventory::Source::PCI,
+            DeviceInventory::Source::Disk,
+            DeviceInventory::Source::USB
+        };
         QList<PWTS::LNX::MiscPMDevice> ret;
 
-        ret.append(getMiscPMI2cDevices());
-        ret.append(getMiscPMPCIDevices());
-        ret.append(getMiscPMBlockDevices());
-        ret.append(getMiscPMUSBDevices());
+        for (const DeviceInventory::Source source: sources) {
+            if (deviceInventory.takeDirty(source)) {
+                switch (source) {
+                    case DeviceInventory::Source::I2c:
+                        deviceInventory.setMiscPMDevices(source, scanMiscPMI2cDevices());
+                        break;
+                    case DeviceInventory::Source::PCI:
+                        deviceInventory.setMiscPMDevices(source, scanMiscPMPCIDevices());
+                        break;
+                    case DeviceInventory::Source::Disk:
+                        deviceInventory.setMiscPMDevices(source, scanMiscPMDiskDevices());
+                        break;
+                    case DeviceInventory::Source::USB:
+                        deviceInventory.setMiscPMDevices(source, scanMiscPMUSBDevices());
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            for (const DeviceInventory::MiscPMEntry &entry: deviceInventory.getMiscPMDevices(source)) {
+                const QString control = readSysfs(entry.controlPath, false);
+
+                if (control.isEmpty() || (!entry.runtimePMPath.isEmpty() && !deviceHasRuntimePM(entry.runtimePMPath)))
+                    continue;
+
+                ret.append({
+                    .name = entry.name,
+                    .control = entry.controlPath,
+                    .controlValue = control
+                });
+            }
+        }
 
         return ret;
     }
 
-    bool OSLinux::setCPUFrequency(const int cpu, const PWTS::RWData<PWTS::MinMax> &data) const {
+    bool OSLinux::setCPUFrequency(const QByteArray &minPath, const QByteArray &maxPath, const PWTS::RWData<PWTS::MinMax> &data) const {
         if (!data.isValid())
             return true;
 
         const PWTS::MinMax freq = data.getValue();
-        const bool minWriteRes = writeSysfs(QString("%1cpu%2/cpufreq/scaling_min_freq").arg(sysfsCPU).arg(cpu), QString::number(freq.min * 1000));
-        const bool maxWriteRes = writeSysfs(QString("%1cpu%2/cpufreq/scaling_max_freq").arg(sysfsCPU).arg(cpu), QString::number(freq.max * 1000));
+        const bool minWriteRes = writeSysfs(minPath, QString::number(freq.min * 1000));
+        const bool maxWriteRes = writeSysfs(maxPath, QString::number(freq.max * 1000));
 
         return minWriteRes && maxWriteRes;
     }
@@ -940,30 +1166,37 @@ namespace PWTD::LNX {
         if (!state.isValid())
             return true;
 
-        return writeSysfs(sysfsSMT, state.getValue());
+        const bool res = writeSysfs(sysfsPaths.global(SysfsPaths::Global::SMTControl), state.getValue());
+
+        sysfsCache.invalidate(QByteArray(sysfsCPU));
+        return res;
     }
 
     bool OSLinux::setCPUOnlineStatus(const int cpu, const PWTS::RWData<int> &data) const {
-        const QString onlinePath = QString("%1cpu%2/online").arg(sysfsCPU).arg(cpu);
+        const QByteArray &onlinePath = sysfsPaths.cpu(cpu, SysfsPaths::CPU::Online);
 
-        if (!QFile::exists(onlinePath) || !data.isValid())
+        if (!QFile::exists(QFile::decodeName(onlinePath)) || !data.isValid())
             return true;
 
-        return writeSysfs(onlinePath, QString::number(data.getValue()));
+        const bool res = writeSysfs(onlinePath, QString::number(data.getValue()));
+
+        // cpufreq and friends are removed and recreated with the cpu
+        sysfsCache.invalidate(QByteArray(sysfsCPU) + "cpu" + QByteArray::number(cpu) + '/');
+        return res;
     }
 
-    bool OSLinux::setCPUScalingGovernor(const int cpu, const PWTS::RWData<QString> &data) const {
+    bool OSLinux::setCPUScalingGovernor(const QByteArray &govPath, const PWTS::RWData<QString> &data) const {
         if (!data.isValid())
             return true;
 
-        return writeSysfs(QString("%1cpu%2/cpufreq/scaling_governor").arg(sysfsCPU).arg(cpu), data.getValue());
+        return writeSysfs(govPath, data.getValue());
     }
 
     bool OSLinux::setCPUIdleGovernor(const PWTS::RWData<QString> &data) const {
         if (!data.isValid())
             return true;
 
-        return writeSysfs(QString("%1current_governor").arg(sysfsCPUIdle), data.getValue());
+        return writeSysfs(sysfsPaths.global(SysfsPaths::Global::CPUIdleCurrentGovernor), data.getValue());
     }
 
     bool OSLinux::setBlockDevices(const QMap<QString, PWTS::LNX::BlockDeviceQueSched> &blockDevList) const {
@@ -975,7 +1208,7 @@ namespace PWTD::LNX {
             if (!QFile::exists(schedPath)) // probably detached device, no error
                 continue;
 
-            if (!writeSysfs(schedPath, data.scheduler))
+            if (!applyEngine->apply(PWTS::DError::W_BLOCK_DEVICES, dev, data.scheduler, [&]()->bool { return writeSysfs(schedPath, data.scheduler); }))
                 success = false;
         }
 
@@ -996,7 +1229,7 @@ namespace PWTD::LNX {
             if (!QFile::exists(miscPMDev.control)) // probably detached device, no error
                 continue;
 
-            if (!writeSysfs(miscPMDev.control, miscPMDev.controlValue))
+            if (!applyEngine->apply(PWTS::DError::W_MISC_PM_DEVICES, miscPMDev.control, miscPMDev.controlValue, [&]()->bool { return writeSysfs(miscPMDev.control, miscPMDev.controlValue); }))
                 success = false;
         }
 
@@ -1052,7 +1285,7 @@ namespace PWTD::LNX {
 
         const QSharedPointer<PWTS::LNX::AMD::LinuxAMDData> data = packet.linuxAmdData;
 
-        if (features.contains(PWTS::Feature::AMD_PSTATE_SYSFS) && !setAMDPStateStatus(data->pstateStatus))
+        if (features.contains(PWTS::Feature::AMD_PSTATE_SYSFS) && !applyEngine->apply(PWTS::DError::W_AMDPSTATE_SYSFS, data->pstateStatus, [&]()->bool { applyEngine->requestReset(); return setAMDPStateStatus(data->pstateStatus); }))
             errors.insert(PWTS::DError::W_AMDPSTATE_SYSFS);
     }
 
@@ -1062,7 +1295,7 @@ namespace PWTD::LNX {
 
         const PWTS::LNX::AMD::LinuxAMDThreadData &data = packet.linuxAmdData->threadData[cpu];
 
-        if (features.contains(PWTS::Feature::AMD_PSTATE_SYSFS) && !setAMDPStateEPPPreference(cpu, data.epp))
+        if (features.contains(PWTS::Feature::AMD_PSTATE_SYSFS) && !applyEngine->apply(PWTS::DError::W_AMDPSTATE_EPP_SYSFS, cpu, data.epp, [&]()->bool { return setAMDPStateEPPPreference(cpu, data.epp); }))
             errors.insert(PWTS::DError::W_AMDPSTATE_EPP_SYSFS);
     }
 
@@ -1090,7 +1323,7 @@ namespace PWTD::LNX {
     }
 
      PWTS::ROData<PWTS::LNX::AMD::AMDPStateData> OSLinux::getAMDPStateData(const int cpu) const { //todo partial impl
-        const QString eppPrefs = readSysfs(QString("%1cpu%2/cpufreq/energy_performance_available_preferences").arg(sysfsCPU).arg(cpu));
+        const QString eppPrefs = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::EPPAvailablePreferences));
         PWTS::LNX::AMD::AMDPStateData data;
 
          if (eppPrefs.isEmpty())
@@ -1102,13 +1335,13 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<QString> OSLinux::getAMDPStateStatus() const {
-        const QString status = readSysfs(QString("%1amd_pstate/status").arg(sysfsCPU));
+        const QString status = readSysfs(sysfsPaths.global(SysfsPaths::Global::AMDPStateStatus));
 
         return PWTS::RWData<QString>(status, !status.isEmpty());
     }
 
     PWTS::RWData<QString> OSLinux::getAMDPStateEPPPreference(const int cpu) const {
-        const QString epp = readSysfs(QString("%1cpu%2/cpufreq/energy_performance_preference").arg(sysfsCPU).arg(cpu));
+        const QString epp = readSysfs(sysfsPaths.cpu(cpu, SysfsPaths::CPU::EPPPreference));
 
         return PWTS::RWData<QString>(epp, !epp.isEmpty());
     }
@@ -1117,13 +1350,13 @@ namespace PWTD::LNX {
         if (!data.isValid())
             return true;
 
-        return writeSysfs(QString("%1amd_pstate/status").arg(sysfsCPU), data.getValue());
+        return writeSysfs(sysfsPaths.global(SysfsPaths::Global::AMDPStateStatus), data.getValue());
     }
 
     bool OSLinux::setAMDPStateEPPPreference(const int cpu, const PWTS::RWData<QString> &data) const {
-        const QString eppPath = QString("%1cpu%2/cpufreq/energy_performance_preference").arg(sysfsCPU).arg(cpu);
+        const QByteArray &eppPath = sysfsPaths.cpu(cpu, SysfsPaths::CPU::EPPPreference);
 
-        if (!QFile::exists(eppPath) || !data.isValid())
+        if (!QFile::exists(QFile::decodeName(eppPath)) || !data.isValid())
             return true;
 
         return writeSysfs(eppPath, data.getValue());
@@ -1131,17 +1364,17 @@ namespace PWTD::LNX {
 #endif
 
     bool OSLinux::hasIntelGPURPSFreq(const int index) const {
-        return QFile::exists(QString("%1card%2/gt_RP0_freq_mhz").arg(sysfsDRM).arg(index)) &&
-                QFile::exists(QString("%1card%2/gt_RPn_freq_mhz").arg(sysfsDRM).arg(index));
+        return QFile::exists(QFile::decodeName(sysfsPaths.gpu(index, SysfsPaths::GPU::RP0Freq))) &&
+                QFile::exists(QFile::decodeName(sysfsPaths.gpu(index, SysfsPaths::GPU::RPnFreq)));
     }
 
     bool OSLinux::hasIntelGPUBoost(const int index) const {
-        return QFile::exists(QString("%1card%2/gt_boost_freq_mhz").arg(sysfsDRM).arg(index));
+        return QFile::exists(QFile::decodeName(sysfsPaths.gpu(index, SysfsPaths::GPU::BoostFreq)));
     }
 
     PWTS::ROData<PWTS::LNX::Intel::GPURPSLimits> OSLinux::getIntelGPURPSLimits(const int index) const {
-        const QString rp0 = readSysfs(QString("%1card%2/gt_RP0_freq_mhz").arg(sysfsDRM).arg(index));
-        const QString rpn = readSysfs(QString("%1card%2/gt_RPn_freq_mhz").arg(sysfsDRM).arg(index));
+        const QString rp0 = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::RP0Freq));
+        const QString rpn = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::RPnFreq));
         bool res0, resN;
         int rp0I, rpnI;
 
@@ -1158,8 +1391,8 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<PWTS::MinMax> OSLinux::getIntelGPUFrequency(const int index) const {
-        const QString min = readSysfs(QString("%1card%2/gt_min_freq_mhz").arg(sysfsDRM).arg(index));
-        const QString max = readSysfs(QString("%1card%2/gt_max_freq_mhz").arg(sysfsDRM).arg(index));
+        const QString min = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::MinFreq));
+        const QString max = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::MaxFreq));
         bool resMin, resMax;
         int minI, maxI;
 
@@ -1180,14 +1413,12 @@ namespace PWTD::LNX {
             return true;
 
         const PWTS::MinMax freq = data.getValue();
-        const QString minPath = QString("%1card%2/gt_min_freq_mhz").arg(sysfsDRM).arg(index);
-        const QString maxPath = QString("%1card%2/gt_max_freq_mhz").arg(sysfsDRM).arg(index);
-
-        return writeSysfs(minPath, QString::number(freq.min)) && writeSysfs(maxPath, QString::number(freq.max));
+        return writeSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::MinFreq), QString::number(freq.min)) &&
+                writeSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::MaxFreq), QString::number(freq.max));
     }
 
     PWTS::RWData<int> OSLinux::getIntelGPUBoost(const int index) const {
-        const QString boost = readSysfs(QString("%1card%2/gt_boost_freq_mhz").arg(sysfsDRM).arg(index));
+        const QString boost = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::BoostFreq));
         int boostI;
         bool res;
 
@@ -1203,19 +1434,19 @@ namespace PWTD::LNX {
         if (!data.isValid())
             return true;
 
-        return writeSysfs(QString("%1card%2/gt_boost_freq_mhz").arg(sysfsDRM).arg(index), QString::number(data.getValue()));
+        return writeSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::BoostFreq), QString::number(data.getValue()));
     }
 
     bool OSLinux::hasAMDGPUDpmForcePerfLevel(const int index) const {
-        return QFile::exists(QString("%1card%2/device/power_dpm_force_performance_level").arg(sysfsDRM).arg(index));
+        return QFile::exists(QFile::decodeName(sysfsPaths.gpu(index, SysfsPaths::GPU::DpmForcePerfLevel)));
     }
 
     bool OSLinux::hasAMDGPUPowerDpmState(int index) const {
-        return QFile::exists(QString("%1card%2/device/power_dpm_state").arg(sysfsDRM).arg(index));
+        return QFile::exists(QFile::decodeName(sysfsPaths.gpu(index, SysfsPaths::GPU::PowerDpmState)));
     }
 
     PWTS::ROData<PWTS::LNX::AMD::GPUODRanges> OSLinux::getAMDGPUODRanges(const int index) const {
-        QString odclk = readSysfs(QString("%1card%2/device/pp_od_clk_voltage").arg(sysfsDRM).arg(index));
+        QString odclk = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::PPODClkVoltage));
         QTextStream ts {&odclk};
         bool sclkValid = false;
         int sclkMin = 0, sclkMax = 0;
@@ -1247,8 +1478,8 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<PWTS::LNX::AMD::GPUDPMForcePerfLevel> OSLinux::getAMDGPUDpmForcePerfLevel(const int index) const {
-        const QString dpmForcePerfLvl = readSysfs(QString("%1card%2/device/power_dpm_force_performance_level").arg(sysfsDRM).arg(index));
-        QString ppod = readSysfs(QString("%1card%2/device/pp_od_clk_voltage").arg(sysfsDRM).arg(index));
+        const QString dpmForcePerfLvl = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::DpmForcePerfLevel));
+        QString ppod = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::PPODClkVoltage));
         QTextStream ts {&ppod};
         bool validSclk = true;
         PWTS::LNX::AMD::GPUDPMForcePerfLevel data;
@@ -1285,7 +1516,7 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<QString> OSLinux::getAMDGPUPowerDpmState(const int index) const {
-        const QString dpmState = readSysfs(QString("%1card%2/device/power_dpm_state").arg(sysfsDRM).arg(index));
+        const QString dpmState = readSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::PowerDpmState));
 
         return PWTS::RWData<QString>(dpmState, !dpmState.isEmpty());
     }
@@ -1295,10 +1526,10 @@ namespace PWTD::LNX {
             return true;
 
         const PWTS::LNX::AMD::GPUDPMForcePerfLevel dpmData = data.getValue();
-        const QString dpmForcePerfLvlPath = QString("%1card%2/device/power_dpm_force_performance_level").arg(sysfsDRM).arg(index);
+        const QByteArray &dpmForcePerfLvlPath = sysfsPaths.gpu(index, SysfsPaths::GPU::DpmForcePerfLevel);
 
         if (dpmData.level == "manual") {
-            QFile ppodF {QString("%1card%2/device/pp_od_clk_voltage").arg(sysfsDRM).arg(index)};
+            QFile ppodF {QFile::decodeName(sysfsPaths.gpu(index, SysfsPaths::GPU::PPODClkVoltage))};
             QTextStream tsPP {&ppodF};
 
             if (!ppodF.open(WOTextOpenFlags)) {
@@ -1333,7 +1564,29 @@ namespace PWTD::LNX {
         if (!data.isValid())
             return true;
 
-        return writeSysfs(QString("%1card%2/device/power_dpm_state").arg(sysfsDRM).arg(index), data.getValue());
+        return writeSysfs(sysfsPaths.gpu(index, SysfsPaths::GPU::PowerDpmState), data.getValue());
+    }
+
+    // k10temp reads Tctl from SMN, unlike the ryzenadj table it needs no smu command
+    QByteArray OSLinux::getCPUTempInputPath() const {
+        const QDirListing hwmonIt(sysfsHWMon, {"hwmon*"}, QDirListing::IteratorFlag::DirsOnly | QDirListing::IteratorFlag::ResolveSymlinks);
+
+        for (const QDirListing::DirEntry &entry: hwmonIt) {
+            if (readSysfs(QString("%1/name").arg(entry.absoluteFilePath()), false).trimmed() == "k10temp")
+                return QFile::encodeName(QString("%1/temp1_input").arg(entry.absoluteFilePath()));
+        }
+
+        return {};
+    }
+
+    PWTS::ROData<int> OSLinux::getCPUPackageTemperature() const {
+        if (cpuTempInputPath.isEmpty())
+            return {};
+
+        bool res;
+        const int milliC = readSysfs(cpuTempInputPath).trimmed().toInt(&res);
+
+        return PWTS::ROData<int>(milliC / 1000, res);
     }
 
 #ifdef WITH_GPD_FAN
@@ -1347,7 +1600,7 @@ namespace PWTD::LNX {
     }
 
     PWTS::RWData<int> OSLinux::getGPDFanMode(const QString &hwmon) const {
-        const QString gpdMode = readSysfs(QString("%1/%2/pwm1_enable").arg(sysfsGpdfan, hwmon));
+        const QString gpdMode = readSysfs(sysfsPaths.fan(hwmon, SysfsPaths::Fan::PWMEnable));
         bool res;
         const int gpdModeI = gpdMode.toInt(&res);
         const int mode = gpdModeI == 2 ? 0:1;
@@ -1356,7 +1609,7 @@ namespace PWTD::LNX {
     }
 
     PWTS::ROData<int> OSLinux::getGPDFanSpeed(const QString &hwmon) const {
-        const QString speed = readSysfs(QString("%1/%2/fan1_input").arg(sysfsGpdfan, hwmon));
+        const QString speed = readSysfs(sysfsPaths.fan(hwmon, SysfsPaths::Fan::Input));
         bool res;
         const int speedI = speed.toInt(&res);
         const int perc = res ? (speedI * 100 / 255) : 0;
@@ -1371,7 +1624,7 @@ namespace PWTD::LNX {
         const int fanMode = mode.getValue();
         const int gpdMode = fanMode == 0 ? 2:1;
 
-        return writeSysfs(QString("%1/%2/pwm1_enable").arg(sysfsGpdfan, hwmon), QString::number(gpdMode));
+        return writeSysfs(sysfsPaths.fan(hwmon, SysfsPaths::Fan::PWMEnable), QString::number(gpdMode));
     }
 
     bool OSLinux::setGPDFanSpeed(const int speed, const QString &hwmon) const {
@@ -1381,7 +1634,7 @@ namespace PWTD::LNX {
         if (!mode.isValid() || mode.getValue() == 0)
             return true;
 
-        return writeSysfs(QString("%1/%2/pwm1").arg(sysfsGpdfan, hwmon), QString::number(val));
+        return writeSysfs(sysfsPaths.fan(hwmon, SysfsPaths::Fan::PWM), QString::number(val));
     }
 #endif
 }
@@ -20,25 +20,39 @@
 #include <QFile>
 #include <QRegularExpression>
 
+#include "DeviceInventory.h"
+#include "SysfsCache.h"
+#include "SysfsPaths.h"
 #include "../OS.h"
 
 namespace PWTD::LNX {
     class OSLinux final: public OS {
     private:
+        struct CPUFreqPolicy {
+            int id;
+            QList<int> cpus;
+        };
+
         const QFlags<QIODevice::OpenModeFlag> ROTextOpenFlags = QFile::ReadOnly | QFile::Text;
         const QFlags<QIODevice::OpenModeFlag> WOTextOpenFlags = QFile::WriteOnly | QFile::Text;
         const QRegularExpression gpuCardFolderRex {R"(^card([0-9]+)$)"};
+        const QRegularExpression cpufreqPolicyFolderRex {R"(^policy([0-9]+)$)"};
         const QRegularExpression miscPmDevPathRex {R"(^\/sys\/bus\/(pci|usb)\/devices\/[\/\-\:\.\w\d]+\/power\/control$)"};
         const QRegularExpression miscPmBlockPathRex {R"(^\/sys\/block\/[\w\d]+\/device\/power\/control$)"};
         static constexpr char sysfsCPU[] = R"(/sys/devices/system/cpu/)";
         static constexpr char sysfsDMI[] = R"(/sys/class/dmi/id/)";
         static constexpr char sysfsDRM[] = R"(/sys/class/drm/)";
         static constexpr char sysfsBlock[] = R"(/sys/class/block/)";
-        static constexpr char sysfsCPUIdle[] = R"(/sys/devices/system/cpu/cpuidle/)";
-        static constexpr char sysfsSMT[] = R"(/sys/devices/system/cpu/smt/control)";
+        static constexpr char sysfsCPUFreq[] = R"(/sys/devices/system/cpu/cpufreq/)";
+        static constexpr char sysfsHWMon[] = R"(/sys/class/hwmon/)";
 #ifdef WITH_GPD_FAN
         static constexpr char sysfsGpdfan[] = R"(/sys/devices/platform/gpd_fan/hwmon)";
 #endif
+        QList<CPUFreqPolicy> cpufreqPolicies;
+        QByteArray cpuTempInputPath;
+        SysfsPaths sysfsPaths;
+        mutable SysfsCache sysfsCache;
+        mutable DeviceInventory deviceInventory;
 
         void fillIntelGPUData(int index, const QSet<PWTS::Feature> &features, const PWTS::DaemonPacket &packet) const;
         void fillAMDGPUData(int index, const QSet<PWTS::Feature> &features, const PWTS::DaemonPacket &packet) const;
@@ -48,11 +62,16 @@ namespace PWTD::LNX {
         void applyAMDGPUSettings(int index, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
         void applyPackageSettings(const PWTS::Features &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
         void applyThreadSettings(int cpu, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
+        void applyCPUFreqSettings(int numLogicalCPUs, const QSet<PWTS::Feature> &features, const PWTS::ClientPacket &packet, QSet<PWTS::DError> &errors) const;
         [[nodiscard]] QString readSysfs(const QString &path, bool existsErrorLog = true) const;
+        [[nodiscard]] QString readSysfs(const QByteArray &path, bool existsErrorLog = true) const;
         [[nodiscard]] bool writeSysfs(const QString &path, const QString &value) const;
+        [[nodiscard]] bool writeSysfs(const QByteArray &path, const QString &value) const;
         [[nodiscard]] bool hasSMT() const;
         PWTS::ROData<bool> hasCPULogicalOffFeature(int cpu) const;
         [[nodiscard]] bool deviceHasRuntimePM(const QString &path) const;
+        [[nodiscard]] QList<CPUFreqPolicy> getCPUFreqPolicies() const;
+        [[nodiscard]] QByteArray getCPUTempInputPath() const;
         PWTS::ROData<PWTS::LNX::CPUFrequencyLimits> getCPUFrequencyLimits(int cpu) const;
         PWTS::RWData<PWTS::MinMax> getCPUFrequency(int cpu) const;
         PWTS::RWData<QString> getSMT() const;
@@ -62,16 +81,18 @@ namespace PWTD::LNX {
         PWTS::RWData<QString> getCPUScalingGovernor(int cpu) const;
         PWTS::ROData<QList<QString>> getAvailableCPUIdleGovernors() const;
         PWTS::RWData<QString> getCPUIdleGovernor() const;
+        void syncDeviceInventory() const;
+        [[nodiscard]] QList<DeviceInventory::BlockEntry> scanBlockDevices() const;
+        [[nodiscard]] QList<DeviceInventory::MiscPMEntry> scanMiscPMI2cDevices() const;
+        [[nodiscard]] QList<DeviceInventory::MiscPMEntry> scanMiscPMPCIDevices() const;
+        [[nodiscard]] QList<DeviceInventory::MiscPMEntry> scanMiscPMDiskDevices() const;
+        [[nodiscard]] QList<DeviceInventory::MiscPMEntry> scanMiscPMUSBDevices() const;
         [[nodiscard]] QMap<QString, PWTS::LNX::BlockDeviceQueSched> getBlockDevices() const;
-        [[nodiscard]] QList<PWTS::LNX::MiscPMDevice> getMiscPMI2cDevices() const;
-        [[nodiscard]] QList<PWTS::LNX::MiscPMDevice> getMiscPMPCIDevices() const;
-        [[nodiscard]] QList<PWTS::LNX::MiscPMDevice> getMiscPMBlockDevices() const;
-        [[nodiscard]] QList<PWTS::LNX::MiscPMDevice> getMiscPMUSBDevices() const;
         [[nodiscard]] QList<PWTS::LNX::MiscPMDevice> getMiscPMDevices() const;
-        [[nodiscard]] bool setCPUFrequency(int cpu, const PWTS::RWData<PWTS::MinMax> &data) const;
+        [[nodiscard]] bool setCPUFrequency(const QByteArray &minPath, const QByteArray &maxPath, const PWTS::RWData<PWTS::MinMax> &data) const;
         [[nodiscard]] bool setSMT(const PWTS::RWData<QString> &state) const;
         [[nodiscard]] bool setCPUOnlineStatus(int cpu, const PWTS::RWData<int> &data) const;
-        [[nodiscard]] bool setCPUScalingGovernor(int cpu, const PWTS::RWData<QString> &data) const;
+        [[nodiscard]] bool setCPUScalingGovernor(const QByteArray &govPath, const PWTS::RWData<QString> &data) const;
         [[nodiscard]] bool setCPUIdleGovernor(const PWTS::RWData<QString> &data) const;
         [[nodiscard]] bool setBlockDevices(const QMap<QString, PWTS::LNX::BlockDeviceQueSched> &blockDevList) const;
         [[nodiscard]] bool setMiscPMDevices(const QList<PWTS::LNX::MiscPMDevice> &miscPMDevList) const;
@@ -131,6 +152,8 @@ namespace PWTD::LNX {
         [[nodiscard]] quint64 getSwapSize() const override;
 
     public:
+        OSLinux();
+
         [[nodiscard]] bool setupOSAccess() const override;
         void unsetOSAccess() const override;
         [[nodiscard]] QSet<PWTS::Feature> getCPUFeatures(int numLogicalCPUs, PWTS::CPUVendor vendor) const override;
@@ -139,6 +162,8 @@ namespace PWTD::LNX {
         void fillDaemonPacket(const PWTS::Features &features, PWTS::CPUVendor cpuVendor, int numLogicalCPUs, PWTS::DaemonPacket &packet) const override;
         [[nodiscard]] QSet<PWTS::DError> applySettings(const PWTS::Features &features, PWTS::CPUVendor cpuVendor, int numLogicalCPUs, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const override;
         [[nodiscard]] QList<int> getCPUCoreIndexList() const override;
+        [[nodiscard]] QList<int> getCPUCurrentFrequency(int numLogicalCPUs) const override;
+        [[nodiscard]] PWTS::ROData<int> getCPUPackageTemperature() const override;
         [[nodiscard]] QList<int> getGPUIndexList() const override;
         [[nodiscard]] PWTS::GPUVendor getGPUVendor(int index) const override;
         [[nodiscard]] QString getGPUDeviceID(int index) const override;
@@ -0,0 +1,147 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
+
+#include "SysfsCache.h"
+
+namespace PWTD::LNX {
+    SysfsCache::~SysfsCache() {
+        clear();
+    }
+
+    bool SysfsCache::isHotAttribute(const QByteArrayView path) {
+        const QByteArrayView name = path.sliced(path.lastIndexOf('/') + 1);
+
+        return std::ranges::find(hotAttributes, name) != std::end(hotAttributes);
+    }
+
+    bool SysfsCache::isStaleError(const int err) {
+        return err == ENODEV || err == ENOENT || err == ENXIO;
+    }
+
+    int SysfsCache::getFd(QHash<QByteArray, int> &fds, const QByteArray &path, const int flags) {
+        const auto it = fds.constFind(path);
+
+        if (it != fds.constEnd())
+            return it.value();
+
+        const int fd = open(path.constData(), flags | O_CLOEXEC);
+
+        if (fd < 0) {
+            lastError = errno;
+            return -1;
+        }
+
+        fds.insert(path, fd);
+        return fd;
+    }
+
+    void SysfsCache::dropFd(QHash<QByteArray, int> &fds, const QByteArray &path) {
+        const auto it = fds.find(path);
+
+        if (it == fds.end())
+            return;
+
+        close(it.value());
+        fds.erase(it);
+    }
+
+    SysfsCache::Result SysfsCache::read(const QByteArray &path, QString &value) {
+        char buf[4096];
+
+        if (!isHotAttribute(path))
+            return Result::Unavailable;
+
+        for (int attempt=0; attempt<2; ++attempt) {
+            const int fd = getFd(readFds, path, O_RDONLY);
+
+            if (fd < 0)
+                return Result::Unavailable;
+
+            const ssize_t ret = pread(fd, buf, sizeof(buf), 0);
+
+            if (ret >= 0) {
+                value = QString::fromUtf8(buf, ret).trimmed();
+                return Result::Ok;
+            }
+
+            lastError = errno;
+            dropFd(readFds, path);
+
+            if (!isStaleError(lastError))
+                return Result::Failed;
+        }
+
+        return Result::Unavailable;
+    }
+
+    SysfsCache::Result SysfsCache::write(const QByteArray &path, const QByteArray &value) {
+        if (!isHotAttribute(path))
+            return Result::Unavailable;
+
+        for (int attempt=0; attempt<2; ++attempt) {
+            const int fd = getFd(writeFds, path, O_WRONLY);
+
+            if (fd < 0)
+                return Result::Unavailable;
+
+            const ssize_t ret = pwrite(fd, value.constData(), value.size(), 0);
+
+            if (ret == value.size())
+                return Result::Ok;
+
+            // kernel rejected the value, the fd is still good
+            lastError = ret < 0 ? errno : EIO;
+
+            if (!isStaleError(lastError))
+                return Result::Failed;
+
+            dropFd(writeFds, path);
+        }
+
+        return Result::Unavailable;
+    }
+
+    void SysfsCache::invalidate(const QByteArray &pathPrefix) {
+        for (QHash<QByteArray, int> *fds: {&readFds, &writeFds}) {
+            for (auto it = fds->begin(); it != fds->end();) {
+                if (!it.key().startsWith(pathPrefix)) {
+                    ++it;
+                    continue;
+                }
+
+                close(it.value());
+                it = fds->erase(it);
+            }
+        }
+    }
+
+    void SysfsCache::clear() {
+        for (const int fd: std::as_const(readFds))
+            close(fd);
+
+        for (const int fd: std::as_const(writeFds))
+            close(fd);
+
+        readFds.clear();
+        writeFds.clear();
+    }
+}
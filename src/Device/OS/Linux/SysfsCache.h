@@ -0,0 +1,75 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QByteArrayView>
+#include <QHash>
+#include <QString>
+
+namespace PWTD::LNX {
+    // keeps fds of frequently polled sysfs attributes open, reads with pread at offset 0 and writes with a single pwrite
+    // a stale fd (device or cpu gone) is dropped and reopened once, owners drop whole subtrees on hotplug
+    class SysfsCache final {
+    public:
+        enum class Result {
+            Ok,
+            Failed,
+            Unavailable // not cached or cannot be opened, use the regular path
+        };
+
+    private:
+        static constexpr QByteArrayView hotAttributes[] {
+            "scaling_min_freq",
+            "scaling_max_freq",
+            "scaling_cur_freq",
+            "scaling_governor",
+            "online",
+            "energy_performance_preference",
+            "current_governor",
+            "gt_min_freq_mhz",
+            "gt_max_freq_mhz",
+            "gt_boost_freq_mhz",
+            "power_dpm_force_performance_level",
+            "power_dpm_state",
+            "pwm1",
+            "pwm1_enable",
+            "fan1_input"
+        };
+        QHash<QByteArray, int> readFds;
+        QHash<QByteArray, int> writeFds;
+        int lastError = 0;
+
+        [[nodiscard]] int getFd(QHash<QByteArray, int> &fds, const QByteArray &path, int flags);
+        void dropFd(QHash<QByteArray, int> &fds, const QByteArray &path);
+        [[nodiscard]] static bool isStaleError(int err);
+
+    public:
+        SysfsCache() = default;
+        SysfsCache(const SysfsCache &) = delete;
+        SysfsCache &operator=(const SysfsCache &) = delete;
+
+        ~SysfsCache();
+
+        [[nodiscard]] static bool isHotAttribute(QByteArrayView path);
+        [[nodiscard]] Result read(const QByteArray &path, QString &value);
+        [[nodiscard]] Result write(const QByteArray &path, const QByteArray &value);
+        [[nodiscard]] int getLastError() const { return lastError; }
+        void invalidate(const QByteArray &pathPrefix);
+        void clear();
+    };
+}
@@ -0,0 +1,51 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SysfsPaths.h"
+
+namespace PWTD::LNX {
+    void SysfsPaths::buildGlobal(const QByteArray &cpuRoot) {
+        globalTable = makeTable(cpuRoot, globalSuffixes);
+    }
+
+    void SysfsPaths::buildCPUs(const QByteArray &cpuRoot, const int count) {
+        cpuTable.clear();
+        cpuTable.reserve(count);
+
+        for (int i=0; i<count; ++i)
+            cpuTable.append(makeTable(cpuRoot + "cpu" + QByteArray::number(i) + '/', cpuSuffixes));
+    }
+
+    void SysfsPaths::buildPolicies(const QByteArray &cpufreqRoot, const QList<int> &policies) {
+        policyTable.clear();
+
+        for (const int policy: policies)
+            policyTable.insert(policy, makeTable(cpufreqRoot + "policy" + QByteArray::number(policy) + '/', policySuffixes));
+    }
+
+    void SysfsPaths::buildGPUs(const QByteArray &drmRoot, const QList<int> &cards) {
+        gpuTable.clear();
+
+        for (const int card: cards)
+            gpuTable.insert(card, makeTable(drmRoot + "card" + QByteArray::number(card) + '/', gpuSuffixes));
+    }
+
+    void SysfsPaths::buildFan(const QByteArray &hwmonRoot, const QString &hwmon) {
+        fanHWMon = hwmon;
+        fanTable = makeTable(hwmonRoot + '/' + hwmon.toLocal8Bit() + '/', fanSuffixes);
+    }
+}
@@ -0,0 +1,191 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+namespace PWTD::LNX {
+    // sysfs attribute paths built once, so getters and setters do not format paths on every poll
+    // unknown indexes get an empty path, which reads and writes treat as a missing file
+    class SysfsPaths final {
+    public:
+        enum class Global {
+            SMTControl,
+            CPUIdleAvailableGovernors,
+            CPUIdleCurrentGovernor,
+            AMDPStateStatus,
+            Count
+        };
+
+        enum class CPU {
+            CPUInfoMinFreq,
+            CPUInfoMaxFreq,
+            RelatedCPUs,
+            ScalingMinFreq,
+            ScalingMaxFreq,
+            ScalingCurFreq,
+            ScalingAvailableGovernors,
+            ScalingGovernor,
+            EPPAvailablePreferences,
+            EPPPreference,
+            Online,
+            CoreID,
+            MicrocodeVersion,
+            Count
+        };
+
+        enum class Policy {
+            ScalingMinFreq,
+            ScalingMaxFreq,
+            ScalingGovernor,
+            Count
+        };
+
+        enum class GPU {
+            Vendor,
+            DeviceID,
+            Revision,
+            VBiosVersion,
+            RP0Freq,
+            RPnFreq,
+            MinFreq,
+            MaxFreq,
+            BoostFreq,
+            PPODClkVoltage,
+            DpmForcePerfLevel,
+            PowerDpmState,
+            Count
+        };
+
+        enum class Fan {
+            PWM,
+            PWMEnable,
+            Input,
+            Count
+        };
+
+    private:
+        template<typename E>
+        using Table = std::array<QByteArray, static_cast<size_t>(E::Count)>;
+
+        template<typename E>
+        using Suffixes = std::array<const char *, static_cast<size_t>(E::Count)>;
+
+        static constexpr Suffixes<Global> globalSuffixes {
+            "smt/control",
+            "cpuidle/available_governors",
+            "cpuidle/current_governor",
+            "amd_pstate/status"
+        };
+        static constexpr Suffixes<CPU> cpuSuffixes {
+            "cpufreq/cpuinfo_min_freq",
+            "cpufreq/cpuinfo_max_freq",
+            "cpufreq/related_cpus",
+            "cpufreq/scaling_min_freq",
+            "cpufreq/scaling_max_freq",
+            "cpufreq/scaling_cur_freq",
+            "cpufreq/scaling_available_governors",
+            "cpufreq/scaling_governor",
+            "cpufreq/energy_performance_available_preferences",
+            "cpufreq/energy_performance_preference",
+            "online",
+            "topology/core_id",
+            "microcode/version"
+        };
+        static constexpr Suffixes<Policy> policySuffixes {
+            "scaling_min_freq",
+            "scaling_max_freq",
+            "scaling_governor"
+        };
+        static constexpr Suffixes<GPU> gpuSuffixes {
+            "device/vendor",
+            "device/device",
+            "device/revision",
+            "device/vbios_version",
+            "gt_RP0_freq_mhz",
+            "gt_RPn_freq_mhz",
+            "gt_min_freq_mhz",
+            "gt_max_freq_mhz",
+            "gt_boost_freq_mhz",
+            "device/pp_od_clk_voltage",
+            "device/power_dpm_force_performance_level",
+            "device/power_dpm_state"
+        };
+        static constexpr Suffixes<Fan> fanSuffixes {
+            "pwm1",
+            "pwm1_enable",
+            "fan1_input"
+        };
+
+        inline static const QByteArray emptyPath;
+        Table<Global> globalTable;
+        QList<Table<CPU>> cpuTable;
+        QHash<int, Table<Policy>> policyTable;
+        QHash<int, Table<GPU>> gpuTable;
+        Table<Fan> fanTable;
+        QString fanHWMon;
+
+        template<typename E>
+        [[nodiscard]] static Table<E> makeTable(const QByteArray &dir, const Suffixes<E> &suffixes) {
+            Table<E> table;
+
+            for (size_t i=0; i<suffixes.size(); ++i)
+                table[i] = dir + suffixes[i];
+
+            return table;
+        }
+
+    public:
+        void buildGlobal(const QByteArray &cpuRoot);
+        void buildCPUs(const QByteArray &cpuRoot, int count);
+        void buildPolicies(const QByteArray &cpufreqRoot, const QList<int> &policies);
+        void buildGPUs(const QByteArray &drmRoot, const QList<int> &cards);
+        void buildFan(const QByteArray &hwmonRoot, const QString &hwmon);
+
+        [[nodiscard]] const QByteArray &global(const Global attr) const {
+            return globalTable[static_cast<size_t>(attr)];
+        }
+
+        [[nodiscard]] const QByteArray &cpu(const int cpu, const CPU attr) const {
+            if (cpu < 0 || cpu >= cpuTable.size()) [[unlikely]]
+                return emptyPath;
+
+            return cpuTable[cpu][static_cast<size_t>(attr)];
+        }
+
+        [[nodiscard]] const QByteArray &policy(const int policy, const Policy attr) const {
+            const auto it = policyTable.constFind(policy);
+
+            return it == policyTable.constEnd() ? emptyPath : it.value()[static_cast<size_t>(attr)];
+        }
+
+        [[nodiscard]] const QByteArray &gpu(const int card, const GPU attr) const {
+            const auto it = gpuTable.constFind(card);
+
+            return it == gpuTable.constEnd() ? emptyPath : it.value()[static_cast<size_t>(attr)];
+        }
+
+        [[nodiscard]] const QByteArray &fan(const QString &hwmon, const Fan attr) const {
+            return (!hwmon.isEmpty() && hwmon == fanHWMon) ? fanTable[static_cast<size_t>(attr)] : emptyPath;
+        }
+    };
+}
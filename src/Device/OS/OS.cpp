@@ -21,6 +21,7 @@
 namespace PWTD {
     OS::OS() {
         logger = FileLogger::getInstance();
+        applyEngine = ApplyEngine::getInstance();
     }
 
     void OS::collectSystemInfo() {
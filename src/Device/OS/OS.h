@@ -18,7 +18,9 @@
 #pragma once
 
 #include "../../Utils/FileLogger/FileLogger.h"
+#include "../ApplyEngine.h"
 #include "../FAN/Include/FanControls.h"
+#include "../Telemetry/TelemetrySample.h"
 #include "pwtShared/Include/SystemInfo.h"
 #include "pwtShared/Include/Features.h"
 #include "pwtShared/Include/GPU/GPUVendor.h"
@@ -30,6 +32,7 @@ namespace PWTD {
     protected:
         QSharedPointer<PWTS::SystemInfo> sysInfo;
         QSharedPointer<FileLogger> logger;
+        QSharedPointer<ApplyEngine> applyEngine;
 
         [[nodiscard]] virtual QString getBiosVendor() const = 0;
         [[nodiscard]] virtual QString getBiosVersion() const = 0;
@@ -58,6 +61,8 @@ namespace PWTD {
         virtual void fillDaemonPacket(const PWTS::Features &features, PWTS::CPUVendor cpuVendor, int numLogicalCPUs, PWTS::DaemonPacket &packet) const = 0;
         [[nodiscard]] virtual QSet<PWTS::DError> applySettings(const PWTS::Features &features, PWTS::CPUVendor cpuVendor, int numLogicalCPUs, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const = 0;
         [[nodiscard]] virtual QList<int> getCPUCoreIndexList() const = 0;
+        [[nodiscard]] virtual QList<int> getCPUCurrentFrequency(int numLogicalCPUs) const = 0;
+        [[nodiscard]] virtual PWTS::ROData<int> getCPUPackageTemperature() const { return {}; } // celsius, from a driver, no msr or smu access
         [[nodiscard]] virtual QList<int> getGPUIndexList() const = 0;
         [[nodiscard]] virtual PWTS::GPUVendor getGPUVendor(int index) const = 0;
         [[nodiscard]] virtual QString getGPUDeviceID(int index) const = 0;
@@ -746,6 +746,35 @@ namespace PWTD::WIN {
     	return coreMap.values();
 	}
 
+	QList<int> OSWindows::getCPUCurrentFrequency(const int numLogicalCPUs) const {
+    	// documented, but not declared in the sdk headers
+    	struct ProcessorPowerInformation {
+    		ULONG number;
+    		ULONG maxMhz;
+    		ULONG currentMhz;
+    		ULONG mhzLimit;
+    		ULONG maxIdleState;
+    		ULONG currentIdleState;
+    	};
+    	const std::unique_ptr<ProcessorPowerInformation[]> info = std::make_unique<ProcessorPowerInformation[]>(numLogicalCPUs);
+    	const LONG ret = CallNtPowerInformation(ProcessorInformation, nullptr, 0, info.get(), sizeof(ProcessorPowerInformation) * numLogicalCPUs);
+    	QList<int> freqList;
+
+    	if (ret != 0) {
+    		if (logger->isLevel(PWTS::LogLevel::Error))
+    			logger->write(QString("failed to get processor information, code: %1").arg(ret));
+
+    		return QList<int>(numLogicalCPUs, TelemetrySample::Unavailable);
+    	}
+
+    	freqList.reserve(numLogicalCPUs);
+
+    	for (int i=0; i<numLogicalCPUs; ++i)
+    		freqList.append(static_cast<int>(info[i].currentMhz));
+
+    	return freqList;
+	}
+
     QString OSWindows::getMicrocodeRevision(const int cpu) const {
     	QString errStr;
     	DWORD dataSz = 0;
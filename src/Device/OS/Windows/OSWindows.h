@@ -115,6 +115,7 @@ namespace PWTD::WIN {
 		void fillDaemonPacket(const PWTS::Features &features, PWTS::CPUVendor cpuVendor, int numLogicalCPUs, PWTS::DaemonPacket &packet) const override;
         [[nodiscard]] QSet<PWTS::DError> applySettings(const PWTS::Features &features, PWTS::CPUVendor cpuVendor, int numLogicalCPUs, const QList<int> &coreIdxList, const PWTS::ClientPacket &packet) const override;
 		[[nodiscard]] QList<int> getCPUCoreIndexList() const override;
+		[[nodiscard]] QList<int> getCPUCurrentFrequency(int numLogicalCPUs) const override;
 		[[nodiscard]] QList<int> getGPUIndexList() const override;
 		[[nodiscard]] PWTS::GPUVendor getGPUVendor(int index) const override;
 		[[nodiscard]] QString getGPUDeviceID(int index) const override;
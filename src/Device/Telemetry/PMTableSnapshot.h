@@ -0,0 +1,42 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QDataStream>
+#include <QList>
+
+namespace PWTD {
+    // copy of the cached smu pm table, raw floats laid out as ryzenadj's table definitions for this version
+    struct PMTableSnapshot final {
+        quint32 version = 0; // 0 if the cpu has no pm table
+        qint64 age = -1; // msecs since the table was refreshed
+        QList<float> raw;
+    };
+
+    inline QDataStream &operator<<(QDataStream &ds, const PMTableSnapshot &snapshot) {
+        ds << snapshot.version << snapshot.age << snapshot.raw;
+
+        return ds;
+    }
+
+    inline QDataStream &operator>>(QDataStream &ds, PMTableSnapshot &snapshot) {
+        ds >> snapshot.version >> snapshot.age >> snapshot.raw;
+
+        return ds;
+    }
+}
@@ -0,0 +1,180 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TelemetryHistory.h"
+
+namespace PWTD {
+    TelemetryHistory::TelemetryHistory() {
+        logger = FileLogger::getInstance();
+        tiers.resize(3);
+
+        tiers[0].resolution = 1000; // 10 minutes
+        tiers[0].span = 600;
+        tiers[1].resolution = 10000; // 2 hours
+        tiers[1].span = 720;
+        tiers[2].resolution = 60000; // 24 hours
+        tiers[2].span = 1440;
+    }
+
+    QSharedPointer<TelemetryHistory> TelemetryHistory::getInstance() {
+        if (instance.isNull())
+            instance.reset(new TelemetryHistory);
+
+        return instance;
+    }
+
+    void TelemetryHistory::setMemoryBudget(const int kib) {
+        memoryBudget = qMax(0, kib);
+    }
+
+    // tiers keep their resolution and lose span when the budget is too small for all of them
+    void TelemetryHistory::init(const TelemetrySample &sample) {
+        numCPUs = sample.cpuFrequency.size();
+        numFans = sample.fanSpeed.size();
+
+        channels.clear();
+        channels.append(QStringLiteral("temp"));
+        channels.append(QStringLiteral("power"));
+
+        for (int i=0; i<numCPUs; ++i)
+            channels.append(QString("cpu%1").arg(i));
+
+        for (const QString &fan: sample.fanSpeed.keys())
+            channels.append(QString("fan:%1").arg(fan));
+
+        const qint64 slotSize = sizeof(qint64) + (channels.size() * sizeof(int));
+        const qint64 budget = static_cast<qint64>(memoryBudget) * 1024;
+        qint64 wanted = 0;
+
+        for (const Tier &tier: std::as_const(tiers))
+            wanted += tier.span * slotSize;
+
+        const double scale = qMin(1.0, static_cast<double>(budget) / static_cast<double>(wanted));
+        qint64 used = 0;
+
+        for (Tier &tier: tiers) {
+            tier.capacity = qMax(2, static_cast<int>(tier.span * scale));
+            tier.head = 0;
+            tier.count = 0;
+            tier.bucket = -1;
+            tier.timestamps.fill(0, tier.capacity);
+            tier.values.fill(TelemetrySample::Unavailable, tier.capacity * channels.size());
+            tier.sums.fill(0, channels.size());
+            tier.samples.fill(0, channels.size());
+            used += tier.capacity * slotSize;
+        }
+
+        if (logger->isLevel(PWTS::LogLevel::Info))
+            logger->write(QString("telemetry history: %1 channels, %2 KiB, %3/%4/%5 points").arg(channels.size()).arg(used / 1024)
+                          .arg(tiers[0].capacity).arg(tiers[1].capacity).arg(tiers[2].capacity));
+    }
+
+    void TelemetryHistory::accumulate(Tier &tier, const int channel, const int value) const {
+        if (value == TelemetrySample::Unavailable)
+            return;
+
+        tier.sums[channel] += value;
+        ++tier.samples[channel];
+    }
+
+    void TelemetryHistory::flush(Tier &tier) const {
+        const int numChannels = channels.size();
+        int *row = tier.values.data() + (tier.head * numChannels);
+
+        tier.timestamps[tier.head] = tier.bucket;
+
+        for (int i=0; i<numChannels; ++i) {
+            row[i] = tier.samples[i] > 0 ? static_cast<int>(tier.sums[i] / tier.samples[i]) : TelemetrySample::Unavailable;
+            tier.sums[i] = 0;
+            tier.samples[i] = 0;
+        }
+
+        tier.head = (tier.head + 1) % tier.capacity;
+        tier.count = qMin(tier.count + 1, tier.capacity);
+    }
+
+    qint64 TelemetryHistory::getOldestTimestamp(const Tier &tier) const {
+        return tier.timestamps[(tier.head - tier.count + tier.capacity) % tier.capacity];
+    }
+
+    // a point is written once its interval is over, the one being averaged is not visible yet
+    void TelemetryHistory::insert(const TelemetrySample &sample) {
+        if (!isEnabled())
+            return;
+
+        if (channels.isEmpty() || sample.cpuFrequency.size() != numCPUs || sample.fanSpeed.size() != numFans)
+            init(sample);
+
+        for (Tier &tier: tiers) {
+            const qint64 bucket = sample.timestamp - (sample.timestamp % tier.resolution);
+            int channel = 2;
+
+            if (tier.bucket != bucket) {
+                if (tier.bucket >= 0)
+                    flush(tier);
+
+                tier.bucket = bucket;
+            }
+
+            accumulate(tier, 0, sample.packageTemp);
+            accumulate(tier, 1, sample.packagePower);
+
+            for (const int freq: sample.cpuFrequency)
+                accumulate(tier, channel++, freq);
+
+            for (const int speed: sample.fanSpeed)
+                accumulate(tier, channel++, speed);
+        }
+    }
+
+    // the finest tier that still holds from, or the one reaching furthest back
+    TelemetryHistoryRange TelemetryHistory::fetch(const qint64 from, const qint64 to) const {
+        TelemetryHistoryRange range;
+        const Tier *tier = nullptr;
+
+        for (const Tier &t: tiers) {
+            if (t.count == 0)
+                continue;
+
+            tier = &t;
+
+            if (getOldestTimestamp(t) <= from)
+                break;
+        }
+
+        if (tier == nullptr)
+            return range;
+
+        const int numChannels = channels.size();
+
+        range.resolution = tier->resolution;
+        range.channels = channels;
+
+        for (int i=0; i<tier->count; ++i) {
+            const int slot = (tier->head - tier->count + i + tier->capacity) % tier->capacity;
+            const qint64 ts = tier->timestamps[slot];
+
+            if (ts < from || ts > to)
+                continue;
+
+            range.timestamps.append(ts);
+            range.values.append(tier->values.mid(slot * numChannels, numChannels));
+        }
+
+        return range;
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QSharedPointer>
+
+#include "TelemetrySample.h"
+#include "../../Utils/FileLogger/FileLogger.h"
+
+namespace PWTD {
+    // points of a single history tier, values is a row of channels per timestamp
+    struct TelemetryHistoryRange final {
+        qint64 resolution = 0; // msecs between points
+        QList<QString> channels;
+        QList<qint64> timestamps; // msecs since epoch, start of each point
+        QList<int> values; // timestamps.size() * channels.size(), -1 where no value was sampled
+    };
+
+    inline QDataStream &operator<<(QDataStream &ds, const TelemetryHistoryRange &range) {
+        ds << range.resolution << range.channels << range.timestamps << range.values;
+
+        return ds;
+    }
+
+    inline QDataStream &operator>>(QDataStream &ds, TelemetryHistoryRange &range) {
+        ds >> range.resolution >> range.channels >> range.timestamps >> range.values;
+
+        return ds;
+    }
+
+    // fixed memory history of telemetry samples, averaged into tiers of decreasing resolution (1s, 10s, 1min)
+    // every buffer is allocated when the first sample sets the channels, inserting after that is O(1) and allocation free
+    // single writer, no locks, inserts and fetches both run on the device thread
+    class TelemetryHistory final {
+    public:
+        static constexpr int DefaultMemoryBudget = 1024; // KiB
+
+    private:
+        struct Tier final {
+            qint64 resolution = 0; // msecs
+            int span = 0; // wanted number of points
+            int capacity = 0;
+            int head = 0; // next slot to write
+            int count = 0;
+            QList<qint64> timestamps;
+            QList<int> values; // capacity * channels
+            qint64 bucket = -1; // start of the point being averaged
+            QList<qint64> sums;
+            QList<int> samples;
+        };
+
+        inline static QSharedPointer<TelemetryHistory> instance;
+        QSharedPointer<FileLogger> logger;
+        int memoryBudget = DefaultMemoryBudget;
+        QList<QString> channels;
+        int numCPUs = 0;
+        int numFans = 0;
+        QList<Tier> tiers;
+
+        TelemetryHistory();
+
+        void init(const TelemetrySample &sample);
+        void accumulate(Tier &tier, int channel, int value) const;
+        void flush(Tier &tier) const;
+        [[nodiscard]] qint64 getOldestTimestamp(const Tier &tier) const;
+
+    public:
+        [[nodiscard]] static QSharedPointer<TelemetryHistory> getInstance();
+        void setMemoryBudget(int kib);
+        [[nodiscard]] bool isEnabled() const { return memoryBudget > 0; }
+        [[nodiscard]] qint64 getSampleInterval() const { return 1000; }
+        void insert(const TelemetrySample &sample);
+        [[nodiscard]] TelemetryHistoryRange fetch(qint64 from, qint64 to) const;
+    };
+}
@@ -0,0 +1,51 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QDataStream>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+namespace PWTD {
+    // small subset of the daemon packet for clients that only graph values, sampled once per telemetry tick
+    struct TelemetrySample final {
+        static constexpr int Unavailable = -1;
+
+        qint64 timestamp = 0; // msecs since epoch
+        int packageTemp = Unavailable; // celsius
+        int packagePower = Unavailable; // milliwatts
+        QList<int> cpuFrequency; // mhz, per logical cpu, effective frequency when aperf/mperf are available
+        QList<int> c0Residency; // per mille, per logical cpu, empty without aperf/mperf
+        QMap<QString, int> fanSpeed; // fan id, duty or speed as reported by the fan controls
+        QMap<QString, int> domainPower; // milliwatts, power domains the cpu reports
+        int frequencySamplingCost = Unavailable; // usecs spent reading aperf/mperf
+    };
+
+    inline QDataStream &operator<<(QDataStream &ds, const TelemetrySample &sample) {
+        ds << sample.timestamp << sample.packageTemp << sample.packagePower << sample.cpuFrequency << sample.c0Residency << sample.fanSpeed << sample.domainPower << sample.frequencySamplingCost;
+
+        return ds;
+    }
+
+    inline QDataStream &operator>>(QDataStream &ds, TelemetrySample &sample) {
+        ds >> sample.timestamp >> sample.packageTemp >> sample.packagePower >> sample.cpuFrequency >> sample.c0Residency >> sample.fanSpeed >> sample.domainPower >> sample.frequencySamplingCost;
+
+        return ds;
+    }
+}
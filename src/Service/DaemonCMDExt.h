@@ -0,0 +1,37 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+namespace PWTD {
+    // daemon side commands not part of pwtShared DCMD, kept far above its range so they never collide
+    static constexpr int DCMDExtBase = 0x1000;
+
+    enum class DCMDExt: int {
+        GET_DAEMON_PACKET_DELTA = DCMDExtBase,
+        SUBSCRIBE_TELEMETRY, // interval in msecs, replies with the accepted interval
+        UNSUBSCRIBE_TELEMETRY,
+        TELEMETRY_SAMPLE, // daemon push only
+        FETCH_TELEMETRY_HISTORY, // from and to in msecs since epoch, to 0 is now, replies with a TelemetryHistoryRange
+        GET_PM_TABLE, // optional max table age in msecs, replies with a PMTableSnapshot
+        NEGOTIATE_COMPRESSION // true if the client reads zlib frames, replies with the size threshold or 0 if off, handled by ServiceWorker
+    };
+
+    [[nodiscard]] constexpr bool isDCMDExt(const int cmd) {
+        return cmd >= DCMDExtBase;
+    }
+}
@@ -0,0 +1,277 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QRandomGenerator>
+
+#include "DaemonPacketDelta.h"
+#include "pwtShared/Utils.h"
+
+namespace PWTD {
+    template <typename T>
+    [[nodiscard]] static QByteArray packPart(const T &value) {
+        QByteArray data;
+
+        if (!PWTS::packData<T>(value, data))
+            data.clear();
+
+        return data;
+    }
+
+    // packs the split members of one section struct and resets them in its base copy
+    template <typename S>
+    class SectionSplitter final {
+    private:
+        const DaemonPacketDelta::Section section;
+        QHash<int, QByteArray> &parts;
+        S base;
+
+    public:
+        SectionSplitter(const DaemonPacketDelta::Section sec, const S &data, QHash<int, QByteArray> &out): section(sec), parts(out), base(data) {}
+
+        template <typename E, typename M>
+        void member(const E id, M S::*field) {
+            parts.insert(DaemonPacketDelta::makeKey(section, static_cast<int>(id)), packPart<M>(base.*field));
+            base.*field = M {};
+        }
+
+        template <typename E, typename T>
+        void list(const E id, QList<T> S::*field) {
+            const QList<T> items = base.*field;
+
+            parts.insert(DaemonPacketDelta::makeKey(section, static_cast<int>(id)), packPart<int>(static_cast<int>(items.size())));
+
+            for (int i=0,l=items.size(); i<l; ++i)
+                parts.insert(DaemonPacketDelta::makeKey(section, static_cast<int>(id), i + 1), packPart<T>(items[i]));
+
+            base.*field = {};
+        }
+
+        [[nodiscard]] QSharedPointer<S> getBase() const { return QSharedPointer<S>::create(base); }
+    };
+
+    // top bits left clear, a daemon can't run long enough to wrap
+    DaemonPacketDelta::DaemonPacketDelta() {
+        firstGeneration = QRandomGenerator::system()->generate64() >> 8;
+        generation = firstGeneration;
+    }
+
+    PWTS::DaemonPacket DaemonPacketDelta::getSectionPacket(const PWTS::DaemonPacket &packet, const Section section) {
+        PWTS::DaemonPacket part;
+
+        part.os = packet.os;
+        part.vendor = packet.vendor;
+
+        switch (section) {
+            case Section::Header: {
+                part.profilesList = packet.profilesList;
+                part.activeProfile = packet.activeProfile;
+                part.hasProfileData = packet.hasProfileData;
+                part.errors = packet.errors;
+            }
+                break;
+            case Section::DynamicSystemInfo:
+                part.dynSysInfo = packet.dynSysInfo;
+                break;
+            case Section::IntelData:
+                part.intelData = packet.intelData;
+                break;
+            case Section::AMDData:
+                part.amdData = packet.amdData;
+                break;
+            case Section::LinuxData:
+                part.linuxData = packet.linuxData;
+                break;
+            case Section::LinuxAMDData:
+                part.linuxAmdData = packet.linuxAmdData;
+                break;
+            case Section::WindowsData:
+                part.windowsData = packet.windowsData;
+                break;
+            case Section::FanData:
+                part.fanData = packet.fanData;
+                break;
+            default:
+                break;
+        }
+
+        return part;
+    }
+
+    // a section missing on this device only has its base, a daemon packet with that section null
+    void DaemonPacketDelta::collectParts(const PWTS::DaemonPacket &packet, const Section section, QHash<int, QByteArray> &parts) {
+        PWTS::DaemonPacket base = getSectionPacket(packet, section);
+
+        switch (section) {
+            case Section::IntelData: {
+                if (packet.intelData.isNull())
+                    break;
+
+                SectionSplitter<PWTS::Intel::IntelData> split(section, *packet.intelData, parts);
+
+                split.list(IntelMember::CoreData, &PWTS::Intel::IntelData::coreData);
+                split.list(IntelMember::ThreadData, &PWTS::Intel::IntelData::threadData);
+                split.member(IntelMember::PkgPowerLimit, &PWTS::Intel::IntelData::pkgPowerLimit);
+                split.member(IntelMember::VRCurrentCfg, &PWTS::Intel::IntelData::vrCurrentCfg);
+                split.member(IntelMember::TurboPowerCurrentLimit, &PWTS::Intel::IntelData::turboPowerCurrentLimit);
+                split.member(IntelMember::TurboRatioLimit, &PWTS::Intel::IntelData::turboRatioLimit);
+                split.member(IntelMember::MiscProcFeatures, &PWTS::Intel::IntelData::miscProcFeatures);
+                split.member(IntelMember::PowerCtl, &PWTS::Intel::IntelData::powerCtl);
+                split.member(IntelMember::MiscPwrMgmt, &PWTS::Intel::IntelData::miscPwrMgmt);
+                split.member(IntelMember::HWPRequestPkg, &PWTS::Intel::IntelData::hwpRequestPkg);
+                split.member(IntelMember::UndervoltData, &PWTS::Intel::IntelData::undervoltData);
+                split.member(IntelMember::EnergyPerfBias, &PWTS::Intel::IntelData::energyPerfBias);
+                split.member(IntelMember::HWPEnable, &PWTS::Intel::IntelData::hwpEnable);
+                split.member(IntelMember::HWPPkgCtlPolarity, &PWTS::Intel::IntelData::hwpPkgCtlPolarity);
+                split.member(IntelMember::MCHBARPkgRaplLimit, &PWTS::Intel::IntelData::mchbarPkgRaplLimit);
+
+                base.intelData = split.getBase();
+            }
+                break;
+            case Section::AMDData: {
+                if (packet.amdData.isNull())
+                    break;
+
+                SectionSplitter<PWTS::AMD::AMDData> split(section, *packet.amdData, parts);
+
+                split.list(AMDMember::CoreData, &PWTS::AMD::AMDData::coreData);
+                split.list(AMDMember::ThreadData, &PWTS::AMD::AMDData::threadData);
+                split.member(AMDMember::StapmLimit, &PWTS::AMD::AMDData::stapmLimit);
+                split.member(AMDMember::FastLimit, &PWTS::AMD::AMDData::fastLimit);
+                split.member(AMDMember::SlowLimit, &PWTS::AMD::AMDData::slowLimit);
+                split.member(AMDMember::APUSlow, &PWTS::AMD::AMDData::apuSlow);
+                split.member(AMDMember::TctlTemp, &PWTS::AMD::AMDData::tctlTemp);
+                split.member(AMDMember::APUSkinTemp, &PWTS::AMD::AMDData::apuSkinTemp);
+                split.member(AMDMember::DGPUSkinTemp, &PWTS::AMD::AMDData::dgpuSkinTemp);
+                split.member(AMDMember::VRMCurrent, &PWTS::AMD::AMDData::vrmCurrent);
+                split.member(AMDMember::VRMMaxCurrent, &PWTS::AMD::AMDData::vrmMaxCurrent);
+                split.member(AMDMember::VRMSocCurrent, &PWTS::AMD::AMDData::vrmSocCurrent);
+                split.member(AMDMember::VRMSocMaxCurrent, &PWTS::AMD::AMDData::vrmSocMaxCurrent);
+                split.member(AMDMember::StaticGfxClock, &PWTS::AMD::AMDData::staticGfxClock);
+                split.member(AMDMember::MinGfxClock, &PWTS::AMD::AMDData::minGfxClock);
+                split.member(AMDMember::MaxGfxClock, &PWTS::AMD::AMDData::maxGfxClock);
+                split.member(AMDMember::PowerProfile, &PWTS::AMD::AMDData::powerProfile);
+                split.member(AMDMember::CurveOptimizer, &PWTS::AMD::AMDData::curveOptimizer);
+                split.member(AMDMember::CPPCEnableBit, &PWTS::AMD::AMDData::cppcEnableBit);
+                split.member(AMDMember::PStateCurrentLimit, &PWTS::AMD::AMDData::pstateCurrentLimit);
+
+                base.amdData = split.getBase();
+            }
+                break;
+            case Section::LinuxData: {
+                if (packet.linuxData.isNull())
+                    break;
+
+                SectionSplitter<PWTS::LNX::LinuxData> split(section, *packet.linuxData, parts);
+
+                split.list(LinuxMember::ThreadData, &PWTS::LNX::LinuxData::threadData);
+                split.member(LinuxMember::SMTState, &PWTS::LNX::LinuxData::smtState);
+                split.member(LinuxMember::CPUIdleAvailableGovernors, &PWTS::LNX::LinuxData::cpuIdleAvailableGovernors);
+                split.member(LinuxMember::CPUIdleGovernor, &PWTS::LNX::LinuxData::cpuIdleGovernor);
+                split.member(LinuxMember::BlockDevicesQueSched, &PWTS::LNX::LinuxData::blockDevicesQueSched);
+                split.member(LinuxMember::MiscPMDevices, &PWTS::LNX::LinuxData::miscPMDevices);
+                split.member(LinuxMember::IntelGPUData, &PWTS::LNX::LinuxData::intelGpuData);
+                split.member(LinuxMember::AMDGPUData, &PWTS::LNX::LinuxData::amdGpuData);
+
+                base.linuxData = split.getBase();
+            }
+                break;
+            case Section::LinuxAMDData: {
+                if (packet.linuxAmdData.isNull())
+                    break;
+
+                SectionSplitter<PWTS::LNX::AMD::LinuxAMDData> split(section, *packet.linuxAmdData, parts);
+
+                split.list(LinuxAMDMember::ThreadData, &PWTS::LNX::AMD::LinuxAMDData::threadData);
+                split.member(LinuxAMDMember::PStateStatus, &PWTS::LNX::AMD::LinuxAMDData::pstateStatus);
+
+                base.linuxAmdData = split.getBase();
+            }
+                break;
+            case Section::WindowsData: {
+                if (packet.windowsData.isNull())
+                    break;
+
+                SectionSplitter<PWTS::WIN::WindowsData> split(section, *packet.windowsData, parts);
+
+                split.member(WindowsMember::Schemes, &PWTS::WIN::WindowsData::schemes);
+                split.member(WindowsMember::ActiveScheme, &PWTS::WIN::WindowsData::activeScheme);
+                split.member(WindowsMember::SchemeOptionsData, &PWTS::WIN::WindowsData::schemeOptionsData);
+
+                base.windowsData = split.getBase();
+            }
+                break;
+            default:
+                break;
+        }
+
+        parts.insert(makeKey(section), packPart<PWTS::DaemonPacket>(base));
+    }
+
+    // parts are compared as packed bytes, a part gone since the last record is reported by its changed count or base
+    void DaemonPacketDelta::record(const PWTS::DaemonPacket &packet) {
+        const quint64 next = generation + 1;
+        QHash<int, QByteArray> parts;
+        bool changed = false;
+
+        parts.reserve(lastParts.size());
+
+        for (int i=0; i<static_cast<int>(Section::Count); ++i)
+            collectParts(packet, static_cast<Section>(i), parts);
+
+        for (auto it = parts.constBegin(); it != parts.constEnd(); ++it) {
+            const auto last = lastParts.constFind(it.key());
+
+            if (last != lastParts.constEnd() && last.value() == it.value())
+                continue;
+
+            partGenerations.insert(it.key(), next);
+            changed = true;
+        }
+
+        for (auto it = partGenerations.begin(); it != partGenerations.end();) {
+            if (parts.contains(it.key())) {
+                ++it;
+                continue;
+            }
+
+            it = partGenerations.erase(it);
+            changed = true;
+        }
+
+        lastParts = parts;
+
+        if (changed)
+            generation = next;
+    }
+
+    QHash<int, QByteArray> DaemonPacketDelta::getDelta(const quint64 ackGeneration, bool &full) const {
+        QHash<int, QByteArray> ret;
+
+        // unknown generation (never acked, from a previous daemon or from the future) means full resync
+        full = ackGeneration <= firstGeneration || ackGeneration > generation;
+
+        if (full)
+            return lastParts;
+
+        for (auto it = partGenerations.constBegin(); it != partGenerations.constEnd(); ++it) {
+            if (it.value() > ackGeneration)
+                ret.insert(it.key(), lastParts.value(it.key()));
+        }
+
+        return ret;
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QHash>
+
+#include "pwtShared/Include/Packets/DaemonPacket.h"
+
+namespace PWTD {
+    // tracks daemon packets per part, a client acks a generation and only gets the parts changed since then
+    // one recorded packet serves every client, each with its own acked generation
+    // a vendor or os section is split into its base, its members below and one part per list entry, the other sections are one part
+    // part key is section << 24 | member << 16 | entry, entry 0 is the whole member or the entry count of a list, entry n is list item n - 1
+    // a base is a daemon packet holding the section with the split members reset, the client merges it with the shared deserializer
+    // members, counts (int) and list items are their own QDataStream serialization, a shorter count drops the tail entries
+    // generations start at a random value per process, an ack from a previous daemon falls outside the known range
+    class DaemonPacketDelta final {
+    public:
+        enum class Section: int {
+            Header,
+            DynamicSystemInfo,
+            IntelData,
+            AMDData,
+            LinuxData,
+            LinuxAMDData,
+            WindowsData,
+            FanData,
+            Count
+        };
+
+        enum class IntelMember: int {
+            Base,
+            CoreData,
+            ThreadData,
+            PkgPowerLimit,
+            VRCurrentCfg,
+            TurboPowerCurrentLimit,
+            TurboRatioLimit,
+            MiscProcFeatures,
+            PowerCtl,
+            MiscPwrMgmt,
+            HWPRequestPkg,
+            UndervoltData,
+            EnergyPerfBias,
+            HWPEnable,
+            HWPPkgCtlPolarity,
+            MCHBARPkgRaplLimit
+        };
+
+        enum class AMDMember: int {
+            Base,
+            CoreData,
+            ThreadData,
+            StapmLimit,
+            FastLimit,
+            SlowLimit,
+            APUSlow,
+            TctlTemp,
+            APUSkinTemp,
+            DGPUSkinTemp,
+            VRMCurrent,
+            VRMMaxCurrent,
+            VRMSocCurrent,
+            VRMSocMaxCurrent,
+            StaticGfxClock,
+            MinGfxClock,
+            MaxGfxClock,
+            PowerProfile,
+            CurveOptimizer,
+            CPPCEnableBit,
+            PStateCurrentLimit
+        };
+
+        enum class LinuxMember: int {
+            Base,
+            ThreadData,
+            SMTState,
+            CPUIdleAvailableGovernors,
+            CPUIdleGovernor,
+            BlockDevicesQueSched,
+            MiscPMDevices,
+            IntelGPUData,
+            AMDGPUData
+        };
+
+        enum class LinuxAMDMember: int {
+            Base,
+            ThreadData,
+            PStateStatus
+        };
+
+        enum class WindowsMember: int {
+            Base,
+            Schemes,
+            ActiveScheme,
+            SchemeOptionsData
+        };
+
+        [[nodiscard]]
+        static constexpr int makeKey(const Section section, const int member = 0, const int entry = 0) {
+            return static_cast<int>(section) << 24 | member << 16 | entry;
+        }
+
+    private:
+        quint64 firstGeneration; // acks in (firstGeneration, generation] are known
+        quint64 generation;
+        QHash<int, QByteArray> lastParts; // packed parts of the last recorded packet
+        QHash<int, quint64> partGenerations; // generation in which each part last changed
+
+        [[nodiscard]] static PWTS::DaemonPacket getSectionPacket(const PWTS::DaemonPacket &packet, Section section);
+        static void collectParts(const PWTS::DaemonPacket &packet, Section section, QHash<int, QByteArray> &parts);
+
+    public:
+        DaemonPacketDelta();
+
+        void record(const PWTS::DaemonPacket &packet);
+        [[nodiscard]] QHash<int, QByteArray> getDelta(quint64 ackGeneration, bool &full) const; // against the last recorded packet
+        [[nodiscard]] quint64 getGeneration() const { return generation; }
+    };
+}
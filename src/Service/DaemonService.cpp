@@ -15,11 +15,14 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <QDateTime>
+
 #include "../../version.h"
 #include "DaemonService.h"
 #include "../Utils/DaemonUtils.h"
 #include "../Utils/AppDataPath.h"
 #include "PowerNotifications/PowerNotificationsFactory.h"
+#include "TelemetryExport/TelemetryExportFactory.h"
 #include "pwtShared/Utils.h"
 
 namespace PWTD {
@@ -28,13 +31,34 @@ namespace PWTD {
         logger = FileLogger::getInstance();
 		powerNotifications = PowerNotificationsFactory::getPowerNotifications();
         daemonSettingDiskMan = DaemonSettingDiskManager::getInstance();
+        telemetryHistory = TelemetryHistory::getInstance();
+        telemetryExport = TelemetryExportFactory::getTelemetryExport();
 
         profileDiskMan.reset(new ProfileDiskManager(device->getDeviceHash(), device->getCPUVendor()));
         daemonSettings.reset(new PWTS::DaemonSettings);
+
+        deviceWorker = new DeviceWorker();
+        deviceThread = new QThread();
+
+        // device timers must fire on the same thread that applies settings
+        deviceWorker->moveToThread(deviceThread);
+        device->moveToThread(deviceThread);
+
+        QObject::connect(deviceThread, &QThread::finished, deviceWorker, &QObject::deleteLater);
+
+        deviceThread->start();
     }
 
     DaemonService::~DaemonService() {
         stopApplyTimer();
+        unsubscribeAllTelemetry();
+
+        if (!sampleTimer.isNull())
+            sampleTimer->stop();
+
+        deviceThread->quit();
+        deviceThread->wait();
+        delete deviceThread;
         serviceThread->quit();
         serviceThread->wait();
         delete serviceThread;
@@ -107,7 +131,7 @@ namespace PWTD {
             }
 
             applyTimer->setInterval(daemonSettings->getApplyInterval() * 1000);
-            applyTimer->start();
+            startApplyTimer();
         }
     }
 
@@ -119,7 +143,7 @@ namespace PWTD {
     }
 
     void DaemonService::startApplyTimer() const {
-        if (applyTimer.isNull())
+        if (applyTimer.isNull() || deviceJobs > 0)
             return;
 
         applyTimer->start();
@@ -133,7 +157,26 @@ namespace PWTD {
             logger->write(PWTS::getErrorStr(e));
     }
 
-    PWTS::DeviceInfoPacket DaemonService::createDeviceInfoPacket() const {
+    void DaemonService::postDeviceJob(const DeviceJob &job, const DeviceWorker::Coalesce key) {
+        stopApplyTimer();
+
+        const bool queued = deviceWorker->post([this, job]() {
+            const std::function<void()> onDone = job();
+
+            QMetaObject::invokeMethod(this, [this, onDone]() {
+                if (onDone)
+                    onDone();
+
+                --deviceJobs;
+                startApplyTimer();
+            });
+        }, key);
+
+        if (queued)
+            ++deviceJobs;
+    }
+
+    PWTS::DeviceInfoPacket DaemonService::createDeviceInfoPacket(const QByteArray &settingsData) const {
         PWTS::DeviceInfoPacket packet;
 
         packet.daemonMajorVersion = PWTD_VER_MAJOR;
@@ -141,7 +184,7 @@ namespace PWTD {
         packet.daemonPwtsMajorVersion = PWTS::getLibMajorVersion();
         packet.daemonPwtsMinorVersion = PWTS::getLibMinorVersion();
         packet.daemonDataPath = AppDataPath::appDataLocation();
-        packet.daemonSettings = daemonSettings->getData();
+        packet.daemonSettings = settingsData;
         packet.sysInfo = *(device->getSystemInfo());
         packet.dynSysInfo = device->getDynamicSystemInfo();
         packet.cpuInfo = *(device->getCPUInfo());
@@ -157,65 +200,248 @@ namespace PWTD {
 
         packet.os = getOS();
         packet.vendor = device->getCPUVendor();
-        packet.dynSysInfo = device->getDynamicSystemInfo();
         packet.profilesList = profileDiskMan->getProfilesList();
         packet.activeProfile = activeProfile;
 
-        device->fillPacketDeviceData(packet);
         return packet;
     }
 
-    void DaemonService::applyClientSettings(const PWTS::ClientPacket &packet) {
-        const QSet<PWTS::DError> errors = device->applySettings(packet);
+    // device thread only
+    void DaemonService::fillDaemonPacket(PWTS::DaemonPacket &packet) const {
+        packet.dynSysInfo = device->getDynamicSystemInfo();
 
-        activeProfile.clear();
-        lastClientPacket.reset();
+        device->fillPacketDeviceData(packet);
+    }
+
+    // the coalesced job replaces an older pending one, so it carries every client that asked so far
+    // clients already answered by a job that finished in the meantime are not answered twice
+    void DaemonService::sendDaemonPacketAsync(const quint64 clientID) {
+        pendingPacketClients.insert(clientID);
+
+        postDeviceJob([this, clientIDs = pendingPacketClients, packet = createDaemonPacket()]()->std::function<void()> {
+            PWTS::DaemonPacket filled = packet;
+
+            fillDaemonPacket(filled);
 
-        if (errors.isEmpty())
-            lastClientPacket = packet;
+            return [this, clientIDs, filled]() {
+                const QSet<quint64> targets = clientIDs & pendingPacketClients;
 
-        emit sendSettingsApplyResult(PWTS::DCMD::APPLY_CLIENT_SETTINGS, errors);
+                pendingPacketClients.subtract(targets);
+
+                if (!targets.isEmpty())
+                    emit sendDaemonPacket(targets.values(), filled);
+            };
+        }, DeviceWorker::Coalesce::DaemonPacket);
     }
 
-    QSet<PWTS::DError> DaemonService::applyProfileSettings(const QString &name) const {
-        PWTS::ClientPacket packet;
+    void DaemonService::sendDaemonPacketDeltaAsync(const quint64 clientID, const quint64 ackGeneration) {
+        pendingDeltaClients.insert(clientID, ackGeneration);
+
+        postDeviceJob([this, acks = pendingDeltaClients, packet = createDaemonPacket()]()->std::function<void()> {
+            PWTS::DaemonPacket filled = packet;
+            QHash<quint64, QPair<bool, QByteArray>> deltas;
+
+            fillDaemonPacket(filled);
+            packetDelta.record(filled);
+
+            for (auto it = acks.constBegin(); it != acks.constEnd(); ++it) {
+                bool full;
+                const QHash<int, QByteArray> parts = packetDelta.getDelta(it.value(), full);
+                QByteArray data;
+
+                if (PWTS::packData<QHash<int, QByteArray>>(parts, data))
+                    deltas.insert(it.key(), {full, data});
+            }
+
+            return [this, acks, deltas, generation = packetDelta.getGeneration()]() {
+                for (auto it = acks.constBegin(); it != acks.constEnd(); ++it) {
+                    if (!pendingDeltaClients.contains(it.key()) || pendingDeltaClients.value(it.key()) != it.value())
+                        continue;
+
+                    pendingDeltaClients.remove(it.key());
+
+                    if (!deltas.contains(it.key())) {
+                        if (logger->isLevel(PWTS::LogLevel::Error))
+                            logger->write(QStringLiteral("failed to pack daemon packet delta"));
+
+                        emit sendError(it.key(), PWTS::DError::CORRUPTED_DATA);
+                        continue;
+                    }
+
+                    const QPair<bool, QByteArray> &delta = deltas[it.key()];
+
+                    emit sendDaemonPacketDelta(it.key(), generation, delta.first, delta.second);
+                }
+            };
+        }, DeviceWorker::Coalesce::DaemonPacketDelta);
+    }
+
+    void DaemonService::subscribeTelemetry(const quint64 clientID, const int interval) {
+        const int accepted = qBound(MinTelemetryInterval, interval, MaxTelemetryInterval);
 
-        if (!profileDiskMan->load(name, packet))
-            return {PWTS::DError::PROFILE_LOAD_FAILED};
+        telemetrySubscriptions.insert(clientID, {accepted, -1});
+        updateTelemetryTimer();
+        emit sendTelemetrySubscription(clientID, accepted);
+    }
+
+    void DaemonService::unsubscribeTelemetry(const quint64 clientID) {
+        if (telemetrySubscriptions.remove(clientID) > 0)
+            updateTelemetryTimer();
+    }
 
-        const QSet<PWTS::DError> errors = device->applySettings(packet);
+    void DaemonService::unsubscribeAllTelemetry() {
+        telemetrySubscriptions.clear();
+        updateTelemetryTimer();
+    }
 
-        if (errors.isEmpty()) {
-            lastClientPacket.reset();
+    // one sample per tick for every subscriber, each client only gets it once its own interval has passed
+    void DaemonService::updateTelemetryTimer() {
+        if (telemetrySubscriptions.isEmpty()) {
+            if (!telemetryTimer.isNull())
+                telemetryTimer->stop();
 
-            activeProfile = name;
-            lastClientPacket = packet;
+            return;
         }
 
-        return errors;
+        int interval = MaxTelemetryInterval;
+
+        for (const TelemetrySubscription &sub: std::as_const(telemetrySubscriptions))
+            interval = qMin(interval, sub.interval);
+
+        if (telemetryTimer.isNull()) {
+            telemetryTimer.reset(new QTimer);
+            telemetryClock.start();
+
+            QObject::connect(telemetryTimer.get(), &QTimer::timeout, this, &DaemonService::onTelemetryTimerTimeout);
+        }
+
+        if (!telemetryTimer->isActive() || telemetryTimer->interval() != interval)
+            telemetryTimer->start(interval);
     }
 
-    void DaemonService::loadProfile(const QString &name) {
-        PWTS::DaemonPacket packet = createDaemonPacket();
+    // runs only while something consumes samples, the export from start or history once a client used telemetry
+    void DaemonService::startTelemetrySampling() {
+        if ((!recordHistory && telemetryExport.isNull()) || !sampleTimer.isNull())
+            return;
 
-        packet.hasProfileData = true;
+        sampleTimer.reset(new QTimer);
 
-        if (!profileDiskMan->load(name, packet)) {
-            if (logger->isLevel(PWTS::LogLevel::Error))
-                logger->write(QString("Failed to load profile %1").arg(name));
+        QObject::connect(sampleTimer.get(), &QTimer::timeout, this, &DaemonService::onSampleTimerTimeout);
 
-            emit sendError(PWTS::DError::PROFILE_LOAD_FAILED);
-            emit sendCMDFail(PWTS::DCMD::LOAD_PROFILE);
+        sampleTimer->start(telemetryHistory->getSampleInterval());
+    }
+
+    // a daemon whose clients never graph anything does not wake up every second for history
+    void DaemonService::startHistoryRecording() {
+        if (recordHistory || !telemetryHistory->isEnabled())
+            return;
+
+        recordHistory = true;
+        startTelemetrySampling();
+    }
+
+    void DaemonService::fetchTelemetryHistory(const quint64 clientID, const qint64 from, const qint64 to) {
+        deviceWorker->post([this, clientID, from, to]() {
+            const TelemetryHistoryRange range = telemetryHistory->fetch(from, to > 0 ? to : QDateTime::currentMSecsSinceEpoch());
+            QByteArray data;
+
+            if (!PWTS::packData<TelemetryHistoryRange>(range, data)) {
+                if (logger->isLevel(PWTS::LogLevel::Error))
+                    logger->write(QStringLiteral("failed to pack telemetry history"));
+
+                data.clear(); // empty reply, the client should not wait for one that never comes
+            }
+
+            QMetaObject::invokeMethod(this, [this, clientID, data]() { emit sendTelemetryHistory(clientID, data); });
+        });
+    }
+
+    void DaemonService::sendPMTableSnapshotAsync(const quint64 clientID, const int maxStaleness) {
+        deviceWorker->post([this, clientID, maxStaleness]() {
+            const PMTableSnapshot snapshot = device->getPMTableSnapshot(maxStaleness);
+            QByteArray data;
+
+            if (!PWTS::packData<PMTableSnapshot>(snapshot, data)) {
+                if (logger->isLevel(PWTS::LogLevel::Error))
+                    logger->write(QStringLiteral("failed to pack pm table snapshot"));
+
+                data.clear(); // empty reply, the client should not wait for one that never comes
+            }
+
+            QMetaObject::invokeMethod(this, [this, clientID, data]() { emit sendPMTableSnapshot(clientID, data); });
+        });
+    }
+
+    // latest apply wins when clients race, so the result goes to everyone
+    void DaemonService::applyClientSettings(const PWTS::ClientPacket &packet) {
+        postDeviceJob([this, packet]()->std::function<void()> {
+            const QSet<PWTS::DError> errors = device->applySettings(packet);
+
+            return [this, packet, errors]() {
+                activeProfile.clear();
+                lastClientPacket.reset();
+
+                if (errors.isEmpty())
+                    lastClientPacket = packet;
+
+                emit sendSettingsApplyResult(ServiceWorker::Broadcast, PWTS::DCMD::APPLY_CLIENT_SETTINGS, errors);
+            };
+        }, DeviceWorker::Coalesce::ApplyClientSettings);
+    }
+
+    void DaemonService::applyProfileSettings(const QString &name, const std::function<void(const QSet<PWTS::DError> &)> &onApplied) {
+        PWTS::ClientPacket packet;
+
+        if (!profileDiskMan->load(name, packet)) {
+            onApplied({PWTS::DError::PROFILE_LOAD_FAILED});
             return;
         }
 
-        if (logger->isLevel(PWTS::LogLevel::Info))
-            logger->write(QString("Loaded profile: %1").arg(name));
+        postDeviceJob([this, name, packet, onApplied]()->std::function<void()> {
+            const QSet<PWTS::DError> errors = device->applySettings(packet);
+
+            return [this, name, packet, onApplied, errors]() {
+                if (errors.isEmpty()) {
+                    lastClientPacket.reset();
+
+                    activeProfile = name;
+                    lastClientPacket = packet;
+                }
+
+                onApplied(errors);
+            };
+        });
+    }
+
+    void DaemonService::loadProfile(const quint64 clientID, const QString &name) {
+        postDeviceJob([this, clientID, name, packet = createDaemonPacket()]()->std::function<void()> {
+            PWTS::DaemonPacket filled = packet;
+
+            fillDaemonPacket(filled);
+
+            return [this, clientID, name, filled]() {
+                PWTS::DaemonPacket profilePacket = filled;
+
+                profilePacket.hasProfileData = true;
+
+                if (!profileDiskMan->load(name, profilePacket)) {
+                    if (logger->isLevel(PWTS::LogLevel::Error))
+                        logger->write(QString("Failed to load profile %1").arg(name));
+
+                    emit sendError(clientID, PWTS::DError::PROFILE_LOAD_FAILED);
+                    emit sendCMDFail(clientID, PWTS::DCMD::LOAD_PROFILE);
+                    return;
+                }
+
+                if (logger->isLevel(PWTS::LogLevel::Info))
+                    logger->write(QString("Loaded profile: %1").arg(name));
 
-        emit sendLoadedProfile(packet, name);
+                emit sendLoadedProfile(clientID, profilePacket, name);
+            };
+        });
     }
 
-    void DaemonService::importProfiles(const QByteArray &profilesData) {
+    void DaemonService::importProfiles(const quint64 clientID, const QByteArray &profilesData) {
         QHash<QString, QByteArray> profiles;
         bool res = true;
 
@@ -237,10 +463,10 @@ namespace PWTD {
                 logger->write(QString("imported profile: %1").arg(it.key()));
         }
 
-        emit sendCmdResult(PWTS::DCMD::IMPORT_PROFILES, res);
+        emit sendCmdResult(clientID, PWTS::DCMD::IMPORT_PROFILES, res);
     }
 
-    void DaemonService::applyDaemonSettings(const QByteArray &data) {
+    void DaemonService::applyDaemonSettings(const quint64 clientID, const QByteArray &data) {
         const QString oldAdr = daemonSettings->getAddress();
         const quint16 oldPort = daemonSettings->getSocketTcpPort();
 
@@ -248,7 +474,7 @@ namespace PWTD {
             if (logger->isLevel(PWTS::LogLevel::Error))
                 logger->write(QStringLiteral("Unable to load daemon settings from data, cannot apply settings!"));
 
-            emit sendCmdResult(PWTS::DCMD::APPLY_DAEMON_SETT, false);
+            emit sendCmdResult(clientID, PWTS::DCMD::APPLY_DAEMON_SETT, false);
             return;
         }
 
@@ -262,7 +488,8 @@ namespace PWTD {
         if (logger->isLevel(PWTS::LogLevel::Info))
             logger->write(QStringLiteral("Daemon settings received and applied from client, saving.."));
 
-        emit sendCmdResult(PWTS::DCMD::APPLY_DAEMON_SETT, daemonSettingDiskMan->save(data));
+        emit sendCmdResult(clientID, PWTS::DCMD::APPLY_DAEMON_SETT, daemonSettingDiskMan->save(data));
+        emit sendByteArray(ServiceWorker::Broadcast, PWTS::DCMD::GET_DAEMON_SETTS, daemonSettings->getData());
     }
 
     void DaemonService::start(const bool hasServer, const QString &adr, const quint16 port) {
@@ -270,7 +497,7 @@ namespace PWTD {
             qWarning("Failed to load daemon settings, using defaults");
 
         if (logger->isLevel(PWTS::LogLevel::Service)) {
-            logger->write(QJsonDocument(PWTS::getDeviceInfoJson(createDeviceInfoPacket())).toJson().toStdString().c_str());
+            logger->write(QJsonDocument(PWTS::getDeviceInfoJson(createDeviceInfoPacket(daemonSettings->getData()))).toJson().toStdString().c_str());
             logger->write(QString("Profiles directory: %1").arg(profileDiskMan->getPath()));
         }
 
@@ -284,6 +511,7 @@ namespace PWTD {
             QObject::connect(serviceThread, &QThread::finished, serviceWorker, &QObject::deleteLater);
             QObject::connect(serviceWorker, &ServiceWorker::logMessageSent, this, &DaemonService::onLogMessageSent);
             QObject::connect(serviceWorker, &ServiceWorker::cmdReceived, this, &DaemonService::onCmdReceived);
+            QObject::connect(serviceWorker, &ServiceWorker::clientDisconnected, this, &DaemonService::onClientDisconnected);
             QObject::connect(this, &DaemonService::connectService, serviceWorker, &ServiceWorker::startServer);
             QObject::connect(this, &DaemonService::restartService, serviceWorker, &ServiceWorker::restartServer);
             QObject::connect(this, &DaemonService::stopService, serviceWorker, &ServiceWorker::stopServer);
@@ -291,20 +519,27 @@ namespace PWTD {
             QObject::connect(this, &DaemonService::sendCMDFail, serviceWorker, &ServiceWorker::sendCMDFail);
             QObject::connect(this, &DaemonService::sendDeviceInfoPacket, serviceWorker, &ServiceWorker::sendDeviceInfoPacket);
             QObject::connect(this, &DaemonService::sendDaemonPacket, serviceWorker, &ServiceWorker::sendDaemonPacket);
+            QObject::connect(this, &DaemonService::sendDaemonPacketDelta, serviceWorker, &ServiceWorker::sendDaemonPacketDelta);
+            QObject::connect(this, &DaemonService::sendTelemetrySubscription, serviceWorker, &ServiceWorker::sendTelemetrySubscription);
+            QObject::connect(this, &DaemonService::sendTelemetrySample, serviceWorker, &ServiceWorker::sendTelemetrySample);
+            QObject::connect(this, &DaemonService::sendTelemetryHistory, serviceWorker, &ServiceWorker::sendTelemetryHistory);
+            QObject::connect(this, &DaemonService::sendPMTableSnapshot, serviceWorker, &ServiceWorker::sendPMTableSnapshot);
             QObject::connect(this, &DaemonService::sendSettingsApplyResult, serviceWorker, &ServiceWorker::sendSettingsApplyResult);
             QObject::connect(this, &DaemonService::sendLoadedProfile, serviceWorker, &ServiceWorker::sendLoadedProfile);
             QObject::connect(this, &DaemonService::sendExportedProfiles, serviceWorker, &ServiceWorker::sendExportedProfiles);
             QObject::connect(this, &DaemonService::sendProfileList, serviceWorker, &ServiceWorker::sendProfileList);
             QObject::connect(this, &DaemonService::sendCmdResult, serviceWorker, &ServiceWorker::sendCmdResult);
             QObject::connect(this, &DaemonService::sendByteArray, serviceWorker, &ServiceWorker::sendByteArray);
-            QObject::connect(profileDiskMan.get(), &ProfileDiskManager::profileDiskChanged, serviceWorker, &ServiceWorker::sendProfileList);
+            QObject::connect(profileDiskMan.get(), &ProfileDiskManager::profileDiskChanged, this, &DaemonService::onProfileDiskChanged);
 
             serviceThread->start();
             emit connectService(getListenAddress(adr), getServerPort(port));
         }
 
+        startTelemetrySampling();
+
         if (!daemonSettings->getOnStartProfile().isEmpty())
-            writeErrorsToLog(applyProfileSettings(daemonSettings->getOnStartProfile()));
+            applyProfileSettings(daemonSettings->getOnStartProfile(), [this](const QSet<PWTS::DError> &errors) { writeErrorsToLog(errors); });
 
 		if (!powerNotifications.isNull()) {
 			powerNotifications->initNotifications();
@@ -318,6 +553,7 @@ namespace PWTD {
 
     void DaemonService::reload(const bool hasServer, const QString &adr, const quint16 port) {
         stopApplyTimer();
+        unsubscribeAllTelemetry();
 
         if (hasServer)
             emit stopService();
@@ -334,7 +570,7 @@ namespace PWTD {
             emit connectService(getListenAddress(adr), getServerPort(port));
 
         if (!daemonSettings->getOnStartProfile().isEmpty())
-            writeErrorsToLog(applyProfileSettings(daemonSettings->getOnStartProfile()));
+            applyProfileSettings(daemonSettings->getOnStartProfile(), [this](const QSet<PWTS::DError> &errors) { writeErrorsToLog(errors); });
 
         setApplyTimer(daemonSettings->getApplyInterval());
     }
@@ -344,9 +580,68 @@ namespace PWTD {
             logger->write(msg);
     }
 
-    void DaemonService::onCmdReceived(const QList<QVariant> &args) {
+    void DaemonService::onExtCmdReceived(const quint64 clientID, const QList<QVariant> &args) {
+        switch (static_cast<DCMDExt>(args[0].toInt())) {
+            case DCMDExt::GET_DAEMON_PACKET_DELTA: // generation 0 or none asks for a full resync
+                sendDaemonPacketDeltaAsync(clientID, args.size() > 1 ? args[1].toULongLong() : 0);
+                break;
+            case DCMDExt::SUBSCRIBE_TELEMETRY: {
+                bool res = false;
+                const int interval = args.size() > 1 ? args[1].toInt(&res) : 0;
+
+                if (!res) {
+                    emit sendError(clientID, PWTS::DError::INVALID_ARGS);
+                    break;
+                }
+
+                startHistoryRecording();
+                subscribeTelemetry(clientID, interval);
+            }
+                break;
+            case DCMDExt::UNSUBSCRIBE_TELEMETRY:
+                unsubscribeTelemetry(clientID);
+                emit sendTelemetrySubscription(clientID, 0);
+                break;
+            case DCMDExt::FETCH_TELEMETRY_HISTORY: {
+                bool fromRes = false;
+                bool toRes = false;
+                const qint64 from = args.size() > 2 ? args[1].toLongLong(&fromRes) : 0;
+                const qint64 to = args.size() > 2 ? args[2].toLongLong(&toRes) : 0;
+
+                if (!fromRes || !toRes) {
+                    emit sendError(clientID, PWTS::DError::INVALID_ARGS);
+                    break;
+                }
+
+                startHistoryRecording();
+                fetchTelemetryHistory(clientID, from, to);
+            }
+                break;
+            case DCMDExt::GET_PM_TABLE: {
+                bool res = true;
+                const int maxStaleness = args.size() > 1 ? args[1].toInt(&res) : DefaultPMTableStaleness;
+
+                if (!res || maxStaleness < 0) {
+                    emit sendError(clientID, PWTS::DError::INVALID_ARGS);
+                    break;
+                }
+
+                sendPMTableSnapshotAsync(clientID, maxStaleness);
+            }
+                break;
+            default:
+                emit sendError(clientID, PWTS::DError::INVALID_DCMD);
+                break;
+        }
+    }
+
+    void DaemonService::onCmdReceived(const quint64 clientID, const QList<QVariant> &args) {
         if (!hasValidMessageArgs(args)) {
-            emit sendError(PWTS::DError::INVALID_ARGS);
+            emit sendError(clientID, PWTS::DError::INVALID_ARGS);
+            return;
+
+        } else if (isDCMDExt(args[0].toInt())) {
+            onExtCmdReceived(clientID, args);
             return;
         }
 
@@ -355,32 +650,37 @@ namespace PWTD {
         const PWTS::DCMD cmd = static_cast<PWTS::DCMD>(args[0].toInt());
 
         switch (cmd) {
-            case PWTS::DCMD::GET_DEVICE_INFO_PACKET:
-                emit sendDeviceInfoPacket(createDeviceInfoPacket());
+            case PWTS::DCMD::GET_DEVICE_INFO_PACKET: {
+                postDeviceJob([this, clientID, settingsData = daemonSettings->getData()]()->std::function<void()> {
+                    const PWTS::DeviceInfoPacket packet = createDeviceInfoPacket(settingsData);
+
+                    return [this, clientID, packet]() { emit sendDeviceInfoPacket(clientID, packet); };
+                });
+            }
                 break;
             case PWTS::DCMD::GET_DAEMON_PACKET:
-                emit sendDaemonPacket(createDaemonPacket());
+                sendDaemonPacketAsync(clientID);
                 break;
             case PWTS::DCMD::APPLY_CLIENT_SETTINGS: {
                 if (!args[1].canConvert<PWTS::ClientPacket>()) {
-                    emit sendError(PWTS::DError::CORRUPTED_DATA);
-                    emit sendCMDFail(cmd);
+                    emit sendError(clientID, PWTS::DError::CORRUPTED_DATA);
+                    emit sendCMDFail(clientID, cmd);
                     break;
                 }
 
                 const PWTS::ClientPacket packet = args[1].value<PWTS::ClientPacket>();
 
                 if (!isValidClientPacket(packet)) {
-                    emit sendError(PWTS::DError::INVALID_PACKET);
-                    emit sendCMDFail(cmd);
+                    emit sendError(clientID, PWTS::DError::INVALID_PACKET);
+                    emit sendCMDFail(clientID, cmd);
                     break;
 
                 } else if (packet.error != PWTS::PacketError::NoError) {
                     if (logger->isLevel(PWTS::LogLevel::Error))
                         logger->write(QString("client packet error: %1").arg(PWTS::getPacketErrorStr(packet.error)));
 
-                    emit sendError(PWTS::DError::INVALID_PACKET);
-                    emit sendCMDFail(cmd);
+                    emit sendError(clientID, PWTS::DError::INVALID_PACKET);
+                    emit sendCMDFail(clientID, cmd);
                     break;
                 }
 
@@ -390,13 +690,15 @@ namespace PWTD {
             case PWTS::DCMD::APPLY_PROFILE: {
                 const QString profile = args[1].toString();
 
-                emit sendSettingsApplyResult(PWTS::DCMD::APPLY_PROFILE, applyProfileSettings(profile), profile);
+                applyProfileSettings(profile, [this, profile](const QSet<PWTS::DError> &errors) {
+                    emit sendSettingsApplyResult(ServiceWorker::Broadcast, PWTS::DCMD::APPLY_PROFILE, errors, profile);
+                });
             }
                 break;
             case PWTS::DCMD::WRITE_PROFILE: {
                 if (!args[2].canConvert<PWTS::ClientPacket>()) {
-                    emit sendError(PWTS::DError::CORRUPTED_DATA);
-                    emit sendCMDFail(cmd);
+                    emit sendError(clientID, PWTS::DError::CORRUPTED_DATA);
+                    emit sendCMDFail(clientID, cmd);
                     break;
                 }
 
@@ -404,38 +706,38 @@ namespace PWTD {
                 const PWTS::ClientPacket packet = args[2].value<PWTS::ClientPacket>();
 
                 if (!isValidClientPacket(packet)) {
-                    emit sendError(PWTS::DError::INVALID_PACKET);
-                    emit sendCMDFail(cmd);
+                    emit sendError(clientID, PWTS::DError::INVALID_PACKET);
+                    emit sendCMDFail(clientID, cmd);
                     break;
                 }
 
-                emit sendCmdResult(PWTS::DCMD::WRITE_PROFILE, profileDiskMan->save(profile, packet));
+                emit sendCmdResult(clientID, PWTS::DCMD::WRITE_PROFILE, profileDiskMan->save(profile, packet));
             }
                 break;
             case PWTS::DCMD::DELETE_PROFILE:
-                emit sendCmdResult(PWTS::DCMD::DELETE_PROFILE, profileDiskMan->destroy(args[1].toString()));
+                emit sendCmdResult(clientID, PWTS::DCMD::DELETE_PROFILE, profileDiskMan->destroy(args[1].toString()));
                 break;
             case PWTS::DCMD::LOAD_PROFILE:
-                loadProfile(args[1].toString());
+                loadProfile(clientID, args[1].toString());
                 break;
             case PWTS::DCMD::GET_PROFILE_LIST:
-                emit sendProfileList(profileDiskMan->getProfilesList());
+                emit sendProfileList(clientID, profileDiskMan->getProfilesList());
                 break;
             case PWTS::DCMD::EXPORT_PROFILES:
-                emit sendExportedProfiles(profileDiskMan->exportProfiles(args[1].toString()));
+                emit sendExportedProfiles(clientID, profileDiskMan->exportProfiles(args[1].toString()));
                 break;
             case PWTS::DCMD::IMPORT_PROFILES:
-                importProfiles(args[1].toByteArray());
+                importProfiles(clientID, args[1].toByteArray());
                 break;
             case PWTS::DCMD::GET_DAEMON_SETTS:
-                emit sendByteArray(PWTS::DCMD::GET_DAEMON_SETTS, daemonSettings->getData());
+                emit sendByteArray(clientID, PWTS::DCMD::GET_DAEMON_SETTS, daemonSettings->getData());
                 break;
             case PWTS::DCMD::APPLY_DAEMON_SETT:
-                applyDaemonSettings(args[1].toByteArray());
+                applyDaemonSettings(clientID, args[1].toByteArray());
                 break;
             default: {
-                emit sendError(PWTS::DError::INVALID_DCMD);
-                emit sendCMDFail(cmd);
+                emit sendError(clientID, PWTS::DError::INVALID_DCMD);
+                emit sendCMDFail(clientID, cmd);
             }
                 break;
         }
@@ -453,14 +755,76 @@ namespace PWTD {
             return;
         }
 
-        const QSet<PWTS::DError> errors = device->applySettings(lastClientPacket.value());
+        postDeviceJob([this, packet = lastClientPacket.value()]()->std::function<void()> {
+            int driftCount = 0;
+            const QSet<PWTS::DError> errors = device->reconcileSettings(packet, driftCount);
 
-        if (logger->isLevel(PWTS::LogLevel::Info))
-            logger->write(QStringLiteral("applying settings.."));
+            return [this, driftCount, errors]() {
+                if (logger->isLevel(PWTS::LogLevel::Info))
+                    logger->write(QString("reconciling settings: %1 drifted").arg(driftCount));
 
-        writeErrorsToLog(errors);
-        emit sendSettingsApplyResult(PWTS::DCMD::APPLY_TIMER, errors);
-        applyTimer->start();
+                writeErrorsToLog(errors);
+                emit sendSettingsApplyResult(ServiceWorker::Broadcast, PWTS::DCMD::APPLY_TIMER, errors);
+            };
+        });
+    }
+
+    // sampling only reads, it does not hold the apply timer like other device jobs
+    void DaemonService::onTelemetryTimerTimeout() {
+        deviceWorker->post([this]() {
+            const TelemetrySample sample = device->getTelemetrySample(true);
+            QByteArray data;
+
+            if (!telemetryExport.isNull())
+                telemetryExport->publish(sample);
+
+            if (!PWTS::packData<TelemetrySample>(sample, data)) {
+                if (logger->isLevel(PWTS::LogLevel::Error))
+                    logger->write(QStringLiteral("failed to pack telemetry sample"));
+
+                return;
+            }
+
+            QMetaObject::invokeMethod(this, [this, data]() {
+                const qint64 now = telemetryClock.elapsed();
+                const int slack = telemetryTimer.isNull() ? 0 : (telemetryTimer->interval() / 2);
+                QList<quint64> targets;
+
+                for (auto it = telemetrySubscriptions.begin(); it != telemetrySubscriptions.end(); ++it) {
+                    if (it->lastSent >= 0 && (now - it->lastSent + slack) < it->interval)
+                        continue;
+
+                    it->lastSent = now;
+                    targets.append(it.key());
+                }
+
+                if (!targets.isEmpty())
+                    emit sendTelemetrySample(targets, data);
+            });
+        }, DeviceWorker::Coalesce::Telemetry);
+    }
+
+    // once started, history is recorded whether or not a client is connected, so it survives reconnects
+    void DaemonService::onSampleTimerTimeout() {
+        deviceWorker->post([this, history = recordHistory]() {
+            const TelemetrySample sample = device->getTelemetrySample(false);
+
+            if (history)
+                telemetryHistory->insert(sample);
+
+            if (!telemetryExport.isNull())
+                telemetryExport->publish(sample);
+        }, DeviceWorker::Coalesce::TelemetrySampling);
+    }
+
+    void DaemonService::onClientDisconnected(const quint64 clientID) {
+        unsubscribeTelemetry(clientID);
+        pendingPacketClients.remove(clientID);
+        pendingDeltaClients.remove(clientID);
+    }
+
+    void DaemonService::onProfileDiskChanged(const QList<QString> &list) {
+        emit sendProfileList(ServiceWorker::Broadcast, list);
     }
 
     void DaemonService::onBatteryStatusChanged(const bool onBattery) {
@@ -472,39 +836,38 @@ namespace PWTD {
         if (profile.isEmpty())
             return;
 
-        stopApplyTimer();
-
-        const QSet<PWTS::DError> errors = applyProfileSettings(profile);
+        applyProfileSettings(profile, [this, onBattery, profile](const QSet<PWTS::DError> &errors) {
+            if (logger->isLevel(PWTS::LogLevel::Info))
+                logger->write(QString("Battery status change: on battery: %1, profile: %2").arg(onBattery).arg(profile));
 
-        if (logger->isLevel(PWTS::LogLevel::Info))
-            logger->write(QString("Battery status change: on battery: %1, profile: %2").arg(onBattery).arg(profile));
-
-        writeErrorsToLog(errors);
-        emit sendSettingsApplyResult(PWTS::DCMD::BATTERY_STATUS_CHANGED, errors, profile);
-        startApplyTimer();
+            writeErrorsToLog(errors);
+            emit sendSettingsApplyResult(ServiceWorker::Broadcast, PWTS::DCMD::BATTERY_STATUS_CHANGED, errors, profile);
+        });
     }
 
+    // wait for it, the system may suspend as soon as we return
     void DaemonService::onPrepareForSleepEventTriggered() const {
-        device->prepareForSleep();
+        deviceWorker->run([this]() { device->prepareForSleep(); });
     }
 
     void DaemonService::onWakeFromSleepEventTriggered() {
         const QList<QVariant> refreshArgs {static_cast<int>(PWTS::DCMD::GET_DAEMON_PACKET), false};
 
 		if (daemonSettings->getApplyOnWakeFromSleep() && lastClientPacket.has_value()) {
-		    stopApplyTimer();
-
-		    const QSet<PWTS::DError> errors = device->applySettings(lastClientPacket.value());
+		    postDeviceJob([this, packet = lastClientPacket.value()]()->std::function<void()> {
+		        const QSet<PWTS::DError> errors = device->applySettings(packet, false);
 
-		    if (logger->isLevel(PWTS::LogLevel::Info))
-		        logger->write(QStringLiteral("Wake from sleep: applying settings"));
+		        return [this, errors]() {
+		            if (logger->isLevel(PWTS::LogLevel::Info))
+		                logger->write(QStringLiteral("Wake from sleep: applying settings"));
 
-		    writeErrorsToLog(errors);
-		    emit sendSettingsApplyResult(PWTS::DCMD::SYS_WAKE_FROM_SLEEP, errors);
-		    startApplyTimer();
+		            writeErrorsToLog(errors);
+		            emit sendSettingsApplyResult(ServiceWorker::Broadcast, PWTS::DCMD::SYS_WAKE_FROM_SLEEP, errors);
+		        };
+		    });
 		}
 
         // force refresh client, things may have changed
-        onCmdReceived(refreshArgs);
+        onCmdReceived(ServiceWorker::Broadcast, refreshArgs);
     }
 }
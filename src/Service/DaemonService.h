@@ -19,12 +19,18 @@
 
 #include <QTimer>
 #include <QThread>
+#include <QElapsedTimer>
 
 #include "Workers/ServiceWorker.h"
+#include "Workers/DeviceWorker.h"
+#include "DaemonCMDExt.h"
+#include "DaemonPacketDelta.h"
 #include "../Device/Device.h"
+#include "../Device/Telemetry/TelemetryHistory.h"
 #include "../DiskManagers/ProfileDiskManager.h"
 #include "../DiskManagers/DaemonSettingDiskManager.h"
 #include "PowerNotifications/PowerNotifications.h"
+#include "TelemetryExport/TelemetryExport.h"
 #include "pwtShared/DaemonSettings.h"
 
 namespace PWTD {
@@ -32,6 +38,17 @@ namespace PWTD {
         Q_OBJECT
 
     private:
+        // runs on the device thread, returns what to do with the results on the service thread
+        using DeviceJob = std::function<std::function<void()>()>;
+
+        struct TelemetrySubscription final {
+            int interval = 0; // msecs
+            qint64 lastSent = -1;
+        };
+
+        static constexpr int MinTelemetryInterval = 100; // msecs
+        static constexpr int MaxTelemetryInterval = 60000;
+        static constexpr int DefaultPMTableStaleness = 3000; // msecs, 3 smu table refresh intervals
         mutable std::optional<PWTS::ClientPacket> lastClientPacket;
         mutable QString activeProfile;
         QSharedPointer<FileLogger> logger;
@@ -43,6 +60,19 @@ namespace PWTD {
         mutable QScopedPointer<QTimer> applyTimer;
         QThread *serviceThread = nullptr;
         ServiceWorker *serviceWorker = nullptr;
+        QThread *deviceThread = nullptr;
+        DeviceWorker *deviceWorker = nullptr;
+        int deviceJobs = 0; // posted and not yet completed, the apply timer waits for them
+        QScopedPointer<QTimer> telemetryTimer; // ticks at the shortest subscribed interval
+        QHash<quint64, TelemetrySubscription> telemetrySubscriptions;
+        QElapsedTimer telemetryClock;
+        QSet<quint64> pendingPacketClients; // asked for a daemon packet, coalesced into one device job
+        QHash<quint64, quint64> pendingDeltaClients; // ack generation by client
+        QScopedPointer<QTimer> sampleTimer; // feeds history and export, independent of subscriptions
+        QSharedPointer<TelemetryHistory> telemetryHistory; // device thread only
+        QSharedPointer<TelemetryExport> telemetryExport; // device thread only
+        bool recordHistory = false; // set on the first history fetch or subscription, read when posting a sample job
+        DaemonPacketDelta packetDelta; // device thread only
 
         [[nodiscard]] QHostAddress getListenAddress(const QString &adr) const;
         [[nodiscard]] quint16 getServerPort(quint16 port) const;
@@ -52,13 +82,26 @@ namespace PWTD {
         void stopApplyTimer() const;
         void startApplyTimer() const;
         void writeErrorsToLog(const QSet<PWTS::DError> &errors) const;
-        PWTS::DeviceInfoPacket createDeviceInfoPacket() const;
+        void postDeviceJob(const DeviceJob &job, DeviceWorker::Coalesce key = DeviceWorker::Coalesce::None);
+        PWTS::DeviceInfoPacket createDeviceInfoPacket(const QByteArray &settingsData) const;
         PWTS::DaemonPacket createDaemonPacket() const;
+        void fillDaemonPacket(PWTS::DaemonPacket &packet) const;
+        void sendDaemonPacketAsync(quint64 clientID);
+        void sendDaemonPacketDeltaAsync(quint64 clientID, quint64 ackGeneration);
+        void subscribeTelemetry(quint64 clientID, int interval);
+        void unsubscribeTelemetry(quint64 clientID);
+        void unsubscribeAllTelemetry();
+        void updateTelemetryTimer();
+        void startTelemetrySampling();
+        void startHistoryRecording();
+        void fetchTelemetryHistory(quint64 clientID, qint64 from, qint64 to);
+        void sendPMTableSnapshotAsync(quint64 clientID, int maxStaleness);
+        void onExtCmdReceived(quint64 clientID, const QList<QVariant> &args);
         void applyClientSettings(const PWTS::ClientPacket &packet);
-        [[nodiscard]] QSet<PWTS::DError> applyProfileSettings(const QString &name) const;
-        void loadProfile(const QString &name);
-        void importProfiles(const QByteArray &profilesData);
-        void applyDaemonSettings(const QByteArray &data);
+        void applyProfileSettings(const QString &name, const std::function<void(const QSet<PWTS::DError> &)> &onApplied);
+        void loadProfile(quint64 clientID, const QString &name);
+        void importProfiles(quint64 clientID, const QByteArray &profilesData);
+        void applyDaemonSettings(quint64 clientID, const QByteArray &data);
 
     public:
         DaemonService();
@@ -69,25 +112,34 @@ namespace PWTD {
 
     private slots:
         void onLogMessageSent(const QString &msg, PWTS::LogLevel lvl) const;
-        void onCmdReceived(const QList<QVariant> &args);
+        void onCmdReceived(quint64 clientID, const QList<QVariant> &args);
         void onApplyTimerTimeout();
+        void onTelemetryTimerTimeout();
+        void onSampleTimerTimeout();
+        void onClientDisconnected(quint64 clientID);
+        void onProfileDiskChanged(const QList<QString> &list);
         void onBatteryStatusChanged(bool onBattery);
         void onPrepareForSleepEventTriggered() const;
         void onWakeFromSleepEventTriggered();
 
     signals:
-        void sendError(PWTS::DError error);
-        void sendCMDFail(PWTS::DCMD failedCMD);
+        void sendError(quint64 clientID, PWTS::DError error);
+        void sendCMDFail(quint64 clientID, PWTS::DCMD failedCMD);
         void connectService(const QHostAddress &adr, quint16 port);
         void restartService(const QHostAddress &adr, quint16 port);
         void stopService();
-        void sendDeviceInfoPacket(const PWTS::DeviceInfoPacket &packet);
-        void sendDaemonPacket(const PWTS::DaemonPacket &packet);
-        void sendLoadedProfile(const PWTS::DaemonPacket &packet, const QString &name);
-        void sendSettingsApplyResult(PWTS::DCMD cmd, const QSet<PWTS::DError> &errors, const QString &profileName = "");
-        void sendExportedProfiles(const QHash<QString, QByteArray> &profiles);
-        void sendProfileList(const QList<QString> &list);
-        void sendCmdResult(PWTS::DCMD cmd, bool result);
-        void sendByteArray(PWTS::DCMD cmd, const QByteArray &data);
+        void sendDeviceInfoPacket(quint64 clientID, const PWTS::DeviceInfoPacket &packet);
+        void sendDaemonPacket(const QList<quint64> &clientIDs, const PWTS::DaemonPacket &packet);
+        void sendDaemonPacketDelta(quint64 clientID, quint64 generation, bool full, const QByteArray &parts);
+        void sendTelemetrySubscription(quint64 clientID, int interval);
+        void sendTelemetrySample(const QList<quint64> &clientIDs, const QByteArray &sample);
+        void sendTelemetryHistory(quint64 clientID, const QByteArray &range);
+        void sendPMTableSnapshot(quint64 clientID, const QByteArray &snapshot);
+        void sendLoadedProfile(quint64 clientID, const PWTS::DaemonPacket &packet, const QString &name);
+        void sendSettingsApplyResult(quint64 clientID, PWTS::DCMD cmd, const QSet<PWTS::DError> &errors, const QString &profileName = "");
+        void sendExportedProfiles(quint64 clientID, const QHash<QString, QByteArray> &profiles);
+        void sendProfileList(quint64 clientID, const QList<QString> &list);
+        void sendCmdResult(quint64 clientID, PWTS::DCMD cmd, bool result);
+        void sendByteArray(quint64 clientID, PWTS::DCMD cmd, const QByteArray &data);
     };
 }
@@ -0,0 +1,107 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+
+#include "TelemetryExportLinux.h"
+
+namespace PWTD::LNX {
+    // any user can create files in /dev/shm, unlink first so a segment planted by someone else is never reused
+    TelemetryExportLinux::TelemetryExportLinux() {
+        logger = FileLogger::getInstance();
+
+        shm_unlink(PWT_TELEMETRY_SHM_NAME);
+
+        const int fd = shm_open(PWT_TELEMETRY_SHM_NAME, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+
+        if (fd < 0) {
+            if (logger->isLevel(PWTS::LogLevel::Error))
+                logger->write(QString("telemetry export: failed to create shared memory: %1").arg(std::strerror(errno)));
+
+            return;
+        }
+
+        void *mem = MAP_FAILED;
+
+        if (fchmod(fd, 0644) == 0 && ftruncate(fd, sizeof(PWTTelemetryShm)) == 0)
+            mem = mmap(nullptr, sizeof(PWTTelemetryShm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        close(fd);
+
+        if (mem == MAP_FAILED) {
+            if (logger->isLevel(PWTS::LogLevel::Error))
+                logger->write(QString("telemetry export: failed to map shared memory: %1").arg(std::strerror(errno)));
+
+            shm_unlink(PWT_TELEMETRY_SHM_NAME);
+            return;
+        }
+
+        shm = static_cast<PWTTelemetryShm *>(mem);
+        shm->version = PWT_TELEMETRY_SHM_VERSION;
+        shm->size = sizeof(PWTTelemetryShm);
+        shm->timestamp = 0;
+        shm->packageTemp = TelemetrySample::Unavailable;
+        shm->packagePower = TelemetrySample::Unavailable;
+
+        // readers check magic first, publish it last
+        __atomic_store_n(&shm->magic, PWT_TELEMETRY_SHM_MAGIC, __ATOMIC_RELEASE);
+    }
+
+    TelemetryExportLinux::~TelemetryExportLinux() {
+        if (shm == nullptr)
+            return;
+
+        munmap(shm, sizeof(PWTTelemetryShm));
+        shm_unlink(PWT_TELEMETRY_SHM_NAME);
+    }
+
+    // single writer, the device thread
+    void TelemetryExportLinux::publish(const TelemetrySample &sample) {
+        const int numCpus = static_cast<int>(qMin<qsizetype>(sample.cpuFrequency.size(), PWT_TELEMETRY_SHM_MAX_CPUS));
+        const int numFans = static_cast<int>(qMin<qsizetype>(sample.fanSpeed.size(), PWT_TELEMETRY_SHM_MAX_FANS));
+        const uint64_t seq = shm->sequence;
+        int fan = 0;
+
+        __atomic_store_n(&shm->sequence, seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+
+        shm->timestamp = sample.timestamp;
+        shm->packageTemp = sample.packageTemp;
+        shm->packagePower = sample.packagePower;
+        shm->numCpus = numCpus;
+        shm->numFans = numFans;
+
+        for (int i=0; i<numCpus; ++i) {
+            shm->cpuFrequency[i] = sample.cpuFrequency[i];
+            shm->c0Residency[i] = i < sample.c0Residency.size() ? sample.c0Residency[i] : TelemetrySample::Unavailable;
+        }
+
+        for (auto it = sample.fanSpeed.constBegin(); it != sample.fanSpeed.constEnd() && fan < numFans; ++it, ++fan) {
+            const QByteArray id = it.key().toUtf8().left(PWT_TELEMETRY_SHM_FAN_ID_SIZE - 1);
+
+            std::memset(shm->fans[fan].id, 0, PWT_TELEMETRY_SHM_FAN_ID_SIZE);
+            std::memcpy(shm->fans[fan].id, id.constData(), id.size());
+            shm->fans[fan].speed = it.value();
+        }
+
+        __atomic_store_n(&shm->sequence, seq + 2, __ATOMIC_RELEASE);
+    }
+}
@@ -0,0 +1,30 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "../../Device/Telemetry/TelemetrySample.h"
+
+namespace PWTD {
+    // publishes every telemetry sample for local readers that do not talk to the daemon
+    class TelemetryExport {
+    public:
+        virtual ~TelemetryExport() = default;
+
+        virtual void publish(const TelemetrySample &sample) = 0;
+    };
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QSharedPointer>
+
+#include "TelemetryExport.h"
+#ifdef __linux__
+#include "Linux/TelemetryExportLinux.h"
+#endif
+
+namespace PWTD {
+    class TelemetryExportFactory final {
+    private:
+        inline static bool enabled = false; // opt-in, it keeps the sample timer running
+
+        TelemetryExportFactory() = default;
+
+    public:
+        TelemetryExportFactory(const TelemetryExportFactory &) = delete;
+        TelemetryExportFactory &operator=(const TelemetryExportFactory &) = delete;
+
+        static void setEnabled(const bool enable) { enabled = enable; }
+
+        static QSharedPointer<TelemetryExport> getTelemetryExport() {
+            if (!enabled)
+                return nullptr;
+#ifdef __linux__
+            const QSharedPointer<LNX::TelemetryExportLinux> shm = QSharedPointer<LNX::TelemetryExportLinux>::create();
+
+            return shm->isValid() ? shm : nullptr;
+#else
+            return nullptr;
+#endif
+        }
+    };
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+
+// layout of the telemetry block the daemon publishes in /dev/shm, include this header to read it
+// plain C so status bars and scripts can use it without Qt or the daemon sources
+//
+// the block is guarded by a seqlock: sequence is odd while the daemon writes, readers copy the block and retry
+// when sequence was odd or changed during the copy, see pwtTelemetryShmRead
+// values are -1 when not available, the same as in TelemetrySample
+
+#define PWT_TELEMETRY_SHM_NAME "/powertuner-telemetry"
+#define PWT_TELEMETRY_SHM_MAGIC 0x54545750u // "PWTT"
+#define PWT_TELEMETRY_SHM_VERSION 1u
+#define PWT_TELEMETRY_SHM_MAX_CPUS 256
+#define PWT_TELEMETRY_SHM_MAX_FANS 8
+#define PWT_TELEMETRY_SHM_FAN_ID_SIZE 32
+
+struct PWTTelemetryShmFan {
+    char id[PWT_TELEMETRY_SHM_FAN_ID_SIZE]; // nul terminated
+    int32_t speed;
+    int32_t reserved;
+};
+
+struct PWTTelemetryShm {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size; // sizeof(struct PWTTelemetryShm) of the writer
+    uint32_t reserved;
+    uint64_t sequence;
+    int64_t timestamp; // msecs since epoch
+    int32_t packageTemp; // celsius
+    int32_t packagePower; // milliwatts
+    uint32_t numCpus;
+    uint32_t numFans;
+    int32_t cpuFrequency[PWT_TELEMETRY_SHM_MAX_CPUS]; // mhz
+    int32_t c0Residency[PWT_TELEMETRY_SHM_MAX_CPUS]; // per mille
+    struct PWTTelemetryShmFan fans[PWT_TELEMETRY_SHM_MAX_FANS];
+};
+
+// copies a consistent snapshot of shm into out, no syscalls, returns 0 when the block is not a known layout
+static inline int pwtTelemetryShmRead(const struct PWTTelemetryShm *shm, struct PWTTelemetryShm *out) {
+    uint64_t seq0;
+    uint64_t seq1;
+
+    if (shm->magic != PWT_TELEMETRY_SHM_MAGIC || shm->version != PWT_TELEMETRY_SHM_VERSION)
+        return 0;
+
+    do {
+        seq0 = __atomic_load_n(&shm->sequence, __ATOMIC_ACQUIRE);
+
+        if (seq0 & 1)
+            continue;
+
+        __builtin_memcpy(out, shm, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq1 = __atomic_load_n(&shm->sequence, __ATOMIC_RELAXED);
+    } while ((seq0 & 1) || seq0 != seq1);
+
+    return 1;
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QSemaphore>
+
+#include "DeviceWorker.h"
+
+namespace PWTD {
+    void DeviceWorker::scheduleDrain() {
+        if (drainScheduled)
+            return;
+
+        drainScheduled = true;
+        QMetaObject::invokeMethod(this, &DeviceWorker::drain, Qt::QueuedConnection);
+    }
+
+    void DeviceWorker::drain() {
+        std::function<void()> fn;
+
+        {
+            QMutexLocker locker(&queueMutex);
+
+            drainScheduled = false;
+
+            if (queue.isEmpty())
+                return;
+
+            fn = queue.takeFirst().fn;
+
+            if (!queue.isEmpty())
+                scheduleDrain();
+        }
+
+        fn();
+    }
+
+    // returns false if the job replaced a pending one
+    bool DeviceWorker::post(const std::function<void()> &fn, const Coalesce key) {
+        QMutexLocker locker(&queueMutex);
+
+        // only look past jobs that can coalesce themselves, anything else keeps its order
+        if (key != Coalesce::None) {
+            for (qsizetype i=queue.size()-1; i>=0 && queue[i].key != Coalesce::None; --i) {
+                if (queue[i].key != key)
+                    continue;
+
+                queue[i].fn = fn;
+                return false;
+            }
+        }
+
+        queue.append({key, fn});
+        scheduleDrain();
+        return true;
+    }
+
+    // blocks until fn has run on the device thread, never call it from the device thread
+    void DeviceWorker::run(const std::function<void()> &fn) {
+        QSemaphore done;
+
+        post([&fn, &done]() {
+            fn();
+            done.release();
+        });
+
+        done.acquire();
+    }
+}
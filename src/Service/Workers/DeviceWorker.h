@@ -0,0 +1,60 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <functional>
+#include <QObject>
+#include <QMutex>
+#include <QList>
+
+namespace PWTD {
+    // runs every hardware access on the device thread, one job per event loop iteration so device timers keep ticking
+    // jobs with a coalesce key replace a pending job with the same key, latest wins
+    class DeviceWorker final: public QObject {
+        Q_OBJECT
+
+    public:
+        enum class Coalesce {
+            None,
+            ApplyClientSettings,
+            DaemonPacket,
+            DaemonPacketDelta,
+            Telemetry,
+            TelemetrySampling
+        };
+
+    private:
+        struct Job {
+            Coalesce key;
+            std::function<void()> fn;
+        };
+
+        QMutex queueMutex;
+        QList<Job> queue;
+        bool drainScheduled = false;
+
+        void scheduleDrain();
+
+    private slots:
+        void drain();
+
+    public:
+        bool post(const std::function<void()> &fn, Coalesce key = Coalesce::None);
+        void run(const std::function<void()> &fn);
+    };
+}
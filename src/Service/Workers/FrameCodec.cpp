@@ -0,0 +1,86 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QtEndian>
+#include <algorithm>
+
+#include "FrameCodec.h"
+
+namespace PWTD {
+    bool FrameCodec::isFramed(const QByteArray &head) {
+        return head.size() >= 4 && qFromBigEndian<quint32>(head.constData()) == Magic;
+    }
+
+    QByteArray FrameCodec::encode(const int command, const QByteArray &payload, const quint16 flags) {
+        QByteArray frame (HeaderSize + payload.size(), Qt::Uninitialized);
+        char *data = frame.data();
+
+        qToBigEndian<quint32>(Magic, data);
+        qToBigEndian<quint16>(Version, data + 4);
+        qToBigEndian<quint16>(flags, data + 6);
+        qToBigEndian<qint32>(command, data + 8);
+        qToBigEndian<quint32>(static_cast<quint32>(payload.size()), data + 12);
+        std::copy(payload.constBegin(), payload.constEnd(), data + HeaderSize);
+
+        return frame;
+    }
+
+    void FrameCodec::append(const QByteArray &data) {
+        if (offset > 0) {
+            buffer.remove(0, offset);
+            offset = 0;
+        }
+
+        buffer.append(data);
+    }
+
+    // nothing is decoded until the whole frame is buffered, a partial frame costs one header check per append
+    FrameCodec::Result FrameCodec::next(Frame &frame) {
+        const qsizetype available = buffer.size() - offset;
+
+        if (available < HeaderSize)
+            return Result::NeedMore;
+
+        const char *head = buffer.constData() + offset;
+        const quint32 magic = qFromBigEndian<quint32>(head);
+        const quint16 version = qFromBigEndian<quint16>(head + 4);
+        const quint32 size = qFromBigEndian<quint32>(head + 12);
+
+        if (magic != Magic) {
+            error = QStringLiteral("bad frame magic");
+            return Result::Error;
+
+        } else if (version != Version) {
+            error = QString("unsupported frame version %1").arg(version);
+            return Result::Error;
+
+        } else if (size > MaxPayloadSize) {
+            error = QString("frame of %1 bytes exceeds the %2 bytes limit").arg(size).arg(MaxPayloadSize);
+            return Result::Error;
+
+        } else if (available < (HeaderSize + size)) {
+            return Result::NeedMore;
+        }
+
+        frame.flags = qFromBigEndian<quint16>(head + 6);
+        frame.command = qFromBigEndian<qint32>(head + 8);
+        frame.payload = buffer.mid(offset + HeaderSize, size);
+        offset += HeaderSize + size;
+
+        return Result::Frame;
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QVariant>
+
+namespace PWTD {
+    // frame = 16 bytes header + payload, header fields are big endian like QDataStream
+    // magic u32, version u16, flags u16, command i32, payload length u32
+    // the payload is the packed QList<QVariant> a legacy client sends without header
+    // legacy streams start with a list count, the magic is far above any count we accept, so the first 4 bytes tell them apart
+    class FrameCodec final {
+    public:
+        static constexpr quint32 Magic = 0x50575446; // "PWTF"
+        static constexpr quint16 Version = 1;
+        static constexpr qsizetype HeaderSize = 16;
+        static constexpr quint32 MaxPayloadSize = 64 * 1024 * 1024;
+        static constexpr quint16 FlagCompressed = 0x1; // payload is qCompress output
+
+        struct Frame final {
+            quint16 flags = 0;
+            int command = 0;
+            QByteArray payload;
+        };
+
+        enum class Result {
+            NeedMore,
+            Frame,
+            Error
+        };
+
+    private:
+        QByteArray buffer;
+        qsizetype offset = 0; // start of the first undecoded byte, consumed bytes are dropped once per append
+        QString error;
+
+    public:
+        [[nodiscard]] static bool isFramed(const QByteArray &head);
+        [[nodiscard]] static QByteArray encode(int command, const QByteArray &payload, quint16 flags = 0);
+
+        void append(const QByteArray &data);
+        [[nodiscard]] Result next(Frame &frame);
+        [[nodiscard]] QString getError() const { return error; }
+    };
+}
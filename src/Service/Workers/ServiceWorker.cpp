@@ -15,22 +15,97 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <QtEndian>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
 #include "ServiceWorker.h"
 #include "pwtShared/Utils.h"
 
 namespace PWTD {
     ServiceWorker::~ServiceWorker() {
-        if (!sock.isNull())
-            sock->abort();
+        closeClients();
 
         if (!server.isNull())
             server->close();
+#ifdef __linux__
+        stopLocalServer();
+#endif
     }
 
     void ServiceWorker::init() {
         server.reset(new QTcpServer);
     }
 
+    void ServiceWorker::setLocalSocket(const QString &path, const QSet<uint> &allowedUIDs, const int allowedGID, const bool only) {
+        localSocketPath = path;
+        localSocketUIDs = allowedUIDs;
+        localSocketGID = allowedGID;
+        localSocketOnly = only;
+    }
+
+    void ServiceWorker::setCompression(const int level, const int threshold) {
+        compressionLevel = qBound(0, level, 9);
+        compressionThreshold = qMax(0, threshold);
+    }
+
+    bool ServiceWorker::isSocketOpen(const QSharedPointer<Client> &client) {
+        return !client.isNull() && !client->sock.isNull() && client->sock->isOpen();
+    }
+
+    void ServiceWorker::abortSocket(const QSharedPointer<Client> &client) {
+        if (QTcpSocket *tcp = qobject_cast<QTcpSocket *>(client->sock); tcp != nullptr)
+            tcp->abort();
+#ifdef __linux__
+        else if (QLocalSocket *local = qobject_cast<QLocalSocket *>(client->sock); local != nullptr)
+            local->abort();
+#endif
+    }
+
+    void ServiceWorker::flushSocket(const QSharedPointer<Client> &client) {
+        if (QTcpSocket *tcp = qobject_cast<QTcpSocket *>(client->sock); tcp != nullptr)
+            tcp->flush();
+#ifdef __linux__
+        else if (QLocalSocket *local = qobject_cast<QLocalSocket *>(client->sock); local != nullptr)
+            local->flush();
+#endif
+    }
+
+    bool ServiceWorker::canAcceptClient(const QString &peer) {
+        if (clients.size() < MaxClients)
+            return true;
+
+        emit logMessageSent(QString("Refused %1, %2 clients already connected").arg(peer).arg(MaxClients), PWTS::LogLevel::Error);
+        return false;
+    }
+
+    template <typename S>
+    void ServiceWorker::addClient(S *sock, const QString &peer) {
+        const quint64 id = nextClientID++;
+        const QSharedPointer<Client> client = QSharedPointer<Client>::create();
+
+        client->sock = sock;
+        client->streamIn.setDevice(sock);
+        clients.insert(id, client);
+
+        emit logMessageSent(QString("Connected to %1, client %2").arg(peer).arg(id), PWTS::LogLevel::Info);
+
+        QObject::connect(sock, &S::disconnected, this, [this, id]() { onDisconnected(id); });
+        QObject::connect(sock, &S::readyRead, this, [this, id]() { onReadyRead(id); });
+    }
+
+    bool ServiceWorker::isClientOpen(const quint64 clientID) const {
+        if (clientID == Broadcast)
+            return true;
+
+        return isSocketOpen(clients.value(clientID));
+    }
+
     QByteArray ServiceWorker::packErrorList(const QSet<PWTS::DError> &errors) {
         QByteArray data;
 
@@ -42,19 +117,251 @@ namespace PWTD {
         return data;
     }
 
-    void ServiceWorker::sendData(const QList<QVariant> &args) {
-        QByteArray data;
+    // the socket buffers what the client has not read yet, past MaxPendingWrite the client is too slow to keep
+    void ServiceWorker::writeToClient(const quint64 clientID, const QByteArray &data) {
+        const QSharedPointer<Client> client = clients.value(clientID);
+
+        if (!isSocketOpen(client))
+            return;
+
+        if ((client->sock->bytesToWrite() + data.size()) > MaxPendingWrite) {
+            emit logMessageSent(QString("client %1 is not reading, disconnecting").arg(clientID), PWTS::LogLevel::Error);
+            abortSocket(client);
+            return;
+        }
+
+        client->sock->write(data);
+        flushSocket(client);
+    }
+
+    ServiceWorker::Encoding ServiceWorker::getEncoding(const QSharedPointer<Client> &client) {
+        if (client->framing != Framing::Framed)
+            return LegacyStream;
+
+        return client->compression ? LegacyFrameCompressed : LegacyFrame;
+    }
+
+    bool ServiceWorker::encodeMessage(const QList<QVariant> &args, const Encoding encoding, std::array<QByteArray, EncodingCount> &encoded) {
+        const int cmd = args[0].toInt();
+
+        if (encoding == LegacyStream) {
+            if (!PWTS::packData<QList<QVariant>>(args, encoded[LegacyStream])) {
+                emit logMessageSent(QString("sendData: failed to pack data for cmd %1").arg(cmd), PWTS::LogLevel::Error);
+                return false;
+            }
+
+            return true;
+        }
+
+        if (encoded[LegacyStream].isEmpty() && !encodeMessage(args, LegacyStream, encoded))
+            return false;
+
+        QByteArray payload = encoded[LegacyStream];
+        quint16 flags = 0;
+
+        if (encoding == LegacyFrameCompressed && payload.size() >= compressionThreshold) {
+            const QByteArray compressed = qCompress(payload, compressionLevel);
+
+            if (!compressed.isEmpty() && compressed.size() < payload.size()) {
+                payload = compressed;
+                flags |= FrameCodec::FlagCompressed;
+            }
+        }
+
+        encoded[encoding] = FrameCodec::encode(cmd, payload, flags);
+        return true;
+    }
+
+    // each encoding is built at most once, only if one of the targets needs it
+    void ServiceWorker::sendData(const QList<quint64> &clientIDs, const QList<QVariant> &args) {
+        const QList<quint64> targets = clientIDs.contains(Broadcast) ? clients.keys() : clientIDs;
+        std::array<QByteArray, EncodingCount> encoded;
+
+        for (const quint64 id: targets) {
+            const QSharedPointer<Client> client = clients.value(id);
+
+            if (!isSocketOpen(client))
+                continue;
+
+            const Encoding encoding = getEncoding(client);
+
+            if (encoded[encoding].isEmpty() && !encodeMessage(args, encoding, encoded))
+                return;
+
+            writeToClient(id, encoded[encoding]);
+        }
+    }
+
+    void ServiceWorker::sendData(const quint64 clientID, const QList<QVariant> &args) {
+        sendData(QList<quint64> {clientID}, args);
+    }
+
+    void ServiceWorker::closeClients() {
+        const QHash<quint64, QSharedPointer<Client>> closing = clients;
+
+        clients.clear();
+
+        for (const QSharedPointer<Client> &client: closing) {
+            if (client->sock.isNull())
+                continue;
+
+            QObject::disconnect(client->sock, nullptr, this, nullptr);
+            abortSocket(client);
+            client->sock->deleteLater();
+        }
+    }
+
+#ifdef __linux__
+    // systemd socket activation, LISTEN_FDS passes listening sockets starting at fd 3
+    // fd 3 is only taken if it really is a listening unix stream socket
+    qintptr ServiceWorker::getActivatedSocket() {
+        static constexpr int fd = 3;
+        bool pidRes = false;
+        bool fdsRes = false;
+        const qint64 pid = qEnvironmentVariable("LISTEN_PID").toLongLong(&pidRes);
+        const int fds = qEnvironmentVariable("LISTEN_FDS").toInt(&fdsRes);
+        sockaddr_storage addr {};
+        socklen_t addrLen = sizeof(addr);
+        int type = 0;
+        int listening = 0;
+        socklen_t typeLen = sizeof(type);
+        socklen_t listeningLen = sizeof(listening);
+
+        if (!pidRes || !fdsRes || pid != getpid() || fds < 1)
+            return -1;
+
+        qunsetenv("LISTEN_PID");
+        qunsetenv("LISTEN_FDS");
+        qunsetenv("LISTEN_FDNAMES");
+
+        if (getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &typeLen) != 0 || type != SOCK_STREAM ||
+            getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &listeningLen) != 0 || listening != 1 ||
+            getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &addrLen) != 0 || addr.ss_family != AF_UNIX) {
+            emit logMessageSent(QStringLiteral("Ignoring activated socket, fd 3 is not a listening unix stream socket"), PWTS::LogLevel::Error);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    // only a socket file we own that nobody listens on is removed, anything else at the path is left alone
+    bool ServiceWorker::removeStaleSocket() {
+        const QByteArray path = localSocketPath.toLocal8Bit();
+        struct stat st {};
+        sockaddr_un addr {};
+
+        if (lstat(path.constData(), &st) != 0)
+            return errno == ENOENT;
+
+        if (!S_ISSOCK(st.st_mode) || st.st_uid != geteuid()) {
+            emit logMessageSent(QString("Unix socket path %1 exists and is not a socket we own").arg(localSocketPath), PWTS::LogLevel::Error);
+            return false;
+        }
+
+        if (static_cast<size_t>(path.size()) >= sizeof(addr.sun_path))
+            return false;
+
+        const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        if (fd < 0)
+            return false;
+
+        addr.sun_family = AF_UNIX;
+        qstrncpy(addr.sun_path, path.constData(), sizeof(addr.sun_path));
+
+        const bool stale = ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 && errno == ECONNREFUSED;
+
+        close(fd);
+
+        if (!stale) {
+            emit logMessageSent(QString("Unix socket %1 is in use").arg(localSocketPath), PWTS::LogLevel::Error);
+            return false;
+        }
+
+        return QLocalServer::removeServer(localSocketPath);
+    }
+
+    // root and our own uid are always allowed, then the configured uids and the socket group members
+    bool ServiceWorker::isLocalPeerAllowed(const int fd, const uint uid, const uint gid) {
+        if (uid == 0 || uid == geteuid() || localSocketUIDs.contains(uid))
+            return true;
+
+        if (localSocketGID < 0)
+            return false;
+
+        if (gid == static_cast<uint>(localSocketGID))
+            return true;
+
+        QList<gid_t> groups(32);
+        socklen_t groupsLen = groups.size() * sizeof(gid_t);
+
+        // supplementary groups, the kernel tells the size needed when the list is too small
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERGROUPS, groups.data(), &groupsLen) != 0) {
+            if (errno != ERANGE)
+                return false;
+
+            groups.resize(groupsLen / sizeof(gid_t));
+
+            if (getsockopt(fd, SOL_SOCKET, SO_PEERGROUPS, groups.data(), &groupsLen) != 0)
+                return false;
+        }
+
+        groups.resize(groupsLen / sizeof(gid_t));
+
+        return groups.contains(static_cast<gid_t>(localSocketGID));
+    }
+
+    // an activated socket is only handed over once, after a restart we bind the path ourselves
+    void ServiceWorker::startLocalServer() {
+        const qintptr activatedFd = socketActivationUsed ? -1 : getActivatedSocket();
+
+        if (activatedFd < 0 && localSocketPath.isEmpty())
+            return;
+
+        localServer.reset(new QLocalServer);
+        localServer->setSocketOptions(localSocketGID < 0 ? QLocalServer::UserAccessOption : QLocalServer::UserAccessOption | QLocalServer::GroupAccessOption);
+
+        bool res;
+
+        if (activatedFd >= 0) {
+            socketActivationUsed = true;
+            res = localServer->listen(activatedFd);
+
+        } else {
+            res = removeStaleSocket() && localServer->listen(localSocketPath);
+
+            if (res && localSocketGID >= 0 && chown(localSocketPath.toLocal8Bit().constData(), -1, static_cast<gid_t>(localSocketGID)) != 0)
+                emit logMessageSent(QString("Failed to set the group of unix socket %1").arg(localSocketPath), PWTS::LogLevel::Error);
+        }
 
-        if (!PWTS::packData<QList<QVariant>>(args, data)) {
-            emit logMessageSent(QString("sendData: failed to pack data for cmd %1").arg(args[0].toInt()), PWTS::LogLevel::Error);
+        if (!res) {
+            emit logMessageSent(QString("Failed to listen on unix socket %1: %2").arg(localSocketPath, localServer->errorString()), PWTS::LogLevel::Error);
+            localServer.reset();
             return;
         }
 
-        sock->write(data);
-        sock->flush();
+        QObject::connect(localServer.get(), &QLocalServer::newConnection, this, &ServiceWorker::onNewLocalConnection);
+
+        emit logMessageSent(QString("Listening on unix socket %1").arg(localServer->fullServerName()), PWTS::LogLevel::Service);
     }
 
+    void ServiceWorker::stopLocalServer() {
+        if (localServer.isNull())
+            return;
+
+        QObject::disconnect(localServer.get(), &QLocalServer::newConnection, this, &ServiceWorker::onNewLocalConnection);
+        localServer->close();
+        localServer.reset();
+    }
+#endif
+
     void ServiceWorker::startServer(const QHostAddress &adr, const quint16 port) {
+#ifdef __linux__
+        startLocalServer();
+
+        if (localSocketOnly)
+            return;
+#endif
         const bool res = server->listen(adr, port);
         const QString sadr = server->serverAddress().toString();
 
@@ -69,93 +376,119 @@ namespace PWTD {
     }
 
     void ServiceWorker::restartServer(const QHostAddress &adr, const quint16 port) {
+        stopServer();
+        startServer(adr, port);
+    }
+
+    void ServiceWorker::stopServer() {
         QObject::disconnect(server.get(), &QTcpServer::newConnection, this, &ServiceWorker::onNewConnection);
 
         if (server->isListening())
             server->close();
+#ifdef __linux__
+        stopLocalServer();
+#endif
+        const QList<quint64> ids = clients.keys();
 
-        if (!sock.isNull()) {
-            if (sock->isOpen())
-                sock->abort();
+        closeClients();
 
-            sock->deleteLater();
+        for (const quint64 id: ids)
+            emit clientDisconnected(id);
+    }
+
+    void ServiceWorker::sendError(const quint64 clientID, const PWTS::DError error) {
+        if (!isClientOpen(clientID)) {
+            emit logMessageSent(QStringLiteral("ServiceWorker::sendError: socket not available"), PWTS::LogLevel::Error);
+            return;
         }
 
-        startServer(adr, port);
+        const QList<QVariant> args {static_cast<int>(PWTS::DCMD::PRINT_ERROR), static_cast<int>(error)};
+
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::stopServer() const {
-        QObject::disconnect(server.get(), &QTcpServer::newConnection, this, &ServiceWorker::onNewConnection);
+    void ServiceWorker::sendCMDFail(const quint64 clientID, const PWTS::DCMD failedCMD) {
+        if (!isClientOpen(clientID)) {
+            emit logMessageSent(QStringLiteral("ServiceWorker::sendCMDFail: socket not available"), PWTS::LogLevel::Error);
+            return;
+        }
 
-        if (server->isListening())
-            server->close();
+        const QList<QVariant> args {static_cast<int>(PWTS::DCMD::DAEMON_CMD_FAIL), static_cast<int>(failedCMD)};
 
-        if (!sock.isNull()) {
-            sock->abort();
-            sock->deleteLater();
-        }
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::getNextPendingConnection() {
-        if (!server->hasPendingConnections())
+    void ServiceWorker::sendDeviceInfoPacket(const quint64 clientID, const PWTS::DeviceInfoPacket &packet) {
+        if (!isClientOpen(clientID)) {
+            emit logMessageSent(QStringLiteral("ServiceWorker::sendDeviceInfoPacket: socket not available"), PWTS::LogLevel::Error);
             return;
+        }
 
-        sock = server->nextPendingConnection();
+        const QList<QVariant> args {static_cast<int>(PWTS::DCMD::GET_DEVICE_INFO_PACKET), QVariant::fromValue<PWTS::DeviceInfoPacket>(packet)};
 
-        sockStreamIn.setDevice(sock);
+        sendData(clientID, args);
+    }
 
-        emit logMessageSent(QString("Connected to %1").arg(sock->peerAddress().toString()), PWTS::LogLevel::Info);
+    // every client that asked while the packet was being filled gets the same one, packed once
+    void ServiceWorker::sendDaemonPacket(const QList<quint64> &clientIDs, const PWTS::DaemonPacket &packet) {
+        const QList<QVariant> args {static_cast<int>(PWTS::DCMD::GET_DAEMON_PACKET), QVariant::fromValue<PWTS::DaemonPacket>(packet)};
 
-        QObject::connect(sock, &QTcpSocket::disconnected, this, &ServiceWorker::onDisconnected);
-        QObject::connect(sock, &QTcpSocket::readyRead, this, &ServiceWorker::onReadyRead);
+        sendData(clientIDs, args);
     }
 
-    void ServiceWorker::sendError(const PWTS::DError error) {
-        if (!isSockOpen()) {
-            emit logMessageSent(QStringLiteral("ServiceWorker::sendError: socket not available"), PWTS::LogLevel::Error);
+    void ServiceWorker::sendDaemonPacketDelta(const quint64 clientID, const quint64 generation, const bool full, const QByteArray &parts) {
+        if (!isClientOpen(clientID)) {
+            emit logMessageSent(QStringLiteral("ServiceWorker::sendDaemonPacketDelta: socket not available"), PWTS::LogLevel::Error);
             return;
         }
 
-        const QList<QVariant> args {static_cast<int>(PWTS::DCMD::PRINT_ERROR), static_cast<int>(error)};
+        const QList<QVariant> args {static_cast<int>(DCMDExt::GET_DAEMON_PACKET_DELTA), generation, full, parts};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendCMDFail(const PWTS::DCMD failedCMD) {
-        if (!isSockOpen()) {
-            emit logMessageSent(QStringLiteral("ServiceWorker::sendCMDFail: socket not available"), PWTS::LogLevel::Error);
+    void ServiceWorker::sendTelemetrySubscription(const quint64 clientID, const int interval) {
+        if (!isClientOpen(clientID)) {
+            emit logMessageSent(QStringLiteral("ServiceWorker::sendTelemetrySubscription: socket not available"), PWTS::LogLevel::Error);
             return;
         }
 
-        const QList<QVariant> args {static_cast<int>(PWTS::DCMD::DAEMON_CMD_FAIL), static_cast<int>(failedCMD)};
+        const QList<QVariant> args {static_cast<int>(DCMDExt::SUBSCRIBE_TELEMETRY), interval};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendDeviceInfoPacket(const PWTS::DeviceInfoPacket &packet) {
-        if (!isSockOpen()) {
-            emit logMessageSent(QStringLiteral("ServiceWorker::sendDeviceInfoPacket: socket not available"), PWTS::LogLevel::Error);
+    // sent every telemetry tick, a missing client is not worth a log line
+    void ServiceWorker::sendTelemetrySample(const QList<quint64> &clientIDs, const QByteArray &sample) {
+        const QList<QVariant> args {static_cast<int>(DCMDExt::TELEMETRY_SAMPLE), sample};
+
+        sendData(clientIDs, args);
+    }
+
+    void ServiceWorker::sendTelemetryHistory(const quint64 clientID, const QByteArray &range) {
+        if (!isClientOpen(clientID)) {
+            emit logMessageSent(QStringLiteral("ServiceWorker::sendTelemetryHistory: socket not available"), PWTS::LogLevel::Error);
             return;
         }
 
-        const QList<QVariant> args {static_cast<int>(PWTS::DCMD::GET_DEVICE_INFO_PACKET), QVariant::fromValue<PWTS::DeviceInfoPacket>(packet)};
+        const QList<QVariant> args {static_cast<int>(DCMDExt::FETCH_TELEMETRY_HISTORY), range};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendDaemonPacket(const PWTS::DaemonPacket &packet) {
-        if (!isSockOpen()) {
-            emit logMessageSent(QStringLiteral("ServiceWorker::sendDaemonPacket: socket not available"), PWTS::LogLevel::Error);
+    void ServiceWorker::sendPMTableSnapshot(const quint64 clientID, const QByteArray &snapshot) {
+        if (!isClientOpen(clientID)) {
+            emit logMessageSent(QStringLiteral("ServiceWorker::sendPMTableSnapshot: socket not available"), PWTS::LogLevel::Error);
             return;
         }
 
-        const QList<QVariant> args {static_cast<int>(PWTS::DCMD::GET_DAEMON_PACKET), QVariant::fromValue<PWTS::DaemonPacket>(packet)};
+        const QList<QVariant> args {static_cast<int>(DCMDExt::GET_PM_TABLE), snapshot};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendSettingsApplyResult(const PWTS::DCMD cmd, const QSet<PWTS::DError> &errors, const QString &profileName) {
-        if (!isSockOpen()) {
+    void ServiceWorker::sendSettingsApplyResult(const quint64 clientID, const PWTS::DCMD cmd, const QSet<PWTS::DError> &errors, const QString &profileName) {
+        if (!isClientOpen(clientID)) {
             emit logMessageSent(QStringLiteral("ServiceWorker::sendSettingsApplyResult: socket not available"), PWTS::LogLevel::Error);
             return;
         }
@@ -172,22 +505,22 @@ namespace PWTD {
         if (!profileName.isEmpty())
             args.append(profileName);
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendLoadedProfile(const PWTS::DaemonPacket &packet, const QString &name) {
-        if (!isSockOpen()) {
+    void ServiceWorker::sendLoadedProfile(const quint64 clientID, const PWTS::DaemonPacket &packet, const QString &name) {
+        if (!isClientOpen(clientID)) {
             emit logMessageSent(QStringLiteral("ServiceWorker::sendLoadedProfile: socket not available"), PWTS::LogLevel::Error);
             return;
         }
 
         const QList<QVariant> args {static_cast<int>(PWTS::DCMD::LOAD_PROFILE), QVariant::fromValue<PWTS::DaemonPacket>(packet), name};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendExportedProfiles(const QHash<QString, QByteArray> &profiles) {
-        if (!isSockOpen()) {
+    void ServiceWorker::sendExportedProfiles(const quint64 clientID, const QHash<QString, QByteArray> &profiles) {
+        if (!isClientOpen(clientID)) {
             emit logMessageSent(QStringLiteral("ServiceWorker::sendExportedProfiles: socket not available"), PWTS::LogLevel::Error);
             return;
         }
@@ -201,79 +534,215 @@ namespace PWTD {
 
         const QList<QVariant> args {static_cast<int>(PWTS::DCMD::EXPORT_PROFILES), exportedData};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendProfileList(const QList<QString> &list) {
-        if (!isSockOpen()) {
+    void ServiceWorker::sendProfileList(const quint64 clientID, const QList<QString> &list) {
+        if (!isClientOpen(clientID)) {
             emit logMessageSent(QStringLiteral("ServiceWorker::sendProfileList: socket not available"), PWTS::LogLevel::Error);
             return;
         }
 
         const QList<QVariant> args {static_cast<int>(PWTS::DCMD::GET_PROFILE_LIST), list};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendCmdResult(PWTS::DCMD cmd, const bool result) {
-        if (!isSockOpen()) {
+    void ServiceWorker::sendCmdResult(const quint64 clientID, const PWTS::DCMD cmd, const bool result) {
+        if (!isClientOpen(clientID)) {
             emit logMessageSent(QStringLiteral("ServiceWorker::sendCmdResult: socket not available"), PWTS::LogLevel::Error);
             return;
         }
 
         const QList<QVariant> args {static_cast<int>(cmd), result};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
-    void ServiceWorker::sendByteArray(const PWTS::DCMD cmd, const QByteArray &data) {
-        if (!isSockOpen()) {
+    void ServiceWorker::sendByteArray(const quint64 clientID, const PWTS::DCMD cmd, const QByteArray &data) {
+        if (!isClientOpen(clientID)) {
             emit logMessageSent(QString("ServiceWorker::sendByteArray: cmd %1: socket not available").arg(static_cast<int>(cmd)), PWTS::LogLevel::Error);
             return;
         }
 
         const QList<QVariant> args {static_cast<int>(cmd), data};
 
-        sendData(args);
+        sendData(clientID, args);
     }
 
     void ServiceWorker::onNewConnection() {
-        if (isSockOpen()) {
-            emit logMessageSent(QStringLiteral("New client connection request, previous connection will be closed"), PWTS::LogLevel::Info);
-            sock->abort();
+        while (server->hasPendingConnections()) {
+            QTcpSocket *sock = server->nextPendingConnection();
+            const QString peer = sock->peerAddress().toString();
 
-        } else {
-            getNextPendingConnection();
+            if (!canAcceptClient(peer)) {
+                sock->abort();
+                sock->deleteLater();
+                continue;
+            }
+
+            addClient(sock, peer);
+        }
+    }
+
+#ifdef __linux__
+    // the kernel fills SO_PEERCRED at connect time, the client cannot fake it
+    void ServiceWorker::onNewLocalConnection() {
+        while (localServer->hasPendingConnections()) {
+            QLocalSocket *sock = localServer->nextPendingConnection();
+            ucred cred {};
+            socklen_t credLen = sizeof(cred);
+
+            if (getsockopt(static_cast<int>(sock->socketDescriptor()), SOL_SOCKET, SO_PEERCRED, &cred, &credLen) != 0) {
+                emit logMessageSent(QStringLiteral("Refused unix socket client, unable to read peer credentials"), PWTS::LogLevel::Error);
+                sock->abort();
+                sock->deleteLater();
+                continue;
+            }
+
+            const QString peer = QString("uid %1 pid %2").arg(cred.uid).arg(cred.pid);
+
+            if (!isLocalPeerAllowed(static_cast<int>(sock->socketDescriptor()), cred.uid, cred.gid)) {
+                emit logMessageSent(QString("Refused unix socket client %1, uid not allowed").arg(peer), PWTS::LogLevel::Error);
+                sock->abort();
+                sock->deleteLater();
+                continue;
+            }
+
+            if (!canAcceptClient(peer)) {
+                sock->abort();
+                sock->deleteLater();
+                continue;
+            }
+
+            addClient(sock, peer);
         }
     }
+#endif
+
+    void ServiceWorker::onDisconnected(const quint64 clientID) {
+        const QSharedPointer<Client> client = clients.take(clientID);
+
+        if (client.isNull())
+            return;
 
-    void ServiceWorker::onDisconnected() {
-        sock->deleteLater();
-        emit logMessageSent(QStringLiteral("disconnected from client"), PWTS::LogLevel::Info);
-        getNextPendingConnection();
+        if (!client->sock.isNull())
+            client->sock->deleteLater();
+
+        emit logMessageSent(QString("disconnected from client %1").arg(clientID), PWTS::LogLevel::Info);
+        emit clientDisconnected(clientID);
     }
 
-    void ServiceWorker::onReadyRead() {
+    // the whole stream is parsed again on every readyRead until the list is complete, kept for old clients
+    void ServiceWorker::readLegacyStream(const quint64 clientID, const QSharedPointer<Client> &client) {
         QList<QVariant> args;
 
-        while (true) {
-            if (!isSockOpen()) {
-                emit logMessageSent(QStringLiteral("ServiceWorker::onReadyRead: socket is not available"), PWTS::LogLevel::Error);
+        while (isSocketOpen(client)) {
+            client->streamIn.startTransaction();
+            client->streamIn >> args;
+
+            if (!client->streamIn.commitTransaction())
+                break;
+
+            if (args.empty()) {
+                sendError(clientID, PWTS::DError::CORRUPTED_DATA);
                 break;
             }
 
-            sockStreamIn.startTransaction();
-            sockStreamIn >> args;
+            if (!readTransportCmd(clientID, client, args))
+                emit cmdReceived(clientID, args);
+        }
+    }
+
+    // a bad payload only drops its frame, a bad header leaves no way to find the next one
+    void ServiceWorker::readFrames(const quint64 clientID, const QSharedPointer<Client> &client) {
+        FrameCodec::Frame frame;
+
+        client->decoder.append(client->sock->readAll());
 
-            if (!sockStreamIn.commitTransaction())
+        while (isSocketOpen(client)) {
+            const FrameCodec::Result res = client->decoder.next(frame);
+
+            if (res == FrameCodec::Result::NeedMore)
                 break;
 
-            if (args.empty()) {
-                sendError(PWTS::DError::CORRUPTED_DATA);
+            if (res == FrameCodec::Result::Error) {
+                emit logMessageSent(QString("client %1: %2, disconnecting").arg(clientID).arg(client->decoder.getError()), PWTS::LogLevel::Error);
+                sendError(clientID, PWTS::DError::CORRUPTED_DATA);
+                flushSocket(client);
+                abortSocket(client);
                 break;
             }
 
-            emit cmdReceived(args);
+            // qCompress output starts with the big endian uncompressed size, check it before allocating
+            if ((frame.flags & FrameCodec::FlagCompressed) != 0) {
+                if (!client->compression || frame.payload.size() < 4 || qFromBigEndian<quint32>(frame.payload.constData()) > FrameCodec::MaxPayloadSize) {
+                    sendError(clientID, PWTS::DError::CORRUPTED_DATA);
+                    continue;
+                }
+
+                frame.payload = qUncompress(frame.payload);
+
+                if (frame.payload.isEmpty()) {
+                    sendError(clientID, PWTS::DError::CORRUPTED_DATA);
+                    continue;
+                }
+            }
+
+            QList<QVariant> args;
+
+            if (!PWTS::unpackData<QList<QVariant>>(frame.payload, args) || args.empty() || args[0].toInt() != frame.command) {
+                sendError(clientID, PWTS::DError::CORRUPTED_DATA);
+                continue;
+            }
+
+            if (!readTransportCmd(clientID, client, args))
+                emit cmdReceived(clientID, args);
         }
     }
+
+    // compression needs frame flags, unframed clients are always told 0
+    void ServiceWorker::negotiateCompression(const quint64 clientID, const QSharedPointer<Client> &client, const QList<QVariant> &args) {
+        const bool requested = args.size() > 1 && args[1].toBool();
+
+        client->compression = requested && compressionLevel > 0 && client->framing == Framing::Framed;
+
+        emit logMessageSent(QString("client %1 compression %2").arg(clientID).arg(client->compression ? "on" : "off"), PWTS::LogLevel::Info);
+
+        sendData(clientID, {static_cast<int>(DCMDExt::NEGOTIATE_COMPRESSION), client->compression ? compressionThreshold : 0});
+    }
+
+    // transport commands are answered here and never reach DaemonService
+    bool ServiceWorker::readTransportCmd(const quint64 clientID, const QSharedPointer<Client> &client, const QList<QVariant> &args) {
+        switch (static_cast<DCMDExt>(args[0].toInt())) {
+            case DCMDExt::NEGOTIATE_COMPRESSION:
+                negotiateCompression(clientID, client, args);
+                return true;
+            default:
+                break;
+        }
+
+        return false;
+    }
+
+    void ServiceWorker::onReadyRead(const quint64 clientID) {
+        const QSharedPointer<Client> client = clients.value(clientID);
+
+        if (!isSocketOpen(client)) {
+            emit logMessageSent(QStringLiteral("ServiceWorker::onReadyRead: socket is not available"), PWTS::LogLevel::Error);
+            return;
+        }
+
+        if (client->framing == Framing::Unknown) {
+            if (client->sock->bytesAvailable() < 4)
+                return;
+
+            client->framing = FrameCodec::isFramed(client->sock->peek(4)) ? Framing::Framed : Framing::Legacy;
+        }
+
+        if (client->framing == Framing::Framed)
+            readFrames(clientID, client);
+        else
+            readLegacyStream(clientID, client);
+    }
 }
@@ -20,53 +20,135 @@
 #include <QTcpSocket>
 #include <QTcpServer>
 #include <QPointer>
+#include <array>
+#ifdef __linux__
+#include <QLocalServer>
+#include <QLocalSocket>
+#endif
 
 #include "pwtShared/Include/Packets/DeviceInfoPacket.h"
 #include "pwtShared/Include/Packets/DaemonPacket.h"
 #include "pwtShared/Include/DaemonCMD.h"
 #include "pwtShared/Include/LogLevel.h"
+#include "../DaemonCMDExt.h"
+#include "FrameCodec.h"
 
 namespace PWTD {
+    // serves any number of clients, replies go to the client id that asked, Broadcast goes to every client
+    // on linux clients can also connect through a unix socket, same framing, peer uid checked by the kernel
+    // the socket file is owner only, or owner and group when a socket group is set, never world writable
+    // a client that starts with a FrameCodec header is answered with frames, any other client gets the legacy stream
+    // framed clients can negotiate zlib compression, only payloads past the threshold that actually shrink are sent compressed
     class ServiceWorker final: public QObject {
         Q_OBJECT
 
+    public:
+        static constexpr quint64 Broadcast = 0;
+        static constexpr int DefaultCompressionLevel = 6;
+        static constexpr int DefaultCompressionThreshold = 4096; // bytes
+
     private:
-        QScopedPointer<QTcpServer> server;
-        QPointer<QTcpSocket> sock;
-        QDataStream sockStreamIn;
+        static constexpr int MaxClients = 16;
+        static constexpr qint64 MaxPendingWrite = 32 * 1024 * 1024; // bytes, a client that does not read is dropped
+
+        enum class Framing {
+            Unknown,
+            Legacy,
+            Framed
+        };
 
-        [[nodiscard]] bool isSockOpen() const { return !sock.isNull() && sock->isOpen(); }
+        struct Client final {
+            QPointer<QIODevice> sock; // QTcpSocket or QLocalSocket
+            QDataStream streamIn;
+            FrameCodec decoder;
+            Framing framing = Framing::Unknown;
+            bool compression = false;
+        };
 
+        enum Encoding {
+            LegacyStream,
+            LegacyFrame,
+            LegacyFrameCompressed,
+            EncodingCount
+        };
+
+        inline static QString localSocketPath;
+        inline static QSet<uint> localSocketUIDs; // allowed besides root and our own uid
+        inline static int localSocketGID = -1; // group owning the socket file, its members are allowed, -1 none
+        inline static bool localSocketOnly = false;
+        inline static int compressionLevel = DefaultCompressionLevel; // 0 disables compression
+        inline static int compressionThreshold = DefaultCompressionThreshold;
+        QScopedPointer<QTcpServer> server;
+#ifdef __linux__
+        QScopedPointer<QLocalServer> localServer;
+        bool socketActivationUsed = false;
+#endif
+        QHash<quint64, QSharedPointer<Client>> clients;
+        quint64 nextClientID = Broadcast + 1;
+
+        [[nodiscard]] static bool isSocketOpen(const QSharedPointer<Client> &client);
+        static void abortSocket(const QSharedPointer<Client> &client);
+        static void flushSocket(const QSharedPointer<Client> &client);
+        [[nodiscard]] bool canAcceptClient(const QString &peer);
+        template <typename S> void addClient(S *sock, const QString &peer);
+#ifdef __linux__
+        [[nodiscard]] qintptr getActivatedSocket();
+        [[nodiscard]] bool removeStaleSocket();
+        [[nodiscard]] static bool isLocalPeerAllowed(int fd, uint uid, uint gid);
+        void startLocalServer();
+        void stopLocalServer();
+#endif
+        [[nodiscard]] bool isClientOpen(quint64 clientID) const;
         [[nodiscard]] QByteArray packErrorList(const QSet<PWTS::DError> &errors);
-        void sendData(const QList<QVariant> &args);
+        void writeToClient(quint64 clientID, const QByteArray &data);
+        [[nodiscard]] static Encoding getEncoding(const QSharedPointer<Client> &client);
+        [[nodiscard]] bool encodeMessage(const QList<QVariant> &args, Encoding encoding, std::array<QByteArray, EncodingCount> &encoded);
+        void sendData(const QList<quint64> &clientIDs, const QList<QVariant> &args);
+        void sendData(quint64 clientID, const QList<QVariant> &args);
+        void closeClients();
+        void readLegacyStream(quint64 clientID, const QSharedPointer<Client> &client);
+        void readFrames(quint64 clientID, const QSharedPointer<Client> &client);
+        void negotiateCompression(quint64 clientID, const QSharedPointer<Client> &client, const QList<QVariant> &args);
+        [[nodiscard]] bool readTransportCmd(quint64 clientID, const QSharedPointer<Client> &client, const QList<QVariant> &args);
 
     public:
         ~ServiceWorker() override;
 
+        static void setLocalSocket(const QString &path, const QSet<uint> &allowedUIDs, int allowedGID, bool only);
+        static void setCompression(int level, int threshold);
+
     private slots:
         void onNewConnection();
-        void onDisconnected();
-        void onReadyRead();
+#ifdef __linux__
+        void onNewLocalConnection();
+#endif
+        void onDisconnected(quint64 clientID);
+        void onReadyRead(quint64 clientID);
 
     public slots:
         void init();
         void startServer(const QHostAddress &adr, quint16 port);
         void restartServer(const QHostAddress &adr, quint16 port);
-        void stopServer() const;
-        void getNextPendingConnection();
-        void sendError(PWTS::DError error);
-        void sendCMDFail(PWTS::DCMD failedCMD);
-        void sendDeviceInfoPacket(const PWTS::DeviceInfoPacket &packet);
-        void sendDaemonPacket(const PWTS::DaemonPacket &packet);
-        void sendSettingsApplyResult(PWTS::DCMD cmd, const QSet<PWTS::DError> &errors, const QString &profileName = "");
-        void sendLoadedProfile(const PWTS::DaemonPacket &packet, const QString &name);
-        void sendExportedProfiles(const QHash<QString, QByteArray> &profiles);
-        void sendProfileList(const QList<QString> &list);
-        void sendCmdResult(PWTS::DCMD cmd, bool result);
-        void sendByteArray(PWTS::DCMD cmd, const QByteArray &data);
+        void stopServer();
+        void sendError(quint64 clientID, PWTS::DError error);
+        void sendCMDFail(quint64 clientID, PWTS::DCMD failedCMD);
+        void sendDeviceInfoPacket(quint64 clientID, const PWTS::DeviceInfoPacket &packet);
+        void sendDaemonPacket(const QList<quint64> &clientIDs, const PWTS::DaemonPacket &packet);
+        void sendDaemonPacketDelta(quint64 clientID, quint64 generation, bool full, const QByteArray &parts);
+        void sendTelemetrySubscription(quint64 clientID, int interval);
+        void sendTelemetrySample(const QList<quint64> &clientIDs, const QByteArray &sample);
+        void sendTelemetryHistory(quint64 clientID, const QByteArray &range);
+        void sendPMTableSnapshot(quint64 clientID, const QByteArray &snapshot);
+        void sendSettingsApplyResult(quint64 clientID, PWTS::DCMD cmd, const QSet<PWTS::DError> &errors, const QString &profileName = "");
+        void sendLoadedProfile(quint64 clientID, const PWTS::DaemonPacket &packet, const QString &name);
+        void sendExportedProfiles(quint64 clientID, const QHash<QString, QByteArray> &profiles);
+        void sendProfileList(quint64 clientID, const QList<QString> &list);
+        void sendCmdResult(quint64 clientID, PWTS::DCMD cmd, bool result);
+        void sendByteArray(quint64 clientID, PWTS::DCMD cmd, const QByteArray &data);
 
     signals:
         void logMessageSent(const QString &msg, PWTS::LogLevel lvl);
-        void cmdReceived(const QList<QVariant> &args);
+        void cmdReceived(quint64 clientID, const QList<QVariant> &args);
+        void clientDisconnected(quint64 clientID);
     };
 }
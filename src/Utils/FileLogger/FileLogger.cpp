@@ -103,6 +103,8 @@ namespace PWTD {
     }
 
     void FileLogger::write(const QString &msg, const std::source_location source) {
+        const QMutexLocker locker(&writeMutex);
+
         if (!logFile.isOpen() || level == PWTS::LogLevel::None)
             return;
 
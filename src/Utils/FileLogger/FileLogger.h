@@ -20,6 +20,7 @@
 #include <QSharedPointer>
 #include <QTextStream>
 #include <QFile>
+#include <QMutex>
 #include <source_location>
 
 #include "pwtShared/Include/LogLevel.h"
@@ -34,6 +35,7 @@ namespace PWTD {
         QString basePath;
         QTextStream ts;
         QFile logFile;
+        QMutex writeMutex;
 
         FileLogger();
 
@@ -0,0 +1,148 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QTest>
+#include <QBuffer>
+#include <QHash>
+
+#include "Service/Workers/FrameCodec.h"
+#include "pwtShared/Include/DaemonCMD.h"
+#include "pwtShared/Utils.h"
+
+// large IMPORT_PROFILES message arriving in socket sized chunks, decoded the way ServiceWorker does it
+// before: readLegacyStream, a QDataStream transaction over everything buffered, retried on every chunk
+// after: readFrames, FrameCodec checks one header per chunk and unpacks the payload once
+// run: FrameDecodeBench [-iterations N], compare legacyStream and frames rows of the same size
+class FrameDecodeBench final: public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr qsizetype ChunkSize = 64 * 1024; // one socket read
+    static constexpr qsizetype ProfileSize = 64 * 1024;
+
+    static QList<QVariant> makeImportArgs(const int numProfiles) {
+        QHash<QString, QByteArray> profiles;
+        QByteArray data;
+
+        for (int i=0; i<numProfiles; ++i) {
+            QByteArray profile (ProfileSize, Qt::Uninitialized);
+
+            for (qsizetype j=0; j<ProfileSize; ++j)
+                profile[j] = static_cast<char>((i * 31 + j * 7) & 0xff);
+
+            profiles.insert(QString("profile%1").arg(i), profile);
+        }
+
+        if (!PWTS::packData<QHash<QString, QByteArray>>(profiles, data))
+            return {};
+
+        return {static_cast<int>(PWTS::DCMD::IMPORT_PROFILES), data};
+    }
+
+    // returns the number of parse attempts, args is the decoded list
+    static int decodeLegacy(const QByteArray &message, QList<QVariant> &args) {
+        QByteArray arrived;
+        QBuffer dev (&arrived);
+        QDataStream streamIn (&dev);
+        int attempts = 0;
+
+        dev.open(QIODevice::ReadOnly);
+
+        for (qsizetype pos=0; pos<message.size(); pos+=ChunkSize) {
+            arrived.append(message.constData() + pos, qMin(ChunkSize, message.size() - pos));
+
+            ++attempts;
+            streamIn.startTransaction();
+            streamIn >> args;
+
+            if (streamIn.commitTransaction())
+                break;
+        }
+
+        return attempts;
+    }
+
+    static int decodeFrames(const QByteArray &message, QList<QVariant> &args) {
+        PWTD::FrameCodec decoder;
+        PWTD::FrameCodec::Frame frame;
+        int attempts = 0;
+
+        for (qsizetype pos=0; pos<message.size(); pos+=ChunkSize) {
+            decoder.append(message.mid(pos, ChunkSize));
+
+            ++attempts;
+
+            if (decoder.next(frame) == PWTD::FrameCodec::Result::Frame)
+                return PWTS::unpackData<QList<QVariant>>(frame.payload, args) ? attempts : -1;
+        }
+
+        return -1;
+    }
+
+    static void addSizes() {
+        QTest::addColumn<int>("numProfiles");
+
+        for (const int n: {16, 128, 512}) // 1, 8 and 32 MiB of profile data
+            QTest::newRow(qPrintable(QString("%1 profiles").arg(n))) << n;
+    }
+
+private slots:
+    void legacyStream_data() { addSizes(); }
+
+    void legacyStream() {
+        QFETCH(int, numProfiles);
+        const QList<QVariant> importArgs = makeImportArgs(numProfiles);
+        QByteArray message;
+        QList<QVariant> args;
+        int attempts = 0;
+
+        QVERIFY(!importArgs.isEmpty());
+        QVERIFY(PWTS::packData<QList<QVariant>>(importArgs, message));
+
+        QBENCHMARK {
+            attempts = decodeLegacy(message, args);
+        }
+
+        QCOMPARE(args, importArgs);
+        qInfo("%lld bytes, %d parse attempts", static_cast<long long>(message.size()), attempts);
+    }
+
+    void frames_data() { addSizes(); }
+
+    void frames() {
+        QFETCH(int, numProfiles);
+        const QList<QVariant> importArgs = makeImportArgs(numProfiles);
+        QByteArray payload;
+        QList<QVariant> args;
+        int attempts = 0;
+
+        QVERIFY(!importArgs.isEmpty());
+        QVERIFY(PWTS::packData<QList<QVariant>>(importArgs, payload));
+
+        const QByteArray message = PWTD::FrameCodec::encode(importArgs[0].toInt(), payload);
+
+        QBENCHMARK {
+            attempts = decodeFrames(message, args);
+        }
+
+        QCOMPARE(args, importArgs);
+        qInfo("%lld bytes, %d header checks", static_cast<long long>(message.size()), attempts);
+    }
+};
+
+QTEST_GUILESS_MAIN(FrameDecodeBench)
+#include "FrameDecodeBench.moc"
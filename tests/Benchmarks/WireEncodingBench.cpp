@@ -0,0 +1,299 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QTest>
+#include <array>
+
+#include "Service/Workers/FrameCodec.h"
+#include "Service/DaemonPacketDelta.h"
+#include "Service/DaemonCMDExt.h"
+#include "Device/Telemetry/TelemetrySample.h"
+#include "pwtShared/Include/DaemonCMD.h"
+#include "pwtShared/Utils.h"
+
+// bytes on wire and cpu per message type and encoding, against a 128 thread intel + linux daemon packet
+// encoding mirrors ServiceWorker::encodeMessage, decoding is what a client does with the frame
+// run: WireEncodingBench, the size table is printed once, then encode and decode rows per type/encoding/level
+// daemonPoll compares the serialization a GET_DAEMON_PACKET poll costs the daemon with a GET_DAEMON_PACKET_DELTA poll
+class WireEncodingBench final: public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int NumThreads = 128;
+    static constexpr int CompressionThreshold = 4096; // ServiceWorker::DefaultCompressionThreshold
+
+    enum class Encoding {
+        LegacyStream,
+        LegacyFrame
+    };
+
+    QMap<QString, QList<QVariant>> messages;
+
+    // the first changedThreads threads get minFreq as scaling min, the others 400
+    static PWTS::DaemonPacket makeDaemonPacket(const int minFreq, const int changedThreads = NumThreads) {
+        PWTS::DaemonPacket packet;
+
+        packet.intelData = QSharedPointer<PWTS::Intel::IntelData>::create();
+        packet.linuxData = QSharedPointer<PWTS::LNX::LinuxData>::create();
+
+        packet.linuxData->smtState = PWTS::RWData<QString>("on", true);
+        packet.linuxData->cpuIdleAvailableGovernors = PWTS::ROData<QList<QString>>({"menu", "teo", "ladder"}, true);
+        packet.linuxData->cpuIdleGovernor = PWTS::RWData<QString>("menu", true);
+
+        for (int i=0; i<NumThreads / 2; ++i)
+            packet.intelData->coreData.append(PWTS::Intel::IntelCoreData {});
+
+        for (int cpu=0; cpu<NumThreads; ++cpu) {
+            PWTS::Intel::IntelThreadData intelThd {};
+            PWTS::LNX::LinuxThreadData linuxThd {};
+            PWTS::LNX::CPUFrequencyLimits limits;
+            PWTS::LNX::CPUScalingAvailableGovernors governors;
+
+            intelThd.hwpCapapabilities = PWTS::ROData<PWTS::Intel::HWPCapabilities>({.lowestPerf = 1, .highestPerf = 52}, true);
+            intelThd.hwpRequest = PWTS::RWData<PWTS::Intel::HWPRequest>({
+                .requestPkg = {.min = 4, .max = 52, .desired = 0, .epp = 128, .acw = 0},
+                .packageControl = true,
+                .acwValid = false,
+                .eppValid = false,
+                .desiredValid = false,
+                .maxValid = false,
+                .minValid = false
+            }, true);
+
+            limits.limit.min = 400;
+            limits.limit.max = 5200;
+            limits.relatedCPUs = {QString::number(cpu ^ 1)};
+            governors.availableGovernors = {"performance", "powersave"};
+            governors.relatedCPUs = limits.relatedCPUs;
+
+            linuxThd.cpuLogicalOffAvailable = PWTS::ROData<bool>(cpu != 0, true);
+            linuxThd.coreID = PWTS::ROData<int>(cpu / 2, true);
+            linuxThd.cpuOnlineStatus = PWTS::RWData<int>(1, true);
+            linuxThd.cpuFrequencyLimits = PWTS::ROData<PWTS::LNX::CPUFrequencyLimits>(limits, true);
+            linuxThd.cpuFrequency = PWTS::RWData<PWTS::MinMax>({.min = cpu < changedThreads ? minFreq : 400, .max = 5200}, true);
+            linuxThd.scalingAvailableGovernors = PWTS::ROData<PWTS::LNX::CPUScalingAvailableGovernors>(governors, true);
+            linuxThd.scalingGovernor = PWTS::RWData<QString>("powersave", true);
+
+            packet.intelData->threadData.append(intelThd);
+            packet.linuxData->threadData.append(linuxThd);
+        }
+
+        return packet;
+    }
+
+    // delta reply to a client that acked the previous record
+    static QList<QVariant> makeDeltaMessage(PWTD::DaemonPacketDelta &delta, const PWTS::DaemonPacket &packet) {
+        const quint64 ack = delta.getGeneration();
+        QByteArray data;
+        bool full = false;
+
+        delta.record(packet);
+
+        if (!PWTS::packData<QHash<int, QByteArray>>(delta.getDelta(ack, full), data))
+            return {};
+
+        return {static_cast<int>(PWTD::DCMDExt::GET_DAEMON_PACKET_DELTA), delta.getGeneration(), full, data};
+    }
+
+    static PWTD::TelemetrySample makeTelemetrySample() {
+        PWTD::TelemetrySample sample;
+
+        sample.timestamp = 1760000000000;
+        sample.packageTemp = 62;
+        sample.packagePower = 28500;
+        sample.frequencySamplingCost = 180;
+        sample.fanSpeed = {{"cpu", 2400}, {"sys", 1100}};
+        sample.domainPower = {{"package", 28500}, {"core", 21000}, {"uncore", 1500}};
+
+        for (int cpu=0; cpu<NumThreads; ++cpu) {
+            sample.cpuFrequency.append(800 + (cpu * 37) % 4400);
+            sample.c0Residency.append((cpu * 97) % 1000);
+        }
+
+        return sample;
+    }
+
+    static QByteArray encode(const QList<QVariant> &args, const Encoding encoding, const int level) {
+        QByteArray payload;
+        quint16 flags = 0;
+
+        if (!PWTS::packData<QList<QVariant>>(args, payload))
+            return {};
+
+        if (encoding == Encoding::LegacyStream)
+            return payload;
+
+        if (level > 0 && payload.size() >= CompressionThreshold) {
+            const QByteArray compressed = qCompress(payload, level);
+
+            if (!compressed.isEmpty() && compressed.size() < payload.size()) {
+                payload = compressed;
+                flags |= PWTD::FrameCodec::FlagCompressed;
+            }
+        }
+
+        return PWTD::FrameCodec::encode(args[0].toInt(), payload, flags);
+    }
+
+    static bool decode(const QByteArray &data, const Encoding encoding, QList<QVariant> &args) {
+        if (encoding == Encoding::LegacyStream)
+            return PWTS::unpackData<QList<QVariant>>(data, args);
+
+        PWTD::FrameCodec decoder;
+        PWTD::FrameCodec::Frame frame;
+
+        decoder.append(data);
+
+        if (decoder.next(frame) != PWTD::FrameCodec::Result::Frame)
+            return false;
+
+        if ((frame.flags & PWTD::FrameCodec::FlagCompressed) != 0)
+            frame.payload = qUncompress(frame.payload);
+
+        return PWTS::unpackData<QList<QVariant>>(frame.payload, args);
+    }
+
+    static QString encodingName(const Encoding encoding) {
+        switch (encoding) {
+            case Encoding::LegacyStream:
+                return "legacy stream";
+            case Encoding::LegacyFrame:
+                return "frame";
+        }
+
+        return {};
+    }
+
+    void addRows() const {
+        QTest::addColumn<QString>("type");
+        QTest::addColumn<int>("encoding");
+        QTest::addColumn<int>("level");
+
+        for (const QString &type: messages.keys()) {
+            QTest::newRow(qPrintable(QString("%1/legacy stream").arg(type))) << type << static_cast<int>(Encoding::LegacyStream) << 0;
+
+            for (const int level: {0, 1, 6, 9})
+                QTest::newRow(qPrintable(QString("%1/%2/z%3").arg(type, encodingName(Encoding::LegacyFrame)).arg(level))) << type << static_cast<int>(Encoding::LegacyFrame) << level;
+        }
+    }
+
+private slots:
+    void initTestCase() {
+        PWTD::DaemonPacketDelta delta;
+        QByteArray sample;
+
+        QVERIFY(PWTS::packData<PWTD::TelemetrySample>(makeTelemetrySample(), sample));
+
+        // each delta is one poll after the previous one, unchanged, one thread's scaling limits changed, every thread's changed
+        delta.record(makeDaemonPacket(400));
+
+        messages.insert("daemon packet", {static_cast<int>(PWTS::DCMD::GET_DAEMON_PACKET), QVariant::fromValue<PWTS::DaemonPacket>(makeDaemonPacket(400))});
+        messages.insert("daemon delta idle", makeDeltaMessage(delta, makeDaemonPacket(400)));
+        messages.insert("daemon delta 1 thread", makeDeltaMessage(delta, makeDaemonPacket(800, 1)));
+        messages.insert("daemon delta 128 threads", makeDeltaMessage(delta, makeDaemonPacket(1200)));
+        messages.insert("telemetry sample", {static_cast<int>(PWTD::DCMDExt::TELEMETRY_SAMPLE), sample});
+
+        for (const QList<QVariant> &args: std::as_const(messages))
+            QVERIFY(!args.isEmpty());
+
+        qInfo("%-26s %14s %14s %14s %14s %14s", "bytes on wire", "legacy stream", "frame", "frame z1", "frame z6", "frame z9");
+
+        for (auto it = messages.constBegin(); it != messages.constEnd(); ++it) {
+            qInfo("%-26s %14lld %14lld %14lld %14lld %14lld", qPrintable(it.key()),
+                static_cast<long long>(encode(it.value(), Encoding::LegacyStream, 0).size()),
+                static_cast<long long>(encode(it.value(), Encoding::LegacyFrame, 0).size()),
+                static_cast<long long>(encode(it.value(), Encoding::LegacyFrame, 1).size()),
+                static_cast<long long>(encode(it.value(), Encoding::LegacyFrame, 6).size()),
+                static_cast<long long>(encode(it.value(), Encoding::LegacyFrame, 9).size()));
+        }
+    }
+
+    void encodeMessage_data() { addRows(); }
+
+    void encodeMessage() {
+        QFETCH(QString, type);
+        QFETCH(int, encoding);
+        QFETCH(int, level);
+        const QList<QVariant> &args = messages[type];
+        QByteArray data;
+
+        QBENCHMARK {
+            data = encode(args, static_cast<Encoding>(encoding), level);
+        }
+
+        QVERIFY(!data.isEmpty());
+    }
+
+    void decodeMessage_data() { addRows(); }
+
+    void decodeMessage() {
+        QFETCH(QString, type);
+        QFETCH(int, encoding);
+        QFETCH(int, level);
+        const QList<QVariant> &args = messages[type];
+        const QByteArray data = encode(args, static_cast<Encoding>(encoding), level);
+        QList<QVariant> decoded;
+        bool res = false;
+
+        QVERIFY(!data.isEmpty());
+
+        QBENCHMARK {
+            decoded.clear();
+            res = decode(data, static_cast<Encoding>(encoding), decoded);
+        }
+
+        QVERIFY(res);
+        QCOMPARE(decoded.size(), args.size());
+        QCOMPARE(decoded[0].toInt(), args[0].toInt());
+    }
+
+    // per poll daemon side cost after the packet is filled, the fill reads the hardware either way
+    // delta rows alternate two packets that differ like the row says, so every poll has that much to diff
+    void daemonPoll_data() {
+        QTest::addColumn<int>("changedThreads"); // -1 sends the full packet
+
+        QTest::newRow("full packet") << -1;
+        QTest::newRow("delta idle") << 0;
+        QTest::newRow("delta 1 thread") << 1;
+        QTest::newRow("delta 128 threads") << NumThreads;
+    }
+
+    void daemonPoll() {
+        QFETCH(int, changedThreads);
+        const std::array<PWTS::DaemonPacket, 2> packets {makeDaemonPacket(400), makeDaemonPacket(800, qMax(changedThreads, 0))};
+        PWTD::DaemonPacketDelta delta;
+        QByteArray data;
+        int poll = 0;
+
+        delta.record(packets[0]);
+
+        QBENCHMARK {
+            const PWTS::DaemonPacket &packet = changedThreads == 0 ? packets[0] : packets[++poll % 2];
+
+            if (changedThreads < 0)
+                data = encode({static_cast<int>(PWTS::DCMD::GET_DAEMON_PACKET), QVariant::fromValue<PWTS::DaemonPacket>(packet)}, Encoding::LegacyFrame, 0);
+            else
+                data = encode(makeDeltaMessage(delta, packet), Encoding::LegacyFrame, 0);
+        }
+
+        QVERIFY(!data.isEmpty());
+        qInfo("%lld bytes per poll", static_cast<long long>(data.size()));
+    }
+};
+
+QTEST_GUILESS_MAIN(WireEncodingBench)
+#include "WireEncodingBench.moc"
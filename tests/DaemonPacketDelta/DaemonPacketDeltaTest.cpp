@@ -0,0 +1,155 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QTest>
+#include <algorithm>
+
+#include "Service/DaemonPacketDelta.h"
+#include "pwtShared/Utils.h"
+
+using Delta = PWTD::DaemonPacketDelta;
+
+class DaemonPacketDeltaTest final: public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int NumThreads = 8;
+
+    static PWTS::DaemonPacket makePacket(const QList<int> &minFreqs) {
+        PWTS::DaemonPacket packet;
+
+        packet.linuxData = QSharedPointer<PWTS::LNX::LinuxData>::create();
+        packet.linuxData->cpuIdleGovernor = PWTS::RWData<QString>("menu", true);
+
+        for (const int freq: minFreqs) {
+            PWTS::LNX::LinuxThreadData thd {};
+
+            thd.cpuOnlineStatus = PWTS::RWData<int>(1, true);
+            thd.cpuFrequency = PWTS::RWData<PWTS::MinMax>({.min = freq, .max = 5200}, true);
+            packet.linuxData->threadData.append(thd);
+        }
+
+        return packet;
+    }
+
+    static int threadKey(const int entry) {
+        return Delta::makeKey(Delta::Section::LinuxData, static_cast<int>(Delta::LinuxMember::ThreadData), entry);
+    }
+
+private slots:
+    void unknownAckIsFull() {
+        Delta delta;
+        bool full = false;
+
+        delta.record(makePacket(QList<int>(NumThreads, 400)));
+
+        const QHash<int, QByteArray> parts = delta.getDelta(0, full);
+
+        QVERIFY(full);
+        QVERIFY(parts.contains(Delta::makeKey(Delta::Section::Header)));
+        QVERIFY(parts.contains(Delta::makeKey(Delta::Section::LinuxData)));
+        QVERIFY(parts.contains(threadKey(0)));
+        QVERIFY(parts.contains(threadKey(NumThreads)));
+        QVERIFY(!parts.contains(threadKey(NumThreads + 1)));
+
+        delta.getDelta(delta.getGeneration() + 1, full);
+        QVERIFY(full);
+    }
+
+    void idlePollIsEmpty() {
+        Delta delta;
+        bool full = true;
+
+        delta.record(makePacket(QList<int>(NumThreads, 400)));
+
+        const quint64 ack = delta.getGeneration();
+
+        delta.record(makePacket(QList<int>(NumThreads, 400)));
+
+        QCOMPARE(delta.getGeneration(), ack);
+        QVERIFY(delta.getDelta(ack, full).isEmpty());
+        QVERIFY(!full);
+    }
+
+    // only the entry that changed goes, not the rest of the list or the section base
+    void oneThreadChanged() {
+        QList<int> freqs(NumThreads, 400);
+        Delta delta;
+        bool full = true;
+
+        delta.record(makePacket(freqs));
+
+        const quint64 ack = delta.getGeneration();
+        PWTS::LNX::LinuxThreadData thd;
+
+        freqs[3] = 800;
+        delta.record(makePacket(freqs));
+
+        const QHash<int, QByteArray> parts = delta.getDelta(ack, full);
+
+        QVERIFY(!full);
+        QCOMPARE(parts.keys(), QList<int> {threadKey(4)});
+        QVERIFY(PWTS::unpackData<PWTS::LNX::LinuxThreadData>(parts[threadKey(4)], thd));
+        QCOMPARE(thd.cpuFrequency.getValue().min, 800);
+    }
+
+    // a shorter list is told by its count, the dropped entries are not sent
+    void listShrinks() {
+        Delta delta;
+        bool full = true;
+        int count = 0;
+
+        delta.record(makePacket(QList<int>(NumThreads, 400)));
+
+        const quint64 ack = delta.getGeneration();
+
+        delta.record(makePacket(QList<int>(NumThreads / 2, 400)));
+
+        const QHash<int, QByteArray> parts = delta.getDelta(ack, full);
+
+        QVERIFY(!full);
+        QCOMPARE(parts.keys(), QList<int> {threadKey(0)});
+        QVERIFY(PWTS::unpackData<int>(parts[threadKey(0)], count));
+        QCOMPARE(count, NumThreads / 2);
+        QVERIFY(!delta.getDelta(0, full).contains(threadKey(NumThreads)));
+    }
+
+    // a client that acked an older generation gets everything changed since, merged
+    void olderAck() {
+        QList<int> freqs(NumThreads, 400);
+        Delta delta;
+        bool full = true;
+
+        delta.record(makePacket(freqs));
+
+        const quint64 ack = delta.getGeneration();
+
+        freqs[1] = 800;
+        delta.record(makePacket(freqs));
+        freqs[6] = 800;
+        delta.record(makePacket(freqs));
+
+        QList<int> keys = delta.getDelta(ack, full).keys();
+
+        std::ranges::sort(keys);
+        QVERIFY(!full);
+        QCOMPARE(keys, (QList<int> {threadKey(2), threadKey(7)}));
+    }
+};
+
+QTEST_GUILESS_MAIN(DaemonPacketDeltaTest)
+#include "DaemonPacketDeltaTest.moc"
@@ -0,0 +1,132 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QTest>
+#include <QFile>
+
+#include "Device/OS/Linux/DeviceInventory.h"
+
+using Inventory = PWTD::LNX::DeviceInventory;
+using Source = Inventory::Source;
+
+class DeviceInventoryTest final: public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr quint32 bit(const Source source) { return static_cast<quint32>(source); }
+
+    // recorded netlink datagrams, one event per file
+    static QByteArray readFixture(const QString &name) {
+        QFile file(QStringLiteral(FIXTURES_DIR "/%1").arg(name));
+
+        if (!file.open(QIODevice::ReadOnly))
+            return {};
+
+        return file.readAll();
+    }
+
+private slots:
+    void parseUEvent_data() {
+        QTest::addColumn<QString>("fixture");
+        QTest::addColumn<QByteArray>("action");
+        QTest::addColumn<QByteArray>("subsystem");
+        QTest::addColumn<QByteArray>("devpath");
+
+        QTest::newRow("block add") << "block_add.uevent" << QByteArray("add") << QByteArray("block")
+            << QByteArray("/devices/pci0000:00/0000:00:14.0/usb2/2-1/2-1:1.0/host6/target6:0:0/6:0:0:0/block/sdb");
+        QTest::newRow("cpu offline") << "cpu_offline.uevent" << QByteArray("offline") << QByteArray("cpu") << QByteArray("/devices/system/cpu/cpu3");
+        QTest::newRow("udev monitor") << "udev_monitor.uevent" << QByteArray() << QByteArray() << QByteArray();
+        QTest::newRow("truncated") << "block_add_truncated.uevent" << QByteArray("add") << QByteArray("bl")
+            << QByteArray("/devices/pci0000:00/0000:00:14.0/usb2/2-1/2-1:1.0/host6/target6:0:0/6:0:0:0/block/sdb");
+    }
+
+    void parseUEvent() {
+        QFETCH(QString, fixture);
+        QFETCH(QByteArray, action);
+        QFETCH(QByteArray, subsystem);
+        QFETCH(QByteArray, devpath);
+
+        const QByteArray msg = readFixture(fixture);
+
+        QVERIFY(!msg.isEmpty());
+
+        const Inventory::UEvent event = Inventory::parseUEvent(msg);
+
+        QCOMPARE(event.action.toByteArray(), action);
+        QCOMPARE(event.subsystem.toByteArray(), subsystem);
+        QCOMPARE(event.devpath.toByteArray(), devpath);
+    }
+
+    void parseUEventMalformed() {
+        QCOMPARE(Inventory::parseUEvent(QByteArrayView()).action.size(), 0);
+        QCOMPARE(Inventory::parseUEvent(QByteArrayView("add@", 4)).action.size(), 0); // no fields
+        QCOMPARE(Inventory::parseUEvent(QByteArrayView("\0ACTION=add", 11)).action.size(), 0); // empty header
+        QCOMPARE(Inventory::parseUEvent(QByteArrayView("add@/x\0\0\0", 9)).subsystem.size(), 0);
+    }
+
+    void getSourcesForUEvent_data() {
+        QTest::addColumn<QString>("fixture");
+        QTest::addColumn<quint32>("sources");
+
+        QTest::newRow("usb add") << "usb_add.uevent" << bit(Source::USB);
+        QTest::newRow("scsi disk add") << "scsi_disk_add.uevent" << bit(Source::Disk);
+        QTest::newRow("block add") << "block_add.uevent" << (bit(Source::BlockQueue) | bit(Source::Disk));
+        QTest::newRow("block change") << "block_change.uevent" << 0u;
+        QTest::newRow("block remove") << "block_remove.uevent" << (bit(Source::BlockQueue) | bit(Source::Disk));
+        QTest::newRow("usb remove") << "usb_remove.uevent" << bit(Source::USB);
+        QTest::newRow("cpu offline") << "cpu_offline.uevent" << bit(Source::CPU);
+        QTest::newRow("cpu online") << "cpu_online.uevent" << bit(Source::CPU);
+        QTest::newRow("drm hotplug change") << "drm_change.uevent" << 0u;
+        QTest::newRow("pci remove") << "pci_remove.uevent" << bit(Source::PCI);
+        QTest::newRow("i2c bind") << "i2c_bind.uevent" << bit(Source::I2c);
+        QTest::newRow("net add") << "net_add.uevent" << 0u;
+        QTest::newRow("udev monitor") << "udev_monitor.uevent" << 0u;
+        QTest::newRow("truncated") << "block_add_truncated.uevent" << 0u;
+    }
+
+    void getSourcesForUEvent() {
+        QFETCH(QString, fixture);
+        QFETCH(quint32, sources);
+
+        const QByteArray msg = readFixture(fixture);
+
+        QVERIFY(!msg.isEmpty());
+        QCOMPARE(Inventory::getSourcesForUEvent(Inventory::parseUEvent(msg)), sources);
+    }
+
+    // usb stick plugged in and pulled out, fold the events like DeviceInventory::sync does
+    void replayHotplug() {
+        const QStringList sequence {
+            "usb_add.uevent", "scsi_disk_add.uevent", "block_add.uevent", "block_change.uevent",
+            "block_remove.uevent", "usb_remove.uevent", "net_add.uevent", "udev_monitor.uevent"
+        };
+        quint32 dirty = 0;
+
+        for (const QString &fixture: sequence) {
+            const QByteArray msg = readFixture(fixture);
+
+            QVERIFY2(!msg.isEmpty(), qPrintable(fixture));
+            dirty |= Inventory::getSourcesForUEvent(Inventory::parseUEvent(msg));
+        }
+
+        QCOMPARE(dirty, bit(Source::USB) | bit(Source::Disk) | bit(Source::BlockQueue));
+        QVERIFY((dirty & (bit(Source::CPU) | bit(Source::DRM) | bit(Source::PCI) | bit(Source::I2c))) == 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(DeviceInventoryTest)
+#include "DeviceInventoryTest.moc"
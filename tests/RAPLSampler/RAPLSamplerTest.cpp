@@ -0,0 +1,247 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QTest>
+#include <QHash>
+
+#include "Device/CPU/Intel/RAPL/RAPLSampler.h"
+
+namespace {
+    // energy status counters that advance by a fixed step on every read, addresses not in the map fail to read
+    class MockMSR final: public PWTD::MSR {
+    public:
+        struct Counter final {
+            uint32_t count = 0;
+            uint32_t step = 0;
+            int failReads = 0;
+            int reads = 0;
+        };
+
+        mutable QHash<uint32_t, Counter> counters;
+
+        [[nodiscard]] bool openMsrFd(const int cpu) override { return cpu == 0; }
+        void closeMsrFd(const int cpu) override {}
+        [[nodiscard]] bool writeMSR(const uint64_t value, const uint32_t adr, const int cpu) const override { return false; }
+        [[nodiscard]] bool writeMSR(const uint32_t value, const uint32_t adr, const int cpu) const override { return false; }
+
+        [[nodiscard]] bool readMSR(uint64_t &ret, const uint32_t adr, const int cpu) const override {
+            const auto it = counters.find(adr);
+
+            if (cpu != 0 || it == counters.end())
+                return false;
+
+            Counter &counter = it.value();
+
+            ++counter.reads;
+
+            if (counter.failReads > 0) {
+                --counter.failReads;
+                return false;
+            }
+
+            // reserved high bits are not part of the counter
+            ret = (0xdeadbeefULL << 32) | counter.count;
+            counter.count += counter.step;
+            return true;
+        }
+
+        [[nodiscard]] bool readMSR(uint32_t &ret, const uint32_t adr, const int cpu) const override {
+            uint64_t raw = 0;
+
+            if (!readMSR(raw, adr, cpu))
+                return false;
+
+            ret = static_cast<uint32_t>(raw);
+            return true;
+        }
+
+        [[nodiscard]] bool runBatch(PWTD::MSRBatch &batch) override {
+            for (const int i: batch.getCPUOrder()) {
+                PWTD::MSROp &op = batch.getOps()[i];
+
+                op.ok = runOp(op, [&](uint64_t &ret)->bool { return readMSR(ret, op.addr, op.cpu); }, [](uint64_t)->bool { return false; });
+            }
+
+            return batch.allOk();
+        }
+    };
+}
+
+class RAPLSamplerTest final: public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr double energyUnit = 1.0 / 16384; // 61 uJ, the usual intel esu
+    QSharedPointer<MockMSR> msr;
+
+    // milliwatts for step counts over an elapsed time range, the sampler clock is not injectable
+    static void verifyPower(const int mw, const uint32_t step, const qint64 minNsecs, const qint64 maxNsecs) {
+        const double joules = step * energyUnit;
+        const int lo = static_cast<int>(joules * 1e12 / maxNsecs);
+        const int hi = static_cast<int>(joules * 1e12 / minNsecs) + 1;
+
+        QVERIFY2(mw >= lo && mw <= hi, qPrintable(QString("%1 mW not in [%2, %3]").arg(mw).arg(lo).arg(hi)));
+    }
+
+private slots:
+    void initTestCase() {
+        msr = QSharedPointer<MockMSR>::create();
+        PWTD::MSRFactory::setMSRInstance(msr);
+    }
+
+    void init() {
+        msr->counters.clear();
+    }
+
+    void counterFirstUpdateInvalid() {
+        PWTD::EnergyCounter counter;
+
+        counter.setEnergyUnit(energyUnit);
+        QVERIFY(!counter.update(1000, 1'000'000).isValid());
+    }
+
+    void counterAveragePower() {
+        PWTD::EnergyCounter counter;
+
+        counter.setEnergyUnit(energyUnit);
+        (void)counter.update(0, 0);
+
+        const PWTS::ROData<int> mw = counter.update(16384, 1'000'000'000); // 1 J in 1 s
+
+        QVERIFY(mw.isValid());
+        QCOMPARE(mw.getValue(), 1000);
+    }
+
+    void counterWrap() {
+        PWTD::EnergyCounter counter;
+
+        counter.setEnergyUnit(energyUnit);
+        (void)counter.update(0xfffff000, 0);
+
+        const PWTS::ROData<int> mw = counter.update(0x00001000, 500'000'000); // 0x2000 counts, 0.5 J in 0.5 s
+
+        QVERIFY(mw.isValid());
+        QCOMPARE(mw.getValue(), 1000);
+    }
+
+    // 15 W sampled every 100 ms, the counter wraps a few samples in
+    void counterSequenceAcrossWrap() {
+        static constexpr uint32_t step = 24576; // 1.5 J
+        PWTD::EnergyCounter counter;
+        uint32_t count = 0xffffffff - 3 * step;
+        bool wrapped = false;
+
+        counter.setEnergyUnit(energyUnit);
+        (void)counter.update(count, 0);
+
+        for (int i=1; i<=20; ++i) {
+            const uint32_t next = count + step;
+
+            wrapped |= next < count;
+            count = next;
+
+            const PWTS::ROData<int> mw = counter.update(count, i * 100'000'000LL);
+
+            QVERIFY(mw.isValid());
+            QCOMPARE(mw.getValue(), 15000);
+        }
+
+        QVERIFY(wrapped);
+    }
+
+    void counterRejectsBadInput() {
+        PWTD::EnergyCounter counter;
+
+        (void)counter.update(0, 0);
+        QVERIFY(!counter.update(16384, 1'000'000'000).isValid()); // no energy unit
+
+        counter.setEnergyUnit(energyUnit);
+        (void)counter.update(0, 1'000'000'000);
+        QVERIFY(!counter.update(16384, 1'000'000'000).isValid()); // no time passed
+        QVERIFY(counter.update(32768, 2'000'000'000).isValid()); // state moved on anyway
+
+        counter.setEnergyUnit(energyUnit);
+        QVERIFY(!counter.update(49152, 3'000'000'000).isValid()); // unit change resets
+    }
+
+    void samplerDomains() {
+        PWTD::Intel::RAPLSampler sampler;
+
+        sampler.init(energyUnit);
+        QVERIFY(!sampler.isAvailable());
+
+        msr->counters.insert(PWTD::Intel::MSR_ENERGY_STATUS::PKG, {});
+        msr->counters.insert(PWTD::Intel::MSR_ENERGY_STATUS::PP0, {});
+        sampler.init(energyUnit);
+
+        QVERIFY(sampler.isAvailable());
+        QVERIFY(sampler.sample().isEmpty()); // first sample has no previous count
+        QTest::qSleep(1);
+        QCOMPARE(sampler.sample().keys(), QStringList({"core", "package"}));
+    }
+
+    void samplerPowerAcrossWrap() {
+        static constexpr uint32_t pkgStep = 8192; // 0.5 J
+        static constexpr uint32_t coreStep = 4096;
+        PWTD::Intel::RAPLSampler sampler;
+        QElapsedTimer timer;
+
+        // init reads once, the first sample lands on 0xfffff000 and the second wraps
+        msr->counters.insert(PWTD::Intel::MSR_ENERGY_STATUS::PKG, {.count = 0xfffff000 - pkgStep, .step = pkgStep});
+        msr->counters.insert(PWTD::Intel::MSR_ENERGY_STATUS::PP0, {.count = 0, .step = coreStep});
+        sampler.init(energyUnit);
+
+        timer.start();
+        QVERIFY(sampler.sample().isEmpty());
+
+        const qint64 firstEnd = timer.nsecsElapsed();
+
+        QTest::qSleep(50);
+
+        const qint64 secondStart = timer.nsecsElapsed();
+        const QMap<QString, int> power = sampler.sample();
+        const qint64 secondEnd = timer.nsecsElapsed();
+
+        QVERIFY(power.contains("package"));
+        QVERIFY(power.contains("core"));
+        verifyPower(power["package"], pkgStep, secondStart - firstEnd, secondEnd);
+        verifyPower(power["core"], coreStep, secondStart - firstEnd, secondEnd);
+    }
+
+    // a failed read drops the domain from that sample and the next one, the counter restarts
+    void samplerReadFailure() {
+        PWTD::Intel::RAPLSampler sampler;
+
+        msr->counters.insert(PWTD::Intel::MSR_ENERGY_STATUS::PKG, {.count = 0, .step = 1000});
+        sampler.init(energyUnit);
+
+        (void)sampler.sample();
+        QTest::qSleep(5);
+        QVERIFY(sampler.sample().contains("package"));
+
+        msr->counters[PWTD::Intel::MSR_ENERGY_STATUS::PKG].failReads = 1;
+        QTest::qSleep(5);
+        QVERIFY(sampler.sample().isEmpty());
+        QTest::qSleep(5);
+        QVERIFY(sampler.sample().isEmpty());
+        QTest::qSleep(5);
+        QVERIFY(sampler.sample().contains("package"));
+    }
+};
+
+QTEST_GUILESS_MAIN(RAPLSamplerTest)
+#include "RAPLSamplerTest.moc"
@@ -0,0 +1,363 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QTest>
+#include <QSignalSpy>
+#include <QDir>
+#include <QFile>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+
+#include "Service/Workers/ServiceWorker.h"
+#include "pwtShared/Utils.h"
+
+namespace {
+    // polling client on the unix socket, legacy stream or framed, keeps every message it receives
+    class TestClient final {
+    private:
+        QDataStream streamIn;
+        PWTD::FrameCodec decoder;
+
+        void onReadyRead() {
+            if (framed) {
+                PWTD::FrameCodec::Frame frame;
+
+                decoder.append(sock.readAll());
+
+                while (decoder.next(frame) == PWTD::FrameCodec::Result::Frame) {
+                    QList<QVariant> args;
+
+                    if ((frame.flags & PWTD::FrameCodec::FlagCompressed) != 0) {
+                        frame.payload = qUncompress(frame.payload);
+                        ++compressedFrames;
+                    }
+
+                    if (PWTS::unpackData<QList<QVariant>>(frame.payload, args))
+                        received.append(args);
+                    else
+                        ++errors;
+                }
+
+                return;
+            }
+
+            while (true) {
+                QList<QVariant> args;
+
+                streamIn.startTransaction();
+                streamIn >> args;
+
+                if (!streamIn.commitTransaction())
+                    break;
+
+                received.append(args);
+            }
+        }
+
+    public:
+        QLocalSocket sock;
+        QString marker;
+        bool framed;
+        QList<QList<QVariant>> received;
+        int errors = 0;
+        int compressedFrames = 0;
+
+        TestClient(const QString &path, const QString &id, const bool useFrames): marker(id), framed(useFrames) {
+            streamIn.setDevice(&sock);
+            QObject::connect(&sock, &QLocalSocket::readyRead, &sock, [this]() { onReadyRead(); });
+            sock.connectToServer(path);
+        }
+
+        void send(const QList<QVariant> &args) {
+            QByteArray data;
+
+            if (!PWTS::packData<QList<QVariant>>(args, data))
+                return;
+
+            sock.write(framed ? PWTD::FrameCodec::encode(args[0].toInt(), data) : data);
+            sock.flush();
+        }
+
+        void poll(const int seq) {
+            send({static_cast<int>(PWTS::DCMD::GET_PROFILE_LIST), marker, seq});
+        }
+
+        [[nodiscard]] QList<QList<QVariant>> messages(const int cmd) const {
+            QList<QList<QVariant>> ret;
+
+            for (const QList<QVariant> &args: received) {
+                if (args[0].toInt() == cmd)
+                    ret.append(args);
+            }
+
+            return ret;
+        }
+    };
+}
+
+class ServiceWorkerTest final: public QObject {
+    Q_OBJECT
+
+private:
+    static constexpr int SampleCmd = static_cast<int>(PWTD::DCMDExt::TELEMETRY_SAMPLE);
+    static constexpr int PollCmd = static_cast<int>(PWTS::DCMD::GET_PROFILE_LIST);
+    static constexpr int CompressionCmd = static_cast<int>(PWTD::DCMDExt::NEGOTIATE_COMPRESSION);
+    QString socketPath;
+    QScopedPointer<PWTD::ServiceWorker> worker;
+    QList<TestClient *> clients;
+    QHash<QString, quint64> clientIDs; // marker, id the worker assigned
+    QSet<quint64> connected;
+
+    TestClient *addClient(const bool framed) {
+        TestClient *client = new TestClient(socketPath, QString("client%1").arg(clients.size()), framed);
+
+        clients.append(client);
+        return client;
+    }
+
+    // the hello poll tells which worker id belongs to which client
+    bool connectClients() {
+        for (TestClient *client: std::as_const(clients)) {
+            if (!client->sock.waitForConnected(5000))
+                return false;
+
+            client->poll(-1);
+        }
+
+        return QTest::qWaitFor([this]() {
+            return std::ranges::all_of(clients, [this](const TestClient *client) { return clientIDs.contains(client->marker) && !client->messages(PollCmd).isEmpty(); });
+        }, 5000);
+    }
+
+    // slow reader on a raw socket, it sends its hello and then never reads
+    int connectRawClient(const QString &marker) {
+        const QByteArray path = socketPath.toLocal8Bit();
+        const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un addr {};
+        QByteArray hello;
+
+        addr.sun_family = AF_UNIX;
+        qstrncpy(addr.sun_path, path.constData(), sizeof(addr.sun_path));
+
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            !PWTS::packData<QList<QVariant>>({PollCmd, marker, -1}, hello) || ::write(fd, hello.constData(), hello.size()) != hello.size()) {
+            if (fd >= 0)
+                close(fd);
+
+            return -1;
+        }
+
+        return fd;
+    }
+
+private slots:
+    void initTestCase() {
+        socketPath = QDir::temp().filePath(QString("pwtd-servicetest-%1.sock").arg(QCoreApplication::applicationPid()));
+
+        // no uids or group, only root and our own uid, which the test clients run as
+        PWTD::ServiceWorker::setLocalSocket(socketPath, {}, -1, true);
+        PWTD::ServiceWorker::setCompression(PWTD::ServiceWorker::DefaultCompressionLevel, PWTD::ServiceWorker::DefaultCompressionThreshold);
+
+        worker.reset(new PWTD::ServiceWorker);
+        worker->init();
+
+        // echo every poll back to the client id the worker reported, like DaemonService replies to the asking client
+        QObject::connect(worker.get(), &PWTD::ServiceWorker::cmdReceived, this, [this](const quint64 clientID, const QList<QVariant> &args) {
+            clientIDs.insert(args[1].toString(), clientID);
+            connected.insert(clientID);
+            worker->sendProfileList(clientID, {args[1].toString(), args[2].toString()});
+        });
+
+        QObject::connect(worker.get(), &PWTD::ServiceWorker::clientDisconnected, this, [this](const quint64 clientID) {
+            connected.remove(clientID);
+        });
+
+        worker->startServer(QHostAddress::LocalHost, 0);
+        QVERIFY(QFile::exists(socketPath));
+    }
+
+    void cleanupTestCase() {
+        worker->stopServer();
+        worker.reset();
+    }
+
+    void cleanup() {
+        for (TestClient *client: std::as_const(clients))
+            client->sock.abort();
+
+        qDeleteAll(clients);
+        clients.clear();
+        clientIDs.clear();
+
+        QTRY_VERIFY(connected.isEmpty());
+    }
+
+    // clients poll back to back without waiting, every reply must go to the client that asked, in order
+    void routing() {
+        static constexpr int Polls = 50;
+
+        for (int i=0; i<6; ++i)
+            addClient(i % 3 == 0);
+
+        QVERIFY(connectClients());
+
+        for (int seq=0; seq<Polls; ++seq) {
+            for (TestClient *client: std::as_const(clients))
+                client->poll(seq);
+        }
+
+        for (TestClient *client: std::as_const(clients)) {
+            QTRY_COMPARE(client->messages(PollCmd).size(), Polls + 1);
+
+            const QList<QList<QVariant>> replies = client->messages(PollCmd);
+
+            for (int i=0; i<replies.size(); ++i) {
+                const QStringList reply = replies[i][1].toStringList();
+
+                QCOMPARE(reply.size(), 2);
+                QCOMPARE(reply[0], client->marker);
+                QCOMPARE(reply[1].toInt(), i - 1);
+            }
+
+            QCOMPARE(client->errors, 0);
+        }
+    }
+
+    void broadcast() {
+        for (int i=0; i<4; ++i)
+            addClient(i % 2 == 0);
+
+        QVERIFY(connectClients());
+
+        worker->sendTelemetrySample({PWTD::ServiceWorker::Broadcast}, QByteArray("sample0"));
+
+        for (const TestClient *client: std::as_const(clients))
+            QTRY_COMPARE(client->messages(SampleCmd).size(), 1);
+
+        // a client id list reaches only those clients
+        worker->sendTelemetrySample({clientIDs[clients[1]->marker], clientIDs[clients[2]->marker]}, QByteArray("sample1"));
+
+        QTRY_COMPARE(clients[1]->messages(SampleCmd).size(), 2);
+        QTRY_COMPARE(clients[2]->messages(SampleCmd).size(), 2);
+        QTest::qWait(100);
+        QCOMPARE(clients[0]->messages(SampleCmd).size(), 1);
+        QCOMPARE(clients[3]->messages(SampleCmd).size(), 1);
+
+        for (const TestClient *client: std::as_const(clients)) {
+            const QList<QList<QVariant>> samples = client->messages(SampleCmd);
+
+            QCOMPARE(samples[0][1].toByteArray(), QByteArray("sample0"));
+
+            if (samples.size() > 1)
+                QCOMPARE(samples[1][1].toByteArray(), QByteArray("sample1"));
+        }
+    }
+
+    // a client that never reads is dropped once MaxPendingWrite is queued for it, the others keep receiving
+    void slowClientDropped() {
+        static constexpr int SampleSize = 4 * 1024 * 1024;
+        static constexpr int MaxSamples = 16; // 64 MiB, twice the limit
+        const QByteArray sample(SampleSize, 's');
+        QSignalSpy disconnectSpy(worker.get(), &PWTD::ServiceWorker::clientDisconnected);
+
+        addClient(true);
+        addClient(false);
+        addClient(true);
+        QVERIFY(connectClients());
+
+        const int slowFd = connectRawClient("slow");
+
+        QVERIFY(slowFd >= 0);
+        QTRY_VERIFY(clientIDs.contains("slow"));
+
+        const quint64 slowID = clientIDs["slow"];
+        int sent = 0;
+
+        while (sent < MaxSamples && connected.contains(slowID)) {
+            worker->sendTelemetrySample({PWTD::ServiceWorker::Broadcast}, sample);
+            ++sent;
+
+            // fast clients drain before the next sample, only the slow one piles up
+            for (const TestClient *client: std::as_const(clients))
+                QTRY_COMPARE_WITH_TIMEOUT(client->messages(SampleCmd).size(), sent, 10000);
+        }
+
+        qInfo("slow client dropped after %d samples of %d bytes", sent, SampleSize);
+
+        QVERIFY(!connected.contains(slowID));
+        QVERIFY(sent < MaxSamples);
+        QCOMPARE(disconnectSpy.count(), 1);
+        QCOMPARE(disconnectSpy.first().first().toULongLong(), slowID);
+
+        for (const TestClient *client: std::as_const(clients)) {
+            QCOMPARE(client->sock.state(), QLocalSocket::ConnectedState);
+            QCOMPARE(client->messages(SampleCmd).last()[1].toByteArray().size(), SampleSize);
+        }
+
+        close(slowFd);
+    }
+
+    // a framed client that asks for compression gets large payloads as zlib frames, small ones and other clients stay plain
+    void compression() {
+        const QByteArray large = QByteArray("telemetry sample ").repeated(4096);
+        const QByteArray small("sample");
+        TestClient *zclient = addClient(true);
+        const TestClient *plain = addClient(true);
+
+        QVERIFY(connectClients());
+
+        zclient->send({CompressionCmd, true});
+
+        QTRY_COMPARE(zclient->messages(CompressionCmd).size(), 1);
+        QCOMPARE(zclient->messages(CompressionCmd).first()[1].toInt(), PWTD::ServiceWorker::DefaultCompressionThreshold);
+
+        worker->sendTelemetrySample({PWTD::ServiceWorker::Broadcast}, large);
+        worker->sendTelemetrySample({PWTD::ServiceWorker::Broadcast}, small);
+
+        QTRY_COMPARE(zclient->messages(SampleCmd).size(), 2);
+        QTRY_COMPARE(plain->messages(SampleCmd).size(), 2);
+
+        QCOMPARE(zclient->compressedFrames, 1);
+        QCOMPARE(plain->compressedFrames, 0);
+        QCOMPARE(zclient->errors, 0);
+
+        for (const TestClient *client: {static_cast<const TestClient *>(zclient), plain}) {
+            const QList<QList<QVariant>> samples = client->messages(SampleCmd);
+
+            QCOMPARE(samples[0][1].toByteArray(), large);
+            QCOMPARE(samples[1][1].toByteArray(), small);
+        }
+    }
+
+    // past 16 clients new connections are closed right away
+    void clientLimit() {
+        for (int i=0; i<16; ++i)
+            addClient(false);
+
+        QVERIFY(connectClients());
+
+        const TestClient *extra = addClient(false);
+
+        QTRY_COMPARE(extra->sock.state(), QLocalSocket::UnconnectedState);
+        QCOMPARE(connected.size(), 16);
+    }
+};
+
+QTEST_GUILESS_MAIN(ServiceWorkerTest)
+#include "ServiceWorkerTest.moc"
@@ -0,0 +1,219 @@
+/*
+ * This file is part of PowerTunerDaemon.
+ * Copyright (C) 2025 kylon
+ *
+ * PowerTunerDaemon is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * PowerTunerDaemon is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QTest>
+#include <QThread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+
+#include "Service/TelemetryExport/Linux/TelemetryExportLinux.h"
+
+namespace {
+    constexpr int NumCpus = 128;
+
+    // every field of sample k is derived from k, so a torn copy mixes values from two samples
+    PWTD::TelemetrySample makeSample(const int k) {
+        PWTD::TelemetrySample sample;
+
+        sample.timestamp = k;
+        sample.packageTemp = k % 100;
+        sample.packagePower = k * 3;
+        sample.cpuFrequency.resize(NumCpus);
+        sample.c0Residency.resize(NumCpus);
+
+        for (int i=0; i<NumCpus; ++i) {
+            sample.cpuFrequency[i] = k + i;
+            sample.c0Residency[i] = k - i;
+        }
+
+        sample.fanSpeed.insert("cpu", k * 7);
+        return sample;
+    }
+
+    bool isConsistent(const PWTTelemetryShm &snap) {
+        const int k = static_cast<int>(snap.timestamp);
+
+        if (snap.packageTemp != k % 100 || snap.packagePower != k * 3 || snap.numCpus != NumCpus || snap.numFans != 1)
+            return false;
+
+        for (int i=0; i<NumCpus; ++i) {
+            if (snap.cpuFrequency[i] != k + i || snap.c0Residency[i] != k - i)
+                return false;
+        }
+
+        return snap.fans[0].speed == k * 7;
+    }
+}
+
+class TelemetryShmTest final: public QObject {
+    Q_OBJECT
+
+private:
+    // maps the segment the way an external reader does, read only and by name
+    static const PWTTelemetryShm *mapReader() {
+        const int fd = shm_open(PWT_TELEMETRY_SHM_NAME, O_RDONLY | O_CLOEXEC, 0);
+
+        if (fd < 0)
+            return nullptr;
+
+        void *mem = mmap(nullptr, sizeof(PWTTelemetryShm), PROT_READ, MAP_SHARED, fd, 0);
+
+        close(fd);
+        return mem == MAP_FAILED ? nullptr : static_cast<const PWTTelemetryShm *>(mem);
+    }
+
+    static void unmapReader(const PWTTelemetryShm *shm) {
+        munmap(const_cast<PWTTelemetryShm *>(shm), sizeof(PWTTelemetryShm));
+    }
+
+private slots:
+    void layoutHeader() {
+        PWTD::LNX::TelemetryExportLinux exporter;
+
+        if (!exporter.isValid())
+            QSKIP("no shared memory in this environment");
+
+        const PWTTelemetryShm *shm = mapReader();
+        PWTTelemetryShm snap {};
+
+        QVERIFY(shm != nullptr);
+        QCOMPARE(pwtTelemetryShmRead(shm, &snap), 1);
+        QCOMPARE(snap.magic, PWT_TELEMETRY_SHM_MAGIC);
+        QCOMPARE(snap.version, PWT_TELEMETRY_SHM_VERSION);
+        QCOMPARE(snap.size, static_cast<uint32_t>(sizeof(PWTTelemetryShm)));
+        QCOMPARE(snap.sequence, static_cast<uint64_t>(0));
+        QCOMPARE(snap.packageTemp, PWTD::TelemetrySample::Unavailable);
+        QCOMPARE(snap.packagePower, PWTD::TelemetrySample::Unavailable);
+
+        unmapReader(shm);
+    }
+
+    void publishFields() {
+        PWTD::LNX::TelemetryExportLinux exporter;
+
+        if (!exporter.isValid())
+            QSKIP("no shared memory in this environment");
+
+        const PWTTelemetryShm *shm = mapReader();
+        PWTD::TelemetrySample sample = makeSample(42);
+        PWTTelemetryShm snap {};
+
+        QVERIFY(shm != nullptr);
+
+        sample.c0Residency.resize(2); // no aperf/mperf for the rest
+        sample.fanSpeed.insert(QString(40, 'f'), 3000);
+        exporter.publish(sample);
+
+        QCOMPARE(pwtTelemetryShmRead(shm, &snap), 1);
+        QCOMPARE(snap.sequence, static_cast<uint64_t>(2));
+        QCOMPARE(snap.timestamp, static_cast<int64_t>(42));
+        QCOMPARE(snap.numCpus, static_cast<uint32_t>(NumCpus));
+        QCOMPARE(snap.c0Residency[1], 41);
+        QCOMPARE(snap.c0Residency[2], PWTD::TelemetrySample::Unavailable);
+        QCOMPARE(snap.numFans, 2u);
+        QCOMPARE(QByteArray(snap.fans[0].id), QByteArray("cpu"));
+        QCOMPARE(snap.fans[1].id[PWT_TELEMETRY_SHM_FAN_ID_SIZE - 1], '\0'); // long ids are cut and stay terminated
+        QCOMPARE(qstrlen(snap.fans[1].id), static_cast<size_t>(PWT_TELEMETRY_SHM_FAN_ID_SIZE - 1));
+        QCOMPARE(snap.fans[1].speed, 3000);
+
+        unmapReader(shm);
+    }
+
+    void unknownLayout() {
+        PWTTelemetryShm shm {};
+        PWTTelemetryShm snap {};
+
+        QCOMPARE(pwtTelemetryShmRead(&shm, &snap), 0);
+
+        shm.magic = PWT_TELEMETRY_SHM_MAGIC;
+        shm.version = PWT_TELEMETRY_SHM_VERSION + 1;
+        QCOMPARE(pwtTelemetryShmRead(&shm, &snap), 0);
+    }
+
+    // one writer publishing far faster than the daemon does, the reader must never see a mix of two samples
+    // back to back publishes starve a seqlock reader, the writer pauses briefly so reads can complete
+    void seqlockConsistency() {
+        static constexpr int Samples = 20000;
+        PWTD::LNX::TelemetryExportLinux exporter;
+
+        if (!exporter.isValid())
+            QSKIP("no shared memory in this environment");
+
+        const PWTTelemetryShm *shm = mapReader();
+        std::atomic_bool done = false;
+        int reads = 0;
+        int failed = 0; // reader errors, checked after the writer is joined
+        int torn = 0;
+        int distinct = 0;
+        qint64 last = -1;
+
+        QVERIFY(shm != nullptr);
+
+        exporter.publish(makeSample(0));
+
+        QThread *writer = QThread::create([&]() {
+            for (int k=1; k<=Samples; ++k) {
+                exporter.publish(makeSample(k));
+                QThread::usleep(2);
+            }
+
+            done = true;
+        });
+
+        writer->start();
+
+        while (!done) {
+            PWTTelemetryShm snap;
+
+            ++reads;
+
+            if (pwtTelemetryShmRead(shm, &snap) != 1 || (snap.sequence & 1) != 0) {
+                ++failed;
+                continue;
+            }
+
+            if (!isConsistent(snap))
+                ++torn;
+
+            // single writer, samples only move forward
+            if (snap.timestamp < last)
+                ++failed;
+
+            if (snap.timestamp != last) {
+                last = snap.timestamp;
+                ++distinct;
+            }
+        }
+
+        writer->wait();
+        delete writer;
+
+        qInfo("%d reads, %d distinct samples", reads, distinct);
+
+        QCOMPARE(failed, 0);
+        QCOMPARE(torn, 0);
+        QVERIFY(distinct > 1);
+        QCOMPARE(shm->sequence, static_cast<uint64_t>(Samples + 1) * 2);
+
+        unmapReader(shm);
+    }
+};
+
+QTEST_GUILESS_MAIN(TelemetryShmTest)
+#include "TelemetryShmTest.moc"